@@ -0,0 +1,136 @@
+// Copyright 2017 Letícia do Nascimento
+
+#ifndef STRUCTURES_ALLOCATION_COUNTER_H
+#define STRUCTURES_ALLOCATION_COUNTER_H
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+
+#include "./memory_usage.h"
+
+namespace structures {
+
+/**
+ * @brief      Totais de alocação de um rótulo (AllocationCounter).
+ */
+struct SiteAllocations {
+    std::size_t allocations{0u};  // chamadas de new
+    std::size_t releases{0u};  // chamadas de delete
+    std::size_t bytes_allocated{0u};  // bytes pedidos, no total
+    std::size_t bytes_in_use{0u};  // bytes pedidos e ainda não liberados
+};
+
+/**
+ * @brief      AllocationObserver que soma alocações por rótulo, para achar
+ *             quais pontos do programa criam as estruturas que mais crescem
+ *             ou mais pressionam o alocador. Pode ser compartilhado entre
+ *             threads.
+ */
+class AllocationCounter : public AllocationObserver {
+ public:
+    void allocated(const char* site, std::size_t bytes) override;
+    void released(const char* site, std::size_t bytes) override;
+    void attached(const char* site, std::size_t bytes) override;
+    void detached(const char* site, std::size_t bytes) override;
+
+    SiteAllocations site(const std::string& site) const;  // totais de um rótulo
+    SiteAllocations total() const;  // totais de todos os rótulos
+
+    template<typename Function>
+    void for_each(Function function) const;  // function(rótulo, totais)
+
+    void clear();  // esquece todos os rótulos
+
+ private:
+    mutable std::mutex mutex_;
+    std::map<std::string, SiteAllocations> sites_;
+};
+
+/**
+ *   Soma uma alocação de bytes ao rótulo site (AllocationCounter).
+ */
+inline void AllocationCounter::allocated(const char* site, std::size_t bytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    SiteAllocations& totals = sites_[site];
+    totals.allocations++;
+    totals.bytes_allocated += bytes;
+    totals.bytes_in_use += bytes;
+}
+
+/**
+ *   Soma uma liberação de bytes ao rótulo site (AllocationCounter).
+ */
+inline void AllocationCounter::released(const char* site, std::size_t bytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    SiteAllocations& totals = sites_[site];
+    totals.releases++;
+    totals.bytes_in_use -= bytes;
+}
+
+/**
+ *   Passa bytes já alocados a contar como em uso no rótulo site, sem somar
+ * uma alocação (AllocationCounter).
+ */
+inline void AllocationCounter::attached(const char* site, std::size_t bytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    sites_[site].bytes_in_use += bytes;
+}
+
+/**
+ *   Tira bytes do uso do rótulo site, sem somar uma liberação
+ * (AllocationCounter).
+ */
+inline void AllocationCounter::detached(const char* site, std::size_t bytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    sites_[site].bytes_in_use -= bytes;
+}
+
+/**
+ *   Retorna os totais de um rótulo, zerados se ele nunca alocou
+ * (AllocationCounter).
+ */
+inline SiteAllocations AllocationCounter::site(const std::string& site) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = sites_.find(site);
+    return it != sites_.end() ? it->second : SiteAllocations();
+}
+
+/**
+ *   Retorna a soma dos totais de todos os rótulos (AllocationCounter).
+ */
+inline SiteAllocations AllocationCounter::total() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    SiteAllocations sum;
+    for (const auto& entry : sites_) {
+        sum.allocations += entry.second.allocations;
+        sum.releases += entry.second.releases;
+        sum.bytes_allocated += entry.second.bytes_allocated;
+        sum.bytes_in_use += entry.second.bytes_in_use;
+    }
+    return sum;
+}
+
+/**
+ *   Chama function(rótulo, totais) para cada rótulo, em ordem alfabética
+ * (AllocationCounter). A trava fica tomada durante as chamadas.
+ */
+template<typename Function>
+void AllocationCounter::for_each(Function function) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& entry : sites_)
+        function(entry.first, entry.second);
+}
+
+/**
+ *   Esquece todos os rótulos (AllocationCounter).
+ */
+inline void AllocationCounter::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    sites_.clear();
+}
+
+}  // namespace structures
+
+#endif
@@ -5,6 +5,12 @@
      
 #include <cstdint>  // std::size_t
 #include <stdexcept>  // C++ exceptions
+
+#include "./array_sort.h"
+#include "./inline_buffer.h"
+#include "./memory_usage.h"
+#include "./operation_stats.h"
+#include "./parallel.h"
      
 namespace structures {
     
@@ -13,22 +19,33 @@ namespace structures {
      *			   Organização dos elementos onde pode ou não possuir uma
      *			   ordem.
      *
-     * @tparam     T     Parâmetro genérico de Template
+     * @tparam     T       Parâmetro genérico de Template
+     * @tparam     Inline  Quantidade de elementos guardados dentro do objeto;
+     *                     a lista só usa o heap quando cresce além dela
+     * @tparam     Stats   Política de estatísticas (NoStats ou OperationStats)
      */
     
 
-    template<typename T>
-    class ArrayList {
+    template<typename T, std::size_t Inline = 0, typename Stats = NoStats>
+    class ArrayList : private Stats {
     public:
         ArrayList();  // construtor
         explicit ArrayList(std::size_t max_size);  // construtor
+        ArrayList(T* storage, std::size_t size, std::size_t max_size);  // construtor sobre vetor externo
         ~ArrayList();  // destrutor
 
+        // contents pode apontar para small_ ou para um vetor externo: copiar
+        // o ponteiro faria as duas listas dividirem (ou liberarem) o mesmo
+        // vetor
+        ArrayList(const ArrayList&) = delete;
+        ArrayList& operator=(const ArrayList&) = delete;
+
         void clear();  // limpa vetor
         void push_back(const T& data);  // insere um dado por trás
         void push_front(const T& data);  // insere um dado pela frente
         void insert(const T& data, std::size_t index);  // insere elemento
         void insert_sorted(const T& data);  // insere um dado em ordem
+        void sort(const ParallelOptions& options = ParallelOptions());  // ordena a lista
         T pop(std::size_t index);  // retira um elemento em um indice e o retorna
         T pop_back();  // retira o elemento por trás e o retorna
         T pop_front();  // retira elemento pela frente e o retorna 
@@ -43,96 +60,154 @@ namespace structures {
         T& operator[](std::size_t index);  // retorna o dado num determinado endereço - v2
         const T& at(std::size_t index) const;  // retorna o dado num determinado endereço - v3
         const T& operator[](std::size_t index) const;  // retorna o dado num determinado endereço - v4
+        T* data();  // retorna o vetor de dados
+        const T* data() const;  // retorna o vetor de dados - versão const
+        StatsSnapshot stats() const;  // contadores da política de estatísticas
+        void reset_stats();  // zera os contadores
+        std::size_t bytes_allocated() const;  // bytes no heap
+        std::size_t capacity() const;  // dados que cabem sem alocar
+        MemoryUsage memory_usage() const;  // detalhamento da memória
+        // repassa alocações a um observador (só com ObservedStats)
+        void observe(AllocationObserver* observer, const char* site);
 
     private:
+        void reserve(std::size_t size);  // garante espaço para size dados
+
         T* contents;
         std::size_t size_;
         std::size_t max_size_;
+        bool external_{false};  // vetor fornecido pelo usuário
+        InlineBuffer<T, Inline> small_;
 
         static const auto DEFAULT_MAX = 10u;
     };
 
 }  // namespace structures
 
-#endif
 
 //  construtor da classe
 
-template <typename T>
-structures::ArrayList<T>::ArrayList() {
-    max_size_ = DEFAULT_MAX;
-    contents = new T[max_size_];
-    size_ = 0;
-}
+template <typename T, std::size_t Inline, typename Stats>
+structures::ArrayList<T, Inline, Stats>::ArrayList() :
+    ArrayList(DEFAULT_MAX)
+{}
 
 //  construtor da classe com valor passado por parâmetro
 //  param max do tipo size_t - representa o tamanho máximo de elementos do vetor
+//  enquanto a lista cabe no buffer interno nenhuma alocação é feita
 
-template <typename T>
-structures::ArrayList<T>::ArrayList(std::size_t max_size) {
+template <typename T, std::size_t Inline, typename Stats>
+structures::ArrayList<T, Inline, Stats>::ArrayList(std::size_t max_size) {
     max_size_ = max_size;
-    contents = new T[max_size_];
+    if (Inline > 0) {
+        contents = small_.data();
+    } else {
+        contents = new T[max_size_];
+        Stats::allocated(max_size_ * sizeof(T));
+    }
     size_ = 0;
 }
 
+//  construtor da classe sobre um vetor externo, que não é liberado no destrutor
+//  param storage - vetor com espaço para max_size elementos
+//  param size - quantidade de elementos já presentes no início do vetor
+//  param max_size - tamanho máximo de elementos do vetor
+
+template <typename T, std::size_t Inline, typename Stats>
+structures::ArrayList<T, Inline, Stats>::ArrayList(T* storage, std::size_t size,
+                                                   std::size_t max_size) {
+    if (size > max_size)
+        throw std::out_of_range("Erro! Tamanho maior que o máximo.");
+
+    max_size_ = max_size;
+    contents = storage;
+    size_ = size;
+    external_ = true;
+}
+
 //  destrutor da classe
 
-template <typename T>
-structures::ArrayList<T>::~ArrayList() {
-    delete [] contents;
+template <typename T, std::size_t Inline, typename Stats>
+structures::ArrayList<T, Inline, Stats>::~ArrayList() {
+    if (contents != small_.data() && !external_) {
+        Stats::released(max_size_ * sizeof(T));
+        delete [] contents;
+    }
+}
+
+//  passa os dados do buffer interno para o heap quando eles não cabem mais
+//  param size - quantidade de dados que a lista precisa comportar
+
+template <typename T, std::size_t Inline, typename Stats>
+void structures::ArrayList<T, Inline, Stats>::reserve(std::size_t size) {
+    if (contents != small_.data() || size <= Inline)
+        return;
+
+    T* heap = new T[max_size_];
+    Stats::allocated(max_size_ * sizeof(T));
+    for (std::size_t i = 0; i < size_; i++) {
+        heap[i] = contents[i];
+    }
+    contents = heap;
 }
 
 //  adiciona dados ao vetor
 //  param data - um generico que representa o dado a ser armazenado
 //  param index - um indice para ser inserido o dado
 
-template <typename T>
-void structures::ArrayList<T>::insert(const T& data, std::size_t index) {
+template <typename T, std::size_t Inline, typename Stats>
+void structures::ArrayList<T, Inline, Stats>::insert(const T& data, std::size_t index) {
     if (full()) {
         throw std::out_of_range("Lista atualmente cheia."); 
-    } else if (index > size_ || index < 0) {
+    } else if (index > size_) {
             throw std::out_of_range("Erro! Posição inexistente.");
       }
     
-    int i = size_;
+    Stats::operation();
+    Stats::shifted(size_ - index);
+    reserve(size_ + 1);
+    std::size_t i = size_;
     while (i > index) {
         contents[i] = contents[i - 1];
         i--;
     }    
     contents[index] = data;
     size_++;
+    Stats::resized(size_);
 }
 
 //  retira dados do vetor por trás
 
-template <typename T> 
-T structures::ArrayList<T>::pop_back() {
+template <typename T, std::size_t Inline, typename Stats> 
+T structures::ArrayList<T, Inline, Stats>::pop_back() {
    return pop(size_-1);
 }
 
 //  retira dados do vetor pela frente
 
-template <typename T> 
-T structures::ArrayList<T>::pop_front() {
+template <typename T, std::size_t Inline, typename Stats> 
+T structures::ArrayList<T, Inline, Stats>::pop_front() {
     return pop(0); 
 }
 
 //  retira dados do vetor com parametro
 //  param index - representa o endereço onde o dado será retirado
 
-template <typename T> 
-T structures::ArrayList<T>::pop(std::size_t index) {
+template <typename T, std::size_t Inline, typename Stats> 
+T structures::ArrayList<T, Inline, Stats>::pop(std::size_t index) {
     if (empty()) {
         throw std::out_of_range("Lista atualmente vazia.");
-    } else if (index > size_ || index < 0) {
+    } else if (index >= size_) {
             throw std::out_of_range("Erro! Posição inexistente.");
       }
     
+    Stats::operation();
+    Stats::shifted(size_ - 1 - index);
     T retorno = contents[index];
-    int i = size_ -1;
-    while (i > index) {
+    std::size_t i = index;
+    while (i < size_ - 1) {
         contents[i] = contents[i+1];
-        i--;
+        i++;
     }    
     size_--;
     return retorno; 
@@ -141,8 +216,8 @@ T structures::ArrayList<T>::pop(std::size_t index) {
 //  remove um elemento da lista
 //  param data - representa o elemento a ser removido
 
-template <typename T>
-void structures::ArrayList<T>::remove(const T& data) {
+template <typename T, std::size_t Inline, typename Stats>
+void structures::ArrayList<T, Inline, Stats>::remove(const T& data) {
     if (!contains(data))
         throw std::out_of_range("Elemento inexistente");
    pop(find(data));
@@ -151,78 +226,80 @@ void structures::ArrayList<T>::remove(const T& data) {
 //  encontra um elemento na lista
 //  param data - representa o elemento a ser encontrado
 
-template <typename T>
-std::size_t structures::ArrayList<T>::find(const T& data) const {
+template <typename T, std::size_t Inline, typename Stats>
+std::size_t structures::ArrayList<T, Inline, Stats>::find(const T& data) const {
     std:: size_t i;
     for (i = 0; i < size_; i++) {
         if (contents[i] == data) {
             break;
         }
     }
+    Stats::operation();
+    Stats::traversed(i < size_ ? i + 1 : size_);
     return i;
 }
 
 //  verifica se um elemento está na lista
 //  param data - representa o elemento a ser verificado
 
-template <typename T>
-bool structures::ArrayList<T>::contains(const T& data) const {
+template <typename T, std::size_t Inline, typename Stats>
+bool structures::ArrayList<T, Inline, Stats>::contains(const T& data) const {
     return (find(data) != size_);
 }
 
 //  limpa a lista
 
-template <typename T>
-void structures::ArrayList<T>::clear() {
+template <typename T, std::size_t Inline, typename Stats>
+void structures::ArrayList<T, Inline, Stats>::clear() {
     size_ = 0;
 }
 
 //  retorna o tamanho da lista
 
-template <typename T>
-std::size_t structures::ArrayList<T>::size() const {
+template <typename T, std::size_t Inline, typename Stats>
+std::size_t structures::ArrayList<T, Inline, Stats>::size() const {
     return (size_);
 }
 
 //  retorna o tamanho máximo da lista
 
-template <typename T>
-std::size_t structures::ArrayList<T>::max_size() const {
+template <typename T, std::size_t Inline, typename Stats>
+std::size_t structures::ArrayList<T, Inline, Stats>::max_size() const {
     return (max_size_);
 }
 
 //  verifica se a lista está cheia
 
-template <typename T>
-bool structures::ArrayList<T>::full() const {
+template <typename T, std::size_t Inline, typename Stats>
+bool structures::ArrayList<T, Inline, Stats>::full() const {
     return size_ == max_size_;
 }
 
 //  verifica se a lista está vazia
 
-template <typename T>
-bool structures::ArrayList<T>::empty() const {
+template <typename T, std::size_t Inline, typename Stats>
+bool structures::ArrayList<T, Inline, Stats>::empty() const {
     return size_ == 0;
 }
 
 //  insere um elemento por trás
 
-template <typename T> 
-void structures::ArrayList<T>::push_back(const T& data) {
-   insert(data, 0);
+template <typename T, std::size_t Inline, typename Stats> 
+void structures::ArrayList<T, Inline, Stats>::push_back(const T& data) {
+   insert(data, size_);
 }
 
 //  insere um elemento pela frente
 
-template <typename T> 
-void structures::ArrayList<T>::push_front(const T& data) {
-    insert(data, size_); 
+template <typename T, std::size_t Inline, typename Stats> 
+void structures::ArrayList<T, Inline, Stats>::push_front(const T& data) {
+    insert(data, 0);
 }
 
 //  insere um elemento em ordem
 
-template <typename T>
-void structures::ArrayList<T>::insert_sorted(const T& data) {
+template <typename T, std::size_t Inline, typename Stats>
+void structures::ArrayList<T, Inline, Stats>::insert_sorted(const T& data) {
     if (full())
         throw std::out_of_range("Lista atualmente cheia."); 
     
@@ -230,13 +307,24 @@ void structures::ArrayList<T>::insert_sorted(const T& data) {
     while (i < size_ && data > contents[i]) {
         i++;
     }
+    Stats::traversed(i);
     insert(data, i);    
 }
 
+//  ordena a lista em ordem crescente
+//  param options - threads e tamanho mínimo para a ordenação paralela
+//  inteiros e reais usam radix sort; os demais tipos, intercalação paralela
+
+template <typename T, std::size_t Inline, typename Stats>
+void structures::ArrayList<T, Inline, Stats>::sort(const ParallelOptions& options) {
+    Stats::operation();
+    detail::sort_contents(contents, size_, options);
+}
+
 //  retorna o dado num determinado endereço - v1
 
-template <typename T>
-T& structures::ArrayList<T>::at(std::size_t index) {
+template <typename T, std::size_t Inline, typename Stats>
+T& structures::ArrayList<T, Inline, Stats>::at(std::size_t index) {
     if (index > size_ || index < 0) 
         throw std::out_of_range("Erro! Posição inexistente."); 
         
@@ -245,8 +333,8 @@ T& structures::ArrayList<T>::at(std::size_t index) {
 
 //  retorna o dado num determinado endereço - v2
 
-template <typename T>
-T& structures::ArrayList<T>::operator[](std::size_t index) {
+template <typename T, std::size_t Inline, typename Stats>
+T& structures::ArrayList<T, Inline, Stats>::operator[](std::size_t index) {
     if (index > size_ || index < 0) 
         throw std::out_of_range("Erro! Posição inexistente."); 
         
@@ -255,8 +343,8 @@ T& structures::ArrayList<T>::operator[](std::size_t index) {
    
 //  retorna o dado num determinado endereço - v3 
     
-template <typename T>
-const T& structures::ArrayList<T>::at(std::size_t index) const {
+template <typename T, std::size_t Inline, typename Stats>
+const T& structures::ArrayList<T, Inline, Stats>::at(std::size_t index) const {
     if (index > size_ || index < 0) 
         throw std::out_of_range("Erro! Posição inexistente."); 
         
@@ -265,10 +353,73 @@ const T& structures::ArrayList<T>::at(std::size_t index) const {
 
 //  retorna o dado num determinado endereço - v4
 
-template <typename T>
-const T& structures::ArrayList<T>::operator[](std::size_t index) const {
+template <typename T, std::size_t Inline, typename Stats>
+const T& structures::ArrayList<T, Inline, Stats>::operator[](std::size_t index) const {
     if (index > size_ || index < 0) 
         throw std::out_of_range("Erro! Posição inexistente."); 
         
     return contents[index];
 }
+
+//  retorna o vetor de dados
+
+template <typename T, std::size_t Inline, typename Stats>
+T* structures::ArrayList<T, Inline, Stats>::data() {
+    return contents;
+}
+
+//  retorna o vetor de dados - versão const
+
+template <typename T, std::size_t Inline, typename Stats>
+const T* structures::ArrayList<T, Inline, Stats>::data() const {
+    return contents;
+}
+
+//  retorna os contadores da política de estatísticas
+
+template <typename T, std::size_t Inline, typename Stats>
+structures::StatsSnapshot structures::ArrayList<T, Inline, Stats>::stats() const {
+    return Stats::snapshot();
+}
+
+//  zera os contadores da política de estatísticas
+
+template <typename T, std::size_t Inline, typename Stats>
+void structures::ArrayList<T, Inline, Stats>::reset_stats() {
+    Stats::reset();
+}
+
+//  retorna os bytes que a lista ocupa no heap
+
+template <typename T, std::size_t Inline, typename Stats>
+std::size_t structures::ArrayList<T, Inline, Stats>::bytes_allocated() const {
+    if (contents == small_.data() || external_)
+        return 0;
+    return max_size_ * sizeof(T);
+}
+
+//  retorna quantos dados cabem sem nova alocação
+
+template <typename T, std::size_t Inline, typename Stats>
+std::size_t structures::ArrayList<T, Inline, Stats>::capacity() const {
+    return contents == small_.data() && Inline < max_size_ ? Inline : max_size_;
+}
+
+//  retorna o detalhamento da memória ocupada
+
+template <typename T, std::size_t Inline, typename Stats>
+structures::MemoryUsage
+structures::ArrayList<T, Inline, Stats>::memory_usage() const {
+    return detail::array_usage<T>(size_, capacity(), bytes_allocated());
+}
+
+//  repassa as alocações ao observador com o rótulo site
+//  exige a política ObservedStats
+
+template <typename T, std::size_t Inline, typename Stats>
+void structures::ArrayList<T, Inline, Stats>::observe(
+        AllocationObserver* observer, const char* site) {
+    Stats::observe(observer, site);
+}
+
+#endif
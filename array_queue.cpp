@@ -4,7 +4,11 @@
 #define STRUCTURES_ARRAY_QUEUE_H
      
 #include <cstdint>  // std::size_t
+#include <iterator>  // std::distance
 #include <stdexcept>  // C++ exceptions
+
+#include "./memory_usage.h"
+#include "./operation_stats.h"
      
 namespace structures {
     
@@ -13,112 +17,203 @@ namespace structures {
      *			   (First In First Out ou FIFO) - Organização dos elementos onde
      *			   o primeiro a ser inserido é o primeiro a ser retirado.
      *
-     * @tparam     T     Parâmetro genérico de Template
+     * @tparam     T      Parâmetro genérico de Template
+     * @tparam     Stats  Política de estatísticas (NoStats ou OperationStats)
      */
     
 
-    template<typename T>
-    class ArrayQueue {
+    template<typename T, typename Stats = NoStats>
+    class ArrayQueue : private Stats {
         public:
             ArrayQueue();
 
             explicit ArrayQueue(std::size_t max);
 
+            ArrayQueue(T* storage, std::size_t size, std::size_t max);
+
             ~ArrayQueue();
     
             void enqueue(const T& data);  // enfila
+
+            template<typename ForwardIt>
+            void enqueue_bulk(ForwardIt first, ForwardIt last);  // em lote
   
             T dequeue();  // desenfila
+
+            template<typename OutputIt>
+            std::size_t dequeue_bulk(OutputIt out, std::size_t max);  // em lote
     
             T& back();
     
             void clear();  // limpa
     
-            std::size_t size();  // tamanho
+            std::size_t size() const;  // tamanho
     
-            std::size_t max_size();
+            std::size_t max_size() const;
     
-            bool empty();  // vazia
+            bool empty() const;  // vazia
    
-            bool full();  // cheia
+            bool full() const;  // cheia
+
+            T* data();  // vetor de dados, do primeiro ao último
+
+            const T* data() const;
+
+            StatsSnapshot stats() const;  // contadores de estatísticas
+
+            void reset_stats();  // zera os contadores
+
+            std::size_t bytes_allocated() const;  // bytes no heap
+
+            std::size_t capacity() const;  // dados que cabem sem alocar
+
+            MemoryUsage memory_usage() const;  // detalhamento da memória
+
+            // repassa alocações a um observador (só com ObservedStats)
+            void observe(AllocationObserver* observer, const char* site);
     
         private:
             T* contents;
-            int size_;
+            std::size_t size_;
             std::size_t max_size_;
+            bool external_{false};  // vetor fornecido pelo usuário
             
             static const auto DEFAULT_SIZE = 10u;
     };
    
 }   
 
-#endif // namespace structures
-
 
 //  construtor da classe
 
-template <typename T>
-structures::ArrayQueue<T>::ArrayQueue() {
+template <typename T, typename Stats>
+structures::ArrayQueue<T, Stats>::ArrayQueue() {
     max_size_ = DEFAULT_SIZE;
     contents = new T[max_size_];
+    Stats::allocated(max_size_ * sizeof(T));
     size_ = 0;
 }
 
 //  construtor da classe com valor passado por parâmetro
 //  param max do tipo size_t - representa o tamanho máximo de elementos do vetor
 
-template <typename T>
-structures::ArrayQueue<T>::ArrayQueue(std::size_t max) {
+template <typename T, typename Stats>
+structures::ArrayQueue<T, Stats>::ArrayQueue(std::size_t max) {
     max_size_ = max;
     contents = new T[max_size_];
+    Stats::allocated(max_size_ * sizeof(T));
     size_ = 0;
 }
 
+//  construtor da classe sobre um vetor externo, que não é liberado no destrutor
+//  param storage - vetor com espaço para max elementos
+//  param size - quantidade de elementos já presentes no início do vetor
+//  param max - tamanho máximo de elementos do vetor
+
+template <typename T, typename Stats>
+structures::ArrayQueue<T, Stats>::ArrayQueue(T* storage, std::size_t size,
+                                             std::size_t max) {
+    if (size > max)
+        throw std::out_of_range("Erro! Tamanho maior que o máximo.");
+
+    max_size_ = max;
+    contents = storage;
+    size_ = size;
+    external_ = true;
+}
+
 //  destrutor da classe
 
-template <typename T>
-structures::ArrayQueue<T>::~ArrayQueue() {
-    delete [] contents;
+template <typename T, typename Stats>
+structures::ArrayQueue<T, Stats>::~ArrayQueue() {
+    if (!external_) {
+        Stats::released(max_size_ * sizeof(T));
+        delete [] contents;
+    }
 }
 
 //  adiciona dados ao vetor
 //  param data - um generico que representa o dado a ser armazenado
 
-template <typename T>
-void structures::ArrayQueue<T>::enqueue(const T& data) {
+template <typename T, typename Stats>
+void structures::ArrayQueue<T, Stats>::enqueue(const T& data) {
     if (full())
         throw std::out_of_range("Fila atualmente cheia.");
         
+    Stats::operation();
     contents[size_] = data;
     size_++;
+    Stats::resized(size_);
 }
 
 //  retira dados do vetor
 
-template <typename T> 
-T structures::ArrayQueue<T>::dequeue() {
+template <typename T, typename Stats> 
+T structures::ArrayQueue<T, Stats>::dequeue() {
     if (empty())
         throw std::out_of_range("Fila atualmente vazia.");
         
-    int first = contents [0];
+    Stats::operation();
+    Stats::shifted(size_ - 1);
+    T first = contents [0];
     size_ --;
-    for (int i = 0; i < size_; i++) {
+    for (std::size_t i = 0; i < size_; i++) {
         contents[i] = contents[i+1];
     }
     return first;
 }
 
+//  adiciona um intervalo de dados ao vetor, verificando o espaço uma só vez
+//  param first, last - intervalo [first, last) com os dados a serem armazenados
+
+template <typename T, typename Stats>
+template <typename ForwardIt>
+void structures::ArrayQueue<T, Stats>::enqueue_bulk(ForwardIt first, ForwardIt last) {
+    std::size_t count = std::distance(first, last);
+    if (size_ + count > max_size_)
+        throw std::out_of_range("Fila atualmente cheia.");
+
+    Stats::operation();
+    for (; first != last; ++first) {
+        contents[size_] = *first;
+        size_++;
+    }
+    Stats::resized(size_);
+}
+
+//  retira até max dados do vetor, deslocando os restantes uma só vez
+//  param out - destino dos dados retirados, na ordem da fila
+//  param max - quantidade máxima de dados a retirar
+
+template <typename T, typename Stats>
+template <typename OutputIt>
+std::size_t structures::ArrayQueue<T, Stats>::dequeue_bulk(OutputIt out,
+                                                           std::size_t max) {
+    std::size_t count = max < size() ? max : size();
+    Stats::operation();
+    Stats::shifted(size() - count);
+    for (std::size_t i = 0; i < count; i++) {
+        *out = contents[i];
+        ++out;
+    }
+    for (std::size_t i = count; i < size(); i++) {
+        contents[i - count] = contents[i];
+    }
+    size_ -= count;
+    return count;
+}
+
 //  limpa a fila
 
-template <typename T>
-void structures::ArrayQueue<T>::clear() {
+template <typename T, typename Stats>
+void structures::ArrayQueue<T, Stats>::clear() {
     size_ = 0;
 }
 
 //  retorna o último elemento da fila
 
-template <typename T>
-T& structures::ArrayQueue<T>::back() {
+template <typename T, typename Stats>
+T& structures::ArrayQueue<T, Stats>::back() {
     if(empty()) 
         throw std::out_of_range("Fila vazia.");
         
@@ -127,29 +222,91 @@ T& structures::ArrayQueue<T>::back() {
 
 //  retorna o tamanho da fila
 
-template <typename T>
-std::size_t structures::ArrayQueue<T>::size() {
+template <typename T, typename Stats>
+std::size_t structures::ArrayQueue<T, Stats>::size() const {
     return (size_);
 }
 
 //  retorna o tamanho máximo da fila
 
-template <typename T>
-std::size_t structures::ArrayQueue<T>::max_size() {
+template <typename T, typename Stats>
+std::size_t structures::ArrayQueue<T, Stats>::max_size() const {
     return (max_size_);
 }
 
 //  verifica se a fila está cheia
 
-template <typename T>
-bool structures::ArrayQueue<T>::full() {
+template <typename T, typename Stats>
+bool structures::ArrayQueue<T, Stats>::full() const {
     return size_ == max_size_;
 }
 
 //  verifica se a fila está vazia
 
-template <typename T>
-bool structures::ArrayQueue<T>::empty() {
+template <typename T, typename Stats>
+bool structures::ArrayQueue<T, Stats>::empty() const {
     return size_ == 0;
 }
 
+//  retorna o vetor de dados, do primeiro ao último da fila
+
+template <typename T, typename Stats>
+T* structures::ArrayQueue<T, Stats>::data() {
+    return contents;
+}
+
+//  retorna o vetor de dados, do primeiro ao último da fila - versão const
+
+template <typename T, typename Stats>
+const T* structures::ArrayQueue<T, Stats>::data() const {
+    return contents;
+}
+
+//  retorna os contadores da política de estatísticas
+
+template <typename T, typename Stats>
+structures::StatsSnapshot structures::ArrayQueue<T, Stats>::stats() const {
+    return Stats::snapshot();
+}
+
+//  zera os contadores da política de estatísticas
+
+template <typename T, typename Stats>
+void structures::ArrayQueue<T, Stats>::reset_stats() {
+    Stats::reset();
+}
+
+//  retorna os bytes que a fila ocupa no heap
+
+template <typename T, typename Stats>
+std::size_t structures::ArrayQueue<T, Stats>::bytes_allocated() const {
+    if (external_)
+        return 0;
+    return max_size_ * sizeof(T);
+}
+
+//  retorna quantos dados cabem sem nova alocação
+
+template <typename T, typename Stats>
+std::size_t structures::ArrayQueue<T, Stats>::capacity() const {
+    return max_size_;
+}
+
+//  retorna o detalhamento da memória ocupada
+
+template <typename T, typename Stats>
+structures::MemoryUsage
+structures::ArrayQueue<T, Stats>::memory_usage() const {
+    return detail::array_usage<T>(size_, capacity(), bytes_allocated());
+}
+
+//  repassa as alocações ao observador com o rótulo site
+//  exige a política ObservedStats
+
+template <typename T, typename Stats>
+void structures::ArrayQueue<T, Stats>::observe(
+        AllocationObserver* observer, const char* site) {
+    Stats::observe(observer, site);
+}
+
+#endif
@@ -0,0 +1,284 @@
+// Copyright 2017 Letícia do Nascimento
+
+#ifndef STRUCTURES_ARRAY_SNAPSHOT_H
+#define STRUCTURES_ARRAY_SNAPSHOT_H
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>  // C++ exceptions
+#include <system_error>
+#include <type_traits>
+
+#include "./array_list.cpp"
+#include "./array_queue.cpp"
+
+namespace structures {
+
+/**
+ * @brief      Cabeçalho do snapshot binário. Ocupa 64 bytes, de modo que o
+ *             vetor de dados que vem logo depois fica alinhado para qualquer
+ *             tipo comum.
+ */
+struct SnapshotHeader {
+    char magic[8];  // "INE5408"
+    std::uint32_t version;  // versão do formato
+    std::uint32_t element_size;  // sizeof(T) de quem gravou
+    std::uint64_t size;  // quantidade de elementos gravados
+    std::uint64_t max_size;  // tamanho máximo da estrutura gravada
+    std::uint8_t reserved[32];
+};
+
+static_assert(sizeof(SnapshotHeader) == 64, "Cabeçalho deve ter 64 bytes.");
+
+/**
+ * @brief      Modo de abertura de um snapshot: somente leitura (páginas
+ *             compartilhadas com o arquivo) ou cópia-na-escrita (alterações
+ *             ficam na memória do processo e não vão para o arquivo).
+ */
+enum class SnapshotMode {
+    read_only,
+    copy_on_write
+};
+
+namespace detail {
+
+const char SNAPSHOT_MAGIC[8] = "INE5408";
+const std::uint32_t SNAPSHOT_VERSION = 1u;
+
+//  escreve length bytes, repetindo enquanto a escrita for parcial
+inline void write_all(int fd, const void* buffer, std::size_t length) {
+    const char* bytes = static_cast<const char*>(buffer);
+    while (length > 0) {
+        ssize_t written = ::write(fd, bytes, length);
+        if (written < 0) {
+            if (errno == EINTR)
+                continue;
+            throw std::system_error(errno, std::generic_category(),
+                                    "Erro ao gravar snapshot");
+        }
+        bytes += written;
+        length -= written;
+    }
+}
+
+//  grava cabeçalho e dados; os dados vão numa única escrita contígua
+template<typename T>
+void write_snapshot(const T* data, std::size_t size, std::size_t max_size,
+                    const char* path) {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "Snapshot exige T trivialmente copiável.");
+
+    SnapshotHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+    header.version = SNAPSHOT_VERSION;
+    header.element_size = sizeof(T);
+    header.size = size;
+    header.max_size = max_size;
+
+    int fd = ::open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+        throw std::system_error(errno, std::generic_category(),
+                                "Erro ao criar snapshot");
+    try {
+        write_all(fd, &header, sizeof(header));
+        write_all(fd, data, size * sizeof(T));
+    } catch (...) {
+        ::close(fd);
+        throw;
+    }
+    ::close(fd);
+}
+
+}  // namespace detail
+
+/**
+ *   Grava um snapshot binário da lista (ArrayList).
+ */
+template<typename T, std::size_t Inline, typename Stats>
+void save_snapshot(const ArrayList<T, Inline, Stats>& list, const char* path) {
+    detail::write_snapshot(list.data(), list.size(), list.max_size(), path);
+}
+
+/**
+ *   Grava um snapshot binário da fila (ArrayQueue).
+ */
+template<typename T, typename Stats>
+void save_snapshot(const ArrayQueue<T, Stats>& queue, const char* path) {
+    detail::write_snapshot(queue.data(), queue.size(), queue.max_size(), path);
+}
+
+/**
+ * @brief      Estrutura de vetor (ArrayList ou ArrayQueue) aberta a partir de
+ *             um snapshot via mmap, sem desserialização: os elementos são
+ *             usados diretamente nas páginas do arquivo.
+ *
+ * @tparam     T          Tipo dos elementos (trivialmente copiável)
+ * @tparam     Container  ArrayList<T> ou ArrayQueue<T>
+ */
+template<typename T, typename Container = ArrayList<T>>
+class MappedSnapshot {
+ public:
+    MappedSnapshot(const char* path, SnapshotMode mode,
+                   std::size_t max_size = 0);
+    ~MappedSnapshot();
+
+    MappedSnapshot(const MappedSnapshot&) = delete;
+    MappedSnapshot& operator=(const MappedSnapshot&) = delete;
+
+    const Container& get() const;  // estrutura somente para leitura
+    Container& get_mutable();  // estrutura alterável (cópia-na-escrita)
+
+    SnapshotMode mode() const;
+
+ private:
+    struct Mapping {
+        void* base;
+        std::size_t length;
+        std::size_t size;
+        std::size_t max_size;
+    };
+
+    static Mapping map_file(const char* path, SnapshotMode mode,
+                            std::size_t max_size);
+
+    T* contents() {
+        return reinterpret_cast<T*>(static_cast<char*>(mapping_.base) +
+                                    sizeof(SnapshotHeader));
+    }
+
+    SnapshotMode mode_;
+    Mapping mapping_;
+    Container container_;
+};
+
+/**
+ *   Abre o snapshot do arquivo (MappedSnapshot). Em cópia-na-escrita,
+ * max_size permite reservar espaço maior que o gravado para novas inserções.
+ */
+template<typename T, typename Container>
+MappedSnapshot<T, Container>::MappedSnapshot(const char* path,
+                                             SnapshotMode mode,
+                                             std::size_t max_size) :
+    mode_{mode},
+    mapping_(map_file(path, mode, max_size)),
+    container_{contents(), mapping_.size, mapping_.max_size}
+{}
+
+/**
+ *   Destrutor da classe MappedSnapshot: desfaz o mapeamento.
+ */
+template<typename T, typename Container>
+MappedSnapshot<T, Container>::~MappedSnapshot() {
+    ::munmap(mapping_.base, mapping_.length);
+}
+
+/**
+ *   Valida o cabeçalho e mapeia o arquivo (MappedSnapshot).
+ */
+template<typename T, typename Container>
+typename MappedSnapshot<T, Container>::Mapping
+MappedSnapshot<T, Container>::map_file(const char* path, SnapshotMode mode,
+                                       std::size_t max_size) {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "Snapshot exige T trivialmente copiável.");
+
+    int fd = ::open(path, O_RDONLY);
+    if (fd < 0)
+        throw std::system_error(errno, std::generic_category(),
+                                "Erro ao abrir snapshot");
+
+    struct stat info;
+    SnapshotHeader header;
+    if (::fstat(fd, &info) < 0 ||
+        ::pread(fd, &header, sizeof(header), 0) != sizeof(header)) {
+        ::close(fd);
+        throw std::runtime_error("Snapshot ilegível.");
+    }
+
+    std::size_t file_length = info.st_size;
+    if (std::memcmp(header.magic, detail::SNAPSHOT_MAGIC,
+                    sizeof(header.magic)) != 0 ||
+        header.version != detail::SNAPSHOT_VERSION ||
+        header.element_size != sizeof(T) ||
+        header.size > header.max_size ||
+        // divisões em vez de produtos: um cabeçalho corrompido não pode
+        // estourar a conta e passar na checagem
+        file_length < sizeof(header) ||
+        header.size != (file_length - sizeof(header)) / sizeof(T) ||
+        (file_length - sizeof(header)) % sizeof(T) != 0 ||
+        header.max_size > (SIZE_MAX - sizeof(header)) / sizeof(T) ||
+        max_size > (SIZE_MAX - sizeof(header)) / sizeof(T)) {
+        ::close(fd);
+        throw std::runtime_error("Snapshot inválido ou incompatível.");
+    }
+
+    Mapping mapping;
+    mapping.size = header.size;
+    mapping.max_size = header.max_size;
+
+    void* base;
+    if (mode == SnapshotMode::read_only) {
+        mapping.length = file_length;
+        base = ::mmap(nullptr, file_length, PROT_READ, MAP_SHARED, fd, 0);
+    } else {
+        // reserva memória anônima para max_size elementos e sobrepõe o
+        // arquivo no início, em cópia-na-escrita
+        if (max_size > mapping.max_size)
+            mapping.max_size = max_size;
+        mapping.length = sizeof(header) + mapping.max_size * sizeof(T);
+        base = ::mmap(nullptr, mapping.length, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (base != MAP_FAILED &&
+            ::mmap(base, file_length, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_FIXED, fd, 0) == MAP_FAILED) {
+            ::munmap(base, mapping.length);
+            base = MAP_FAILED;
+        }
+    }
+    int error = errno;
+    ::close(fd);
+
+    if (base == MAP_FAILED)
+        throw std::system_error(error, std::generic_category(),
+                                "Erro ao mapear snapshot");
+    mapping.base = base;
+    return mapping;
+}
+
+/**
+ *   Retorna a estrutura mapeada, somente para leitura (MappedSnapshot).
+ */
+template<typename T, typename Container>
+const Container& MappedSnapshot<T, Container>::get() const {
+    return container_;
+}
+
+/**
+ *   Retorna a estrutura mapeada para alteração (MappedSnapshot). Só é
+ * permitido em cópia-na-escrita; o arquivo nunca é modificado.
+ */
+template<typename T, typename Container>
+Container& MappedSnapshot<T, Container>::get_mutable() {
+    if (mode_ != SnapshotMode::copy_on_write)
+        throw std::logic_error("Snapshot aberto somente para leitura.");
+    return container_;
+}
+
+/**
+ *   Retorna o modo de abertura do snapshot (MappedSnapshot).
+ */
+template<typename T, typename Container>
+SnapshotMode MappedSnapshot<T, Container>::mode() const {
+    return mode_;
+}
+
+}  // namespace structures
+
+#endif
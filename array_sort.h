@@ -0,0 +1,161 @@
+// Copyright 2017 Letícia do Nascimento
+
+#ifndef STRUCTURES_ARRAY_SORT_H
+#define STRUCTURES_ARRAY_SORT_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+#include "./parallel.h"
+
+namespace structures {
+
+namespace detail {
+
+//  chave sem sinal cuja ordem natural é a ordem de T (inteiros e reais)
+template<typename T>
+struct RadixKey {
+    using type = typename std::conditional<sizeof(T) == 1, std::uint8_t,
+                 typename std::conditional<sizeof(T) == 2, std::uint16_t,
+                 typename std::conditional<sizeof(T) == 4, std::uint32_t,
+                 std::uint64_t>::type>::type>::type;
+
+    static const type SIGN_BIT = type(1) << (8 * sizeof(T) - 1);
+
+    static type get(const T& data) {
+        type key;
+        std::memcpy(&key, &data, sizeof(T));
+        if (std::is_floating_point<T>::value)
+            return (key & SIGN_BIT) ? type(~key) : type(key ^ SIGN_BIT);
+        if (std::is_signed<T>::value)
+            return key ^ SIGN_BIT;
+        return key;
+    }
+};
+
+//  tipos que usam o radix sort: inteiros (exceto bool) e reais de até 64 bits
+template<typename T>
+struct use_radix : std::integral_constant<bool,
+    ((std::is_integral<T>::value && !std::is_same<T, bool>::value) ||
+     std::is_floating_point<T>::value) && sizeof(T) <= 8> { };
+
+//  radix sort LSD com dígitos de 8 bits; passadas com um só balde são puladas
+template<typename T>
+void radix_sort(T* contents, std::size_t size) {
+    using Key = RadixKey<T>;
+    const std::size_t digits = sizeof(T);
+
+    std::vector<std::size_t> counts(digits * 256, 0);
+    for (std::size_t i = 0; i < size; i++) {
+        typename Key::type key = Key::get(contents[i]);
+        for (std::size_t d = 0; d < digits; d++)
+            counts[d * 256 + ((key >> (8 * d)) & 0xFF)]++;
+    }
+
+    T* buffer = new T[size];
+    T* from = contents;
+    T* to = buffer;
+    for (std::size_t d = 0; d < digits; d++) {
+        std::size_t* count = &counts[d * 256];
+        bool trivial = false;
+        for (std::size_t b = 0; b < 256; b++) {
+            if (count[b] == size)
+                trivial = true;
+        }
+        if (trivial)
+            continue;
+
+        std::size_t offset = 0;
+        for (std::size_t b = 0; b < 256; b++) {
+            std::size_t bucket = count[b];
+            count[b] = offset;
+            offset += bucket;
+        }
+        for (std::size_t i = 0; i < size; i++) {
+            std::size_t b = (Key::get(from[i]) >> (8 * d)) & 0xFF;
+            to[count[b]++] = from[i];
+        }
+        std::swap(from, to);
+    }
+
+    if (from != contents)
+        std::copy(from, from + size, contents);
+    delete [] buffer;
+}
+
+//  ordena partes contíguas em paralelo e as intercala duas a duas
+template<typename T>
+void parallel_merge_sort(T* contents, std::size_t size,
+                         const ParallelOptions& options) {
+    parallel_ranges(size, options, [&](std::size_t begin, std::size_t end) {
+        std::sort(contents + begin, contents + end);
+    });
+
+    std::size_t parts = parallel_parts(size, options);
+    std::vector<std::size_t> bounds;
+    for (std::size_t i = 0; i <= parts; i++)
+        bounds.push_back(parallel_bound(size, parts, i));
+
+    while (bounds.size() > 2) {
+        // cada par de partes vizinhas é uma parte da rodada, no ThreadPool
+        std::size_t pairs = (bounds.size() - 1) / 2;
+        ParallelOptions round;
+        round.threads = pairs;
+        round.threshold = 0;
+        parallel_ranges(pairs, round, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t pair = begin; pair < end; pair++) {
+                std::size_t i = 2 * pair;
+                std::inplace_merge(contents + bounds[i],
+                                   contents + bounds[i + 1],
+                                   contents + bounds[i + 2]);
+            }
+        });
+
+        std::vector<std::size_t> merged;
+        for (std::size_t i = 0; i + 2 < bounds.size(); i += 2)
+            merged.push_back(bounds[i]);
+        if (bounds.size() % 2 == 0)  // parte ímpar sobra para a próxima rodada
+            merged.push_back(bounds[bounds.size() - 2]);
+        merged.push_back(bounds.back());
+        bounds.swap(merged);
+    }
+}
+
+template<typename T>
+void sort_contents(T* contents, std::size_t size,
+                   const ParallelOptions& options, std::true_type) {
+    if (size < 256)
+        std::sort(contents, contents + size);
+    else
+        radix_sort(contents, size);
+    (void) options;
+}
+
+template<typename T>
+void sort_contents(T* contents, std::size_t size,
+                   const ParallelOptions& options, std::false_type) {
+    if (parallel_parts(size, options) == 1)
+        std::sort(contents, contents + size);
+    else
+        parallel_merge_sort(contents, size, options);
+}
+
+/**
+ *   Ordena o vetor em ordem crescente (operator<): radix sort LSD para
+ * inteiros e reais, intercalação paralela de partes ordenadas com
+ * std::sort (introsort) para os demais tipos.
+ */
+template<typename T>
+void sort_contents(T* contents, std::size_t size,
+                   const ParallelOptions& options) {
+    sort_contents(contents, size, options, use_radix<T>());
+}
+
+}  // namespace detail
+
+}  // namespace structures
+
+#endif
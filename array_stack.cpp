@@ -4,7 +4,12 @@
 #define STRUCTURES_ARRAY_STACK_H
      
 #include <cstdint>  // std::size_t
+#include <iterator>  // std::distance
 #include <stdexcept>  // C++ exceptions
+
+#include "./inline_buffer.h"
+#include "./memory_usage.h"
+#include "./operation_stats.h"
      
 namespace structures {
     
@@ -13,22 +18,36 @@ namespace structures {
      *			   (Last In First Out ou LIFO) - Organização dos elementos onde
      *			   o último a ser inserido é o primeiro a ser retirado.
      *
-     * @tparam     T     Parâmetro genérico de Template
+     * @tparam     T       Parâmetro genérico de Template
+     * @tparam     Inline  Quantidade de elementos guardados dentro do objeto;
+     *                     a pilha só usa o heap quando cresce além dela
+     * @tparam     Stats   Política de estatísticas (NoStats ou OperationStats)
      */
     
 
-    template<typename T>
-    class ArrayStack {
+    template<typename T, std::size_t Inline = 0, typename Stats = NoStats>
+    class ArrayStack : private Stats {
         public:
             ArrayStack();
 
             explicit ArrayStack(std::size_t max);
 
             ~ArrayStack();
+
+            // contents pode apontar para small_: copiar o ponteiro faria as
+            // duas pilhas dividirem (ou liberarem) o mesmo vetor
+            ArrayStack(const ArrayStack&) = delete;
+            ArrayStack& operator=(const ArrayStack&) = delete;
     
             void push(const T& data);  // empilha
+
+            template<typename ForwardIt>
+            void push_bulk(ForwardIt first, ForwardIt last);  // em lote
   
             T pop();  // desempilha
+
+            template<typename OutputIt>
+            std::size_t pop_bulk(OutputIt out, std::size_t max);  // em lote
     
             T& top();
     
@@ -41,79 +60,159 @@ namespace structures {
             bool empty();  // vazia
    
             bool full();  // cheia
+
+            StatsSnapshot stats() const;  // contadores de estatísticas
+
+            void reset_stats();  // zera os contadores
+
+            std::size_t bytes_allocated() const;  // bytes no heap
+
+            std::size_t capacity() const;  // dados que cabem sem alocar
+
+            MemoryUsage memory_usage() const;  // detalhamento da memória
+
+            // repassa alocações a um observador (só com ObservedStats)
+            void observe(AllocationObserver* observer, const char* site);
     
         private:
+            void reserve(std::size_t size);  // garante espaço para size dados
+
             T* contents;
             int top_;
             std::size_t max_size_;
+            InlineBuffer<T, Inline> small_;
             
             static const auto DEFAULT_SIZE = 10u;
     };
    
 }   
 
-#endif // namespace structures
-
 
 //  construtor da classe
 
-template <typename T>
-structures::ArrayStack<T>::ArrayStack() {
-    max_size_ = DEFAULT_SIZE;
-    contents = new T[max_size_];
-    top_ = -1;
-}
+template <typename T, std::size_t Inline, typename Stats>
+structures::ArrayStack<T, Inline, Stats>::ArrayStack() :
+    ArrayStack(DEFAULT_SIZE)
+{}
 
 //  construtor da classe com valor passado por parâmetro
 //  param max do tipo size_t - representa o tamanho máximo de elementos do vetor
+//  enquanto a pilha cabe no buffer interno nenhuma alocação é feita
 
-template <typename T>
-structures::ArrayStack<T>::ArrayStack(std::size_t max) {
+template <typename T, std::size_t Inline, typename Stats>
+structures::ArrayStack<T, Inline, Stats>::ArrayStack(std::size_t max) {
     max_size_ = max;
-    contents = new T[max_size_];
+    if (Inline > 0) {
+        contents = small_.data();
+    } else {
+        contents = new T[max_size_];
+        Stats::allocated(max_size_ * sizeof(T));
+    }
     top_ = -1;
 }
 
 //  destrutor da classe
 
-template <typename T>
-structures::ArrayStack<T>::~ArrayStack() {
-    delete [] contents;
+template <typename T, std::size_t Inline, typename Stats>
+structures::ArrayStack<T, Inline, Stats>::~ArrayStack() {
+    if (contents != small_.data()) {
+        Stats::released(max_size_ * sizeof(T));
+        delete [] contents;
+    }
+}
+
+//  passa os dados do buffer interno para o heap quando eles não cabem mais
+//  param size - quantidade de dados que a pilha precisa comportar
+
+template <typename T, std::size_t Inline, typename Stats>
+void structures::ArrayStack<T, Inline, Stats>::reserve(std::size_t size) {
+    if (contents != small_.data() || size <= Inline)
+        return;
+
+    T* heap = new T[max_size_];
+    Stats::allocated(max_size_ * sizeof(T));
+    for (int i = 0; i <= top_; i++) {
+        heap[i] = contents[i];
+    }
+    contents = heap;
 }
 
 //  adiciona dados ao vetor
 //  param data - um generico que representa o dado a ser armazenado
 
-template <typename T>
-void structures::ArrayStack<T>::push(const T& data) {
+template <typename T, std::size_t Inline, typename Stats>
+void structures::ArrayStack<T, Inline, Stats>::push(const T& data) {
     if (full())
         throw std::out_of_range("Pilha atualmente cheia.");
-        
+
+    Stats::operation();
+    reserve(top_ + 2);
+    top_++;
     contents[top_] = data;
+    Stats::resized(size());
 }
 
 //  retira dados do vetor
 
-template <typename T> 
-T structures::ArrayStack<T>::pop() {
+template <typename T, std::size_t Inline, typename Stats> 
+T structures::ArrayStack<T, Inline, Stats>::pop() {
     if (empty())
         throw std::out_of_range("Pilha atualmente vazia.");
     
+    Stats::operation();
     top_ --;
     return contents[top_+1];
 }
 
+//  empilha um intervalo de dados, verificando o espaço uma só vez
+//  param first, last - intervalo [first, last); o último fica no topo
+
+template <typename T, std::size_t Inline, typename Stats>
+template <typename ForwardIt>
+void structures::ArrayStack<T, Inline, Stats>::push_bulk(ForwardIt first,
+                                                         ForwardIt last) {
+    std::size_t count = std::distance(first, last);
+    if (size() + count > max_size_)
+        throw std::out_of_range("Pilha atualmente cheia.");
+
+    reserve(size() + count);
+    Stats::operation();
+    for (; first != last; ++first) {
+        top_++;
+        contents[top_] = *first;
+    }
+    Stats::resized(size());
+}
+
+//  desempilha até max dados
+//  param out - destino dos dados retirados, a partir do topo
+//  param max - quantidade máxima de dados a retirar
+
+template <typename T, std::size_t Inline, typename Stats>
+template <typename OutputIt>
+std::size_t structures::ArrayStack<T, Inline, Stats>::pop_bulk(OutputIt out,
+                                                               std::size_t max) {
+    Stats::operation();
+    std::size_t count = max < size() ? max : size();
+    for (std::size_t i = 0; i < count; i++) {
+        *out = contents[top_];
+        ++out;
+        top_--;
+    }
+    return count;
+}
+
 //  limpa a pilha
 
-template <typename T>
-void structures::ArrayStack<T>::clear() {
+template <typename T, std::size_t Inline, typename Stats>
+void structures::ArrayStack<T, Inline, Stats>::clear() {
     top_ = -1;
 }
 
 //  retorna o elemento do topo da pilha
 
-template <typename T>
-T& structures::ArrayStack<T>::top() {
+template <typename T, std::size_t Inline, typename Stats>
+T& structures::ArrayStack<T, Inline, Stats>::top() {
     if(empty()) 
         throw std::out_of_range("Pilha vazia.");
             
@@ -122,29 +221,78 @@ T& structures::ArrayStack<T>::top() {
 
 //  retorna o tamanho da pilha
 
-template <typename T>
-std::size_t structures::ArrayStack<T>::size() {
+template <typename T, std::size_t Inline, typename Stats>
+std::size_t structures::ArrayStack<T, Inline, Stats>::size() {
     return (top_+1);
 }
 
 //  retorna o tamanho máximo da pilha
 
-template <typename T>
-std::size_t structures::ArrayStack<T>::max_size() {
+template <typename T, std::size_t Inline, typename Stats>
+std::size_t structures::ArrayStack<T, Inline, Stats>::max_size() {
     return (max_size_);
 }
 
 //  verifica se a pilha está cheia
 
-template <typename T>
-bool structures::ArrayStack<T>::full() {
-    return top_ == max_size_ -1;
+template <typename T, std::size_t Inline, typename Stats>
+bool structures::ArrayStack<T, Inline, Stats>::full() {
+    return size() == max_size_;
 }
 
 //  verifica se a pilha está vazia
 
-template <typename T>
-bool structures::ArrayStack<T>::empty() {
+template <typename T, std::size_t Inline, typename Stats>
+bool structures::ArrayStack<T, Inline, Stats>::empty() {
     return top_ == -1;
 }
 
+//  retorna os contadores da política de estatísticas
+
+template <typename T, std::size_t Inline, typename Stats>
+structures::StatsSnapshot structures::ArrayStack<T, Inline, Stats>::stats() const {
+    return Stats::snapshot();
+}
+
+//  zera os contadores da política de estatísticas
+
+template <typename T, std::size_t Inline, typename Stats>
+void structures::ArrayStack<T, Inline, Stats>::reset_stats() {
+    Stats::reset();
+}
+
+//  retorna os bytes que a pilha ocupa no heap
+
+template <typename T, std::size_t Inline, typename Stats>
+std::size_t structures::ArrayStack<T, Inline, Stats>::bytes_allocated() const {
+    if (contents == small_.data())
+        return 0;
+    return max_size_ * sizeof(T);
+}
+
+//  retorna quantos dados cabem sem nova alocação
+
+template <typename T, std::size_t Inline, typename Stats>
+std::size_t structures::ArrayStack<T, Inline, Stats>::capacity() const {
+    return contents == small_.data() && Inline < max_size_ ? Inline : max_size_;
+}
+
+//  retorna o detalhamento da memória ocupada
+
+template <typename T, std::size_t Inline, typename Stats>
+structures::MemoryUsage
+structures::ArrayStack<T, Inline, Stats>::memory_usage() const {
+    return detail::array_usage<T>(static_cast<std::size_t>(top_ + 1),
+                                  capacity(), bytes_allocated());
+}
+
+//  repassa as alocações ao observador com o rótulo site
+//  exige a política ObservedStats
+
+template <typename T, std::size_t Inline, typename Stats>
+void structures::ArrayStack<T, Inline, Stats>::observe(
+        AllocationObserver* observer, const char* site) {
+    Stats::observe(observer, site);
+}
+
+#endif
@@ -0,0 +1,119 @@
+// Copyright 2017 Letícia do Nascimento
+
+//  Compara a ConcurrentArrayQueue (sem travas) com uma ArrayQueue protegida
+//  por std::mutex: N produtores e N consumidores trocam a mesma quantidade de
+//  dados e o relatório mostra a vazão total. Quando a fila está cheia (ou
+//  vazia) a thread cede a vez com std::this_thread::yield.
+//
+//  g++ -std=c++11 -O2 -pthread -I.. concurrent_array_queue_benchmark.cpp
+//  ./a.out [threads por lado] [dados por produtor] [capacidade]
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "../array_queue.cpp"
+#include "../concurrent_array_queue.h"
+
+namespace {
+
+//  ArrayQueue com uma trava em volta de cada operação
+class LockedArrayQueue {
+ public:
+    explicit LockedArrayQueue(std::size_t max) : queue_(max) { }
+
+    bool try_enqueue(long data) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (queue_.full())
+            return false;
+        queue_.enqueue(data);
+        return true;
+    }
+
+    bool try_dequeue(long& data) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (queue_.empty())
+            return false;
+        data = queue_.dequeue();
+        return true;
+    }
+
+ private:
+    std::mutex mutex_;
+    structures::ArrayQueue<long> queue_;
+};
+
+template<typename Queue>
+void run(const char* name, Queue& queue, std::size_t threads,
+         std::size_t items) {
+    std::atomic<bool> go{false};
+    std::atomic<long long> sum{0};
+    std::vector<std::thread> workers;
+
+    for (std::size_t t = 0; t < threads; t++) {
+        workers.emplace_back([&, t] {
+            while (!go.load(std::memory_order_acquire)) { }
+            for (std::size_t i = 0; i < items; i++) {
+                long data = static_cast<long>(t * items + i);
+                while (!queue.try_enqueue(data))
+                    std::this_thread::yield();
+            }
+        });
+        workers.emplace_back([&] {
+            while (!go.load(std::memory_order_acquire)) { }
+            long long local = 0;
+            long data;
+            for (std::size_t i = 0; i < items; i++) {
+                while (!queue.try_dequeue(data))
+                    std::this_thread::yield();
+                local += data;
+            }
+            sum += local;
+        });
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    go.store(true, std::memory_order_release);
+    for (auto& worker : workers)
+        worker.join();
+    auto end = std::chrono::steady_clock::now();
+
+    long long total = static_cast<long long>(threads * items);
+    long long expected = total * (total - 1) / 2;
+    double seconds = std::chrono::duration<double>(end - start).count();
+    std::printf("%-22s %14.0f op/s  %8.1f ns/op%s\n", name,
+                2 * total / seconds, seconds * 1e9 / (2 * total),
+                sum.load() == expected ? "" : "  (soma incorreta!)");
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    std::size_t threads = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 4;
+    std::size_t items = argc > 2 ? std::strtoul(argv[2], nullptr, 10)
+                                 : 1000000;
+    std::size_t capacity = argc > 3 ? std::strtoul(argv[3], nullptr, 10)
+                                    : 1024;
+    if (threads == 0 || items == 0 || capacity == 0) {
+        std::fprintf(stderr, "uso: %s [threads por lado] [dados por produtor]"
+                             " [capacidade]\n", argv[0]);
+        return 1;
+    }
+
+    std::printf("%zu produtores, %zu consumidores, %zu dados cada, "
+                "capacidade %zu, %u núcleos\n", threads, threads, items,
+                capacity, std::thread::hardware_concurrency());
+    {
+        structures::ConcurrentArrayQueue<long> queue(capacity);
+        run("ConcurrentArrayQueue", queue, threads, items);
+    }
+    {
+        LockedArrayQueue queue(capacity);
+        run("mutex + ArrayQueue", queue, threads, items);
+    }
+    return 0;
+}
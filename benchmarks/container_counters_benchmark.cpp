@@ -0,0 +1,164 @@
+// Copyright 2017 Letícia do Nascimento
+
+//  Mede operações típicas das estruturas com os contadores de hardware da
+//  PerfCounters: ciclos, instruções, cache misses e branch misses por
+//  operação, ao lado do tempo e da vazão. Cache misses altos apontam para o
+//  layout na memória (nodos espalhados); branch misses altos, para desvios
+//  imprevisíveis nas comparações.
+//
+//  g++ -std=c++11 -O2 -I.. container_counters_benchmark.cpp
+//  ./a.out [elementos] [operações]
+//
+//  Sem permissão para perf_event_open (veja /proc/sys/kernel/
+//  perf_event_paranoid), as colunas dos contadores saem como "-".
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#include "./perf_counters.h"
+#include "../array_list.cpp"
+#include "../array_queue.cpp"
+#include "../array_stack.cpp"
+#include "../circular_list.h"
+#include "../doubly_linked_list.h"
+#include "../linked_list.h"
+#include "../linked_queue.h"
+#include "../linked_stack.h"
+
+namespace {
+
+volatile long sink;  // impede que o compilador descarte os resultados
+
+void print_counter(const structures::PerfSample& sample,
+                   structures::PerfEvent event, std::size_t operations) {
+    double value = sample.per_operation(event, operations);
+    if (value < 0)
+        std::printf(" %10s", "-");
+    else
+        std::printf(" %10.2f", value);
+}
+
+//  executa body(i) operations vezes e imprime uma linha do relatório
+template<typename Body>
+void measure(structures::PerfCounters& counters, const char* name,
+             std::size_t operations, Body body) {
+    auto start = std::chrono::steady_clock::now();
+    counters.start();
+    for (std::size_t i = 0; i < operations; i++)
+        body(i);
+    structures::PerfSample sample = counters.stop();
+    auto end = std::chrono::steady_clock::now();
+
+    double ns = std::chrono::duration<double, std::nano>(end - start).count();
+    std::printf("%-28s %10.1f %12.0f", name, ns / operations,
+                operations / (ns / 1e9));
+    print_counter(sample, structures::PERF_CYCLES, operations);
+    print_counter(sample, structures::PERF_INSTRUCTIONS, operations);
+    print_counter(sample, structures::PERF_CACHE_MISSES, operations);
+    print_counter(sample, structures::PERF_BRANCH_MISSES, operations);
+    std::printf("\n");
+}
+
+//  preenche uma lista com 0, 2, 4, ... em ordem
+template<typename List>
+void fill(List& list, std::size_t elements) {
+    for (std::size_t i = 0; i < elements; i++)
+        list.push_back(static_cast<int>(2 * i));
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    std::size_t elements = argc > 1 ? std::strtoul(argv[1], nullptr, 10)
+                                    : 10000;
+    std::size_t operations = argc > 2 ? std::strtoul(argv[2], nullptr, 10)
+                                      : 2000;
+    if (elements == 0 || operations == 0) {
+        std::fprintf(stderr, "uso: %s [elementos] [operações]\n", argv[0]);
+        return 1;
+    }
+
+    structures::PerfCounters counters;
+    std::printf("%zu elementos int, %zu operações por linha%s\n", elements,
+                operations, counters.available()
+                                ? "" : " (contadores indisponíveis)");
+    std::printf("%-28s %10s %12s %10s %10s %10s %10s\n", "operação",
+                "ns/op", "op/s", "ciclos", "instruções", "cache-miss",
+                "branch-miss");
+
+    std::srand(42);
+    std::size_t* indexes = new std::size_t[operations];
+    for (std::size_t i = 0; i < operations; i++)
+        indexes[i] = static_cast<std::size_t>(std::rand()) % elements;
+
+    {
+        structures::ArrayList<int> list(elements + operations);
+        fill(list, elements);
+        measure(counters, "ArrayList::at", operations,
+                [&](std::size_t i) { sink = sink + list.at(indexes[i]); });
+        measure(counters, "ArrayList::insert", operations,
+                [&](std::size_t i) { list.insert(1, indexes[i]); });
+        measure(counters, "ArrayList::find", operations,
+                [&](std::size_t i) {
+                    sink = sink + static_cast<long>(
+                        list.find(static_cast<int>(indexes[i])));
+                });
+    }
+    {
+        structures::LinkedList<int> list;
+        fill(list, elements);
+        measure(counters, "LinkedList::at", operations,
+                [&](std::size_t i) { sink = sink + list.at(indexes[i]); });
+        measure(counters, "LinkedList::insert_sorted", operations,
+                [&](std::size_t i) {
+                    list.insert_sorted(static_cast<int>(indexes[i]));
+                });
+    }
+    {
+        structures::DoublyLinkedList<int> list;
+        fill(list, elements);
+        measure(counters, "DoublyLinkedList::at", operations,
+                [&](std::size_t i) { sink = sink + list.at(indexes[i]); });
+        measure(counters, "DoublyLinkedList::insert", operations,
+                [&](std::size_t i) { list.insert(1, indexes[i]); });
+        measure(counters, "DoublyLinkedList::find", operations,
+                [&](std::size_t i) {
+                    sink = sink + static_cast<long>(
+                        list.find(static_cast<int>(indexes[i])));
+                });
+    }
+    {
+        structures::CircularList<int> list;
+        fill(list, elements);
+        measure(counters, "CircularList::at", operations,
+                [&](std::size_t i) { sink = sink + list.at(indexes[i]); });
+    }
+    {
+        structures::ArrayStack<int> stack(operations);
+        structures::LinkedStack<int> linked;
+        measure(counters, "ArrayStack::push", operations,
+                [&](std::size_t i) { stack.push(static_cast<int>(i)); });
+        measure(counters, "ArrayStack::pop", operations,
+                [&](std::size_t) { sink = sink + stack.pop(); });
+        measure(counters, "LinkedStack::push", operations,
+                [&](std::size_t i) { linked.push(static_cast<int>(i)); });
+        measure(counters, "LinkedStack::pop", operations,
+                [&](std::size_t) { sink = sink + linked.pop(); });
+    }
+    {
+        structures::ArrayQueue<int> queue(operations);
+        structures::LinkedQueue<int> linked;
+        measure(counters, "ArrayQueue::enqueue", operations,
+                [&](std::size_t i) { queue.enqueue(static_cast<int>(i)); });
+        measure(counters, "ArrayQueue::dequeue", operations,
+                [&](std::size_t) { sink = sink + queue.dequeue(); });
+        measure(counters, "LinkedQueue::enqueue", operations,
+                [&](std::size_t i) { linked.enqueue(static_cast<int>(i)); });
+        measure(counters, "LinkedQueue::dequeue", operations,
+                [&](std::size_t) { sink = sink + linked.dequeue(); });
+    }
+
+    delete[] indexes;
+    return 0;
+}
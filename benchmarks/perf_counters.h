@@ -0,0 +1,173 @@
+// Copyright 2017 Letícia do Nascimento
+
+#ifndef STRUCTURES_BENCHMARKS_PERF_COUNTERS_H
+#define STRUCTURES_BENCHMARKS_PERF_COUNTERS_H
+
+#include <cstdint>
+#include <cstring>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace structures {
+
+/**
+ * @brief      Contadores de hardware lidos pela PerfCounters.
+ */
+enum PerfEvent {
+    PERF_CYCLES,
+    PERF_INSTRUCTIONS,
+    PERF_CACHE_MISSES,
+    PERF_BRANCH_MISSES,
+    PERF_EVENT_COUNT
+};
+
+/**
+ * @brief      Leitura dos contadores entre start() e stop(). Um contador que o
+ *             sistema não oferece fica com available falso.
+ */
+struct PerfSample {
+    std::uint64_t values[PERF_EVENT_COUNT]{};
+    bool available[PERF_EVENT_COUNT]{};
+
+    //  contador por operação, ou -1 se indisponível
+    double per_operation(PerfEvent event, std::uint64_t operations) const {
+        if (!available[event] || operations == 0)
+            return -1.0;
+        return static_cast<double>(values[event]) / operations;
+    }
+};
+
+/**
+ * @brief      Grupo de contadores de hardware (perf_event_open) da thread
+ *             atual: ciclos, instruções, cache misses e branch misses, só em
+ *             modo usuário. Fora do Linux, ou quando o kernel recusa
+ *             (perf_event_paranoid, contêineres, máquinas virtuais), os
+ *             contadores ficam indisponíveis e o benchmark segue só com o
+ *             tempo.
+ */
+class PerfCounters {
+ public:
+    PerfCounters();
+    ~PerfCounters();
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    bool available() const;  // algum contador abriu?
+    void start();  // zera e liga os contadores
+    PerfSample stop();  // desliga e lê os contadores
+
+    static const char* name(PerfEvent event);  // nome para relatórios
+
+ private:
+    int fds_[PERF_EVENT_COUNT];
+    int leader_{-1};
+};
+
+/**
+ *   Construtor da classe PerfCounters: abre os contadores que o sistema
+ * permitir, num grupo para que sejam medidos juntos.
+ */
+inline PerfCounters::PerfCounters() {
+    for (int i = 0; i < PERF_EVENT_COUNT; i++)
+        fds_[i] = -1;
+#ifdef __linux__
+    static const std::uint64_t configs[PERF_EVENT_COUNT] = {
+        PERF_COUNT_HW_CPU_CYCLES,
+        PERF_COUNT_HW_INSTRUCTIONS,
+        PERF_COUNT_HW_CACHE_MISSES,
+        PERF_COUNT_HW_BRANCH_MISSES,
+    };
+    for (int i = 0; i < PERF_EVENT_COUNT; i++) {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = configs[i];
+        attr.disabled = leader_ == -1 ? 1 : 0;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED |
+                           PERF_FORMAT_TOTAL_TIME_RUNNING;
+        fds_[i] = static_cast<int>(
+            syscall(__NR_perf_event_open, &attr, 0, -1, leader_, 0));
+        if (fds_[i] != -1 && leader_ == -1)
+            leader_ = fds_[i];
+    }
+#endif
+}
+
+/**
+ *   Destrutor da classe PerfCounters.
+ */
+inline PerfCounters::~PerfCounters() {
+#ifdef __linux__
+    for (int i = 0; i < PERF_EVENT_COUNT; i++)
+        if (fds_[i] != -1)
+            close(fds_[i]);
+#endif
+}
+
+/**
+ *   Verifica se algum contador pôde ser aberto (PerfCounters).
+ */
+inline bool PerfCounters::available() const {
+    return leader_ != -1;
+}
+
+/**
+ *   Zera e liga o grupo de contadores (PerfCounters).
+ */
+inline void PerfCounters::start() {
+#ifdef __linux__
+    if (leader_ == -1)
+        return;
+    ioctl(leader_, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(leader_, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#endif
+}
+
+/**
+ *   Desliga o grupo e retorna as leituras (PerfCounters). Se o kernel
+ * multiplexou os contadores, os valores são escalados pelo tempo em que
+ * estiveram ativos.
+ */
+inline PerfSample PerfCounters::stop() {
+    PerfSample sample;
+#ifdef __linux__
+    if (leader_ == -1)
+        return sample;
+    ioctl(leader_, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+    for (int i = 0; i < PERF_EVENT_COUNT; i++) {
+        std::uint64_t data[3];  // valor, tempo ligado, tempo medindo
+        if (fds_[i] == -1 || read(fds_[i], data, sizeof(data)) !=
+                             static_cast<ssize_t>(sizeof(data)))
+            continue;
+        if (data[2] == 0)
+            continue;
+        double scale = static_cast<double>(data[1]) / data[2];
+        sample.values[i] = static_cast<std::uint64_t>(data[0] * scale);
+        sample.available[i] = true;
+    }
+#endif
+    return sample;
+}
+
+/**
+ *   Retorna o nome curto de um contador (PerfCounters).
+ */
+inline const char* PerfCounters::name(PerfEvent event) {
+    static const char* const names[PERF_EVENT_COUNT] = {
+        "cycles", "instructions", "cache-misses", "branch-misses",
+    };
+    return names[event];
+}
+
+}  // namespace structures
+
+#endif
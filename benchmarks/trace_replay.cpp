@@ -0,0 +1,174 @@
+// Copyright 2017 Letícia do Nascimento
+
+//  Repete um trace gravado com Traced/TraceWriter nas oito estruturas e
+//  informa vazão e distribuição de latência por operação, para escolher a
+//  estrutura pelo padrão de acesso real.
+//
+//  g++ -std=c++11 -O2 -I.. trace_replay.cpp
+//  ./a.out record trace.bin [operações] [semente]   grava um trace sintético
+//  ./a.out trace.bin                                 repete o trace
+//
+//  Operações que a estrutura não tem (pop_front numa pilha, por exemplo) são
+//  puladas; operações que lançam exceção (retirar de estrutura vazia) contam
+//  como falhas. O checksum soma os dados retirados e consultados: estruturas
+//  com a mesma semântica devem chegar ao mesmo valor. A latência inclui o
+//  custo de ler o relógio, cerca de 20 ns.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+#include "../array_list.cpp"
+#include "../array_queue.cpp"
+#include "../array_stack.cpp"
+#include "../circular_list.h"
+#include "../doubly_linked_list.h"
+#include "../latency_histogram.h"
+#include "../linked_list.h"
+#include "../linked_queue.h"
+#include "../linked_stack.h"
+#include "../operation_trace.h"
+
+namespace {
+
+const std::size_t ARRAY_CAPACITY = 1u << 20;  // vetores não crescem sozinhos
+
+//  grava uma mistura de inserções, retiradas e buscas numa lista ordenada
+int record(const char* path, std::size_t operations, unsigned seed) {
+    std::ofstream output(path, std::ios::binary);
+    if (!output) {
+        std::fprintf(stderr, "não foi possível criar %s\n", path);
+        return 1;
+    }
+    structures::TraceWriter writer(output);
+    structures::Traced<int, structures::DoublyLinkedList<int>> list(writer);
+
+    std::srand(seed);
+    for (std::size_t i = 0; i < operations; i++) {
+        int data = std::rand() % 1000;
+        int choice = std::rand() % 100;
+        if (choice < 35 || list.empty())
+            list.insert_sorted(data);
+        else if (choice < 55)
+            list.push_back(data);
+        else if (choice < 75)
+            list.pop_front();
+        else if (choice < 90)
+            list.find(data);
+        else if (list.contains(data))
+            list.remove(data);
+    }
+    std::printf("%llu operações gravadas em %s\n",
+                static_cast<unsigned long long>(writer.records()), path);
+    return 0;
+}
+
+template<typename Structure>
+void replay(const char* name, Structure& structure,
+            const std::vector<structures::TraceRecord>& records) {
+    structures::LatencyHistogram<> latency;
+    std::int64_t checksum = 0;
+    std::size_t skipped = 0, failed = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (const structures::TraceRecord& record : records) {
+        auto before = std::chrono::steady_clock::now();
+        try {
+            if (!structures::replay_operation<int>(structure, record,
+                                                   checksum)) {
+                skipped++;
+                continue;
+            }
+        } catch (const std::out_of_range&) {
+            failed++;
+        }
+        auto after = std::chrono::steady_clock::now();
+        latency.record(static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                after - before).count()));
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    double seconds = std::chrono::duration<double>(end - start).count();
+    std::printf("%-18s %12.0f %8zu %8zu %8llu %8llu %8llu %10llu %14lld\n",
+                name, latency.count() / seconds, skipped, failed,
+                static_cast<unsigned long long>(latency.percentile(50)),
+                static_cast<unsigned long long>(latency.percentile(99)),
+                static_cast<unsigned long long>(latency.percentile(99.9)),
+                static_cast<unsigned long long>(latency.max()),
+                static_cast<long long>(checksum));
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    if (argc >= 3 && std::strcmp(argv[1], "record") == 0) {
+        std::size_t operations = argc > 3 ? std::strtoul(argv[3], nullptr, 10)
+                                          : 100000;
+        unsigned seed = argc > 4 ? std::strtoul(argv[4], nullptr, 10) : 42;
+        return record(argv[2], operations, seed);
+    }
+    if (argc != 2) {
+        std::fprintf(stderr, "uso: %s record trace [operações] [semente]\n"
+                             "     %s trace\n", argv[0], argv[0]);
+        return 1;
+    }
+
+    std::vector<structures::TraceRecord> records;
+    try {
+        std::ifstream input(argv[1], std::ios::binary);
+        if (!input) {
+            std::fprintf(stderr, "não foi possível abrir %s\n", argv[1]);
+            return 1;
+        }
+        structures::TraceReader reader(input);
+        structures::TraceRecord record;
+        while (reader.read(record))
+            records.push_back(record);
+    } catch (const std::invalid_argument& error) {
+        std::fprintf(stderr, "%s: %s\n", argv[1], error.what());
+        return 1;
+    }
+
+    std::printf("%zu operações; latências em ns\n", records.size());
+    std::printf("%-18s %12s %8s %8s %8s %8s %8s %10s %14s\n", "estrutura",
+                "op/s", "puladas", "falhas", "p50", "p99", "p99.9", "máx",
+                "checksum");
+    {
+        structures::ArrayList<int> list(ARRAY_CAPACITY);
+        replay("ArrayList", list, records);
+    }
+    {
+        structures::LinkedList<int> list;
+        replay("LinkedList", list, records);
+    }
+    {
+        structures::DoublyLinkedList<int> list;
+        replay("DoublyLinkedList", list, records);
+    }
+    {
+        structures::CircularList<int> list;
+        replay("CircularList", list, records);
+    }
+    {
+        structures::ArrayStack<int> stack(ARRAY_CAPACITY);
+        replay("ArrayStack", stack, records);
+    }
+    {
+        structures::LinkedStack<int> stack;
+        replay("LinkedStack", stack, records);
+    }
+    {
+        structures::ArrayQueue<int> queue(ARRAY_CAPACITY);
+        replay("ArrayQueue", queue, records);
+    }
+    {
+        structures::LinkedQueue<int> queue;
+        replay("LinkedQueue", queue, records);
+    }
+    return 0;
+}
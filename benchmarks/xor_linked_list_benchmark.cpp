@@ -0,0 +1,78 @@
+// Copyright 2017 Letícia do Nascimento
+
+//  Compara a DoublyLinkedList (dois ponteiros por nodo) com a XorLinkedList
+//  (um elo por nodo): bytes pedidos ao heap por nodo e tempo de percurso.
+//
+//  g++ -std=c++11 -O2 -I.. xor_linked_list_benchmark.cpp
+//  ./a.out [elementos] [repetições]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+#include "../doubly_linked_list.h"
+#include "../xor_linked_list.h"
+
+namespace {
+
+std::size_t allocated_bytes = 0;  // bytes pedidos, sem o cabeçalho do malloc
+
+}  // namespace
+
+void* operator new(std::size_t size) {
+    allocated_bytes += size;
+    if (void* memory = std::malloc(size))
+        return memory;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept {
+    std::free(memory);
+}
+
+namespace {
+
+template<typename List>
+void run(const char* name, std::size_t elements, std::size_t repetitions) {
+    std::size_t before = allocated_bytes;
+    List list;
+    for (std::size_t i = 0; i < elements; i++)
+        list.push_front(static_cast<int>(i));
+    std::size_t bytes = allocated_bytes - before;
+
+    std::size_t found = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t r = 0; r < repetitions; r++)
+        found += list.find(-1);  // ausente: percorre a lista inteira
+    auto end = std::chrono::steady_clock::now();
+
+    double ns = std::chrono::duration<double, std::nano>(end - start).count();
+    std::printf("%-18s %10.1f bytes/nodo %10.2f ns/nodo  (%zu)\n", name,
+                static_cast<double>(bytes) / elements,
+                ns / (static_cast<double>(elements) * repetitions), found);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    std::size_t elements = argc > 1 ? std::strtoul(argv[1], nullptr, 10)
+                                    : 1000000;
+    std::size_t repetitions = argc > 2 ? std::strtoul(argv[2], nullptr, 10)
+                                       : 20;
+    if (elements == 0 || repetitions == 0) {
+        std::fprintf(stderr, "uso: %s [elementos] [repetições]\n", argv[0]);
+        return 1;
+    }
+
+    std::printf("%zu elementos int, %zu percursos\n", elements, repetitions);
+    run<structures::DoublyLinkedList<int>>("DoublyLinkedList", elements,
+                                           repetitions);
+    run<structures::XorLinkedList<int>>("XorLinkedList", elements,
+                                        repetitions);
+    return 0;
+}
@@ -0,0 +1,347 @@
+// Copyright 2017 Letícia do Nascimento
+
+#ifndef STRUCTURES_CHUNKED_QUEUE_H
+#define STRUCTURES_CHUNKED_QUEUE_H
+
+#include <cstdint>
+#include <stdexcept>  // C++ exception
+
+#include "./memory_usage.h"
+#include "./operation_stats.h"
+
+namespace structures {
+
+    /**
+     * @brief      Implementação de uma Fila (FIFO) segmentada: vetores de
+     *             tamanho fixo encadeados entre si, no estilo de um deque.
+     *             Substitui a LinkedQueue com a mesma interface, mas aloca um
+     *             bloco a cada block_size elementos em vez de um nodo por
+     *             elemento. Blocos esvaziados são reciclados, então em regime
+     *             estável enfileirar e desenfileirar não alocam memória.
+     *
+     * @tparam     T      Parâmetro genérico de Template
+     * @tparam     Stats  Política de estatísticas (NoStats ou OperationStats)
+     */
+
+template<typename T, typename Stats = NoStats>
+class ChunkedQueue : private Stats {
+ public:
+    ChunkedQueue();
+
+    explicit ChunkedQueue(std::size_t block_size);
+
+    ~ChunkedQueue();
+
+    ChunkedQueue(const ChunkedQueue&) = delete;
+    ChunkedQueue& operator=(const ChunkedQueue&) = delete;
+
+    void clear();  // limpar
+
+    void shrink();  // liberar blocos reciclados
+
+    void enqueue(const T& data);  // enfilerar
+
+    T dequeue();  // desenfilerar
+
+    T& front() const;  // primeiro dado
+
+    T& back() const;  // último dado
+
+    bool empty() const;  // fila vazia
+
+    std::size_t size() const;  // tamanho
+
+    std::size_t block_size() const;  // elementos por bloco
+
+    StatsSnapshot stats() const;  // contadores de estatísticas
+    void reset_stats();  // zera os contadores
+    std::size_t bytes_allocated() const;  // bytes no heap
+    std::size_t capacity() const;  // posições nos blocos alocados
+    MemoryUsage memory_usage() const;  // detalhamento da memória
+    // repassa alocações a um observador (só com ObservedStats)
+    void observe(AllocationObserver* observer, const char* site);
+
+ private:
+    class Block {
+     public:
+        explicit Block(std::size_t size) : contents_{new T[size]} { }
+        ~Block() { delete [] contents_; }
+
+        T* contents() { return contents_; }  // getter: dados
+
+        Block* next() { return next_; }  // getter: próximo
+        void next(Block* next) { next_ = next; }  // setter: próximo
+     private:
+        T* contents_;
+        Block* next_{nullptr};
+    };
+
+    Block* acquire();  // bloco vazio, reciclado se possível
+    void release(Block* block);  // recicla um bloco esvaziado
+    void destroy(Block* block);  // libera um bloco
+
+    // bytes de um bloco: o objeto e o vetor de dados
+    std::size_t block_bytes() const {
+        return sizeof(Block) + block_size_ * sizeof(T);
+    }
+
+    Block* head;  // bloco-cabeça
+    Block* tail;  // bloco-fim
+    Block* free_;  // blocos reciclados
+    std::size_t head_index_;  // posição do primeiro dado no bloco-cabeça
+    std::size_t tail_index_;  // próxima posição livre no bloco-fim
+    std::size_t size_;  // tamanho
+    std::size_t block_size_;  // elementos por bloco
+    std::size_t blocks_;  // blocos alocados, em uso ou reciclados
+
+    static const auto DEFAULT_BLOCK = 256u;
+};
+
+/**
+ *   Construtor padrão da classe ChunkedQueue.
+ */
+template<typename T, typename Stats>
+ChunkedQueue<T, Stats>::ChunkedQueue() :
+    ChunkedQueue(DEFAULT_BLOCK)
+{}
+
+/**
+ *   Construtor da classe ChunkedQueue com a quantidade de elementos por bloco.
+ */
+template<typename T, typename Stats>
+ChunkedQueue<T, Stats>::ChunkedQueue(std::size_t block_size) {
+    if (block_size == 0)
+        throw std::invalid_argument("Tamanho de bloco inválido.");
+    head = nullptr;
+    tail = nullptr;
+    free_ = nullptr;
+    head_index_ = 0;
+    tail_index_ = 0;
+    size_ = 0;
+    block_size_ = block_size;
+    blocks_ = 0;
+}
+
+/**
+ *   Destrutor padrão da classe ChunkedQueue.
+ */
+template<typename T, typename Stats>
+ChunkedQueue<T, Stats>::~ChunkedQueue() {
+    while (head != nullptr) {
+        Block* next = head->next();
+        destroy(head);
+        head = next;
+    }
+    shrink();
+}
+
+/**
+ *   Retorna um bloco vazio, reaproveitando os reciclados antes de alocar.
+ */
+template<typename T, typename Stats>
+typename ChunkedQueue<T, Stats>::Block* ChunkedQueue<T, Stats>::acquire() {
+    if (free_ == nullptr) {
+        Block* block = new Block(block_size_);
+        Stats::allocated(block_bytes());
+        blocks_++;
+        return block;
+    }
+
+    Block* block = free_;
+    free_ = block->next();
+    block->next(nullptr);
+    return block;
+}
+
+/**
+ *   Guarda um bloco esvaziado para ser reaproveitado (ChunkedQueue).
+ */
+template<typename T, typename Stats>
+void ChunkedQueue<T, Stats>::release(Block* block) {
+    block->next(free_);
+    free_ = block;
+}
+
+/**
+ *   Libera um bloco, descontando-o da memória alocada (ChunkedQueue).
+ */
+template<typename T, typename Stats>
+void ChunkedQueue<T, Stats>::destroy(Block* block) {
+    Stats::released(block_bytes());
+    blocks_--;
+    delete block;
+}
+
+/**
+ *   Faz uma limpeza da fila (ChunkedQueue), reciclando os blocos.
+ */
+template<typename T, typename Stats>
+void ChunkedQueue<T, Stats>::clear() {
+    while (head != tail) {
+        Block* next = head->next();
+        release(head);
+        head = next;
+    }
+    head_index_ = 0;
+    tail_index_ = 0;
+    size_ = 0;
+}
+
+/**
+ *   Libera os blocos reciclados que não estão em uso (ChunkedQueue).
+ */
+template<typename T, typename Stats>
+void ChunkedQueue<T, Stats>::shrink() {
+    while (free_ != nullptr) {
+        Block* next = free_->next();
+        destroy(free_);
+        free_ = next;
+    }
+}
+
+/**
+ *   Verifica se a fila (ChunkedQueue) está vazia.
+ */
+template<typename T, typename Stats>
+bool ChunkedQueue<T, Stats>::empty() const {
+    return size_ == 0;
+}
+
+/**
+ *   Verifica e retorna o tamanho da fila (ChunkedQueue).
+ */
+template<typename T, typename Stats>
+std::size_t ChunkedQueue<T, Stats>::size() const {
+    return size_;
+}
+
+/**
+ *   Retorna a quantidade de elementos por bloco (ChunkedQueue).
+ */
+template<typename T, typename Stats>
+std::size_t ChunkedQueue<T, Stats>::block_size() const {
+    return block_size_;
+}
+
+/**
+ * Inserir novo elemento na fila (ChunkedQueue).
+ */
+template<typename T, typename Stats>
+void ChunkedQueue<T, Stats>::enqueue(const T& data) {
+    if (tail == nullptr) {
+        head = tail = acquire();
+    } else if (tail_index_ == block_size_) {
+        Block* block = acquire();
+        tail->next(block);
+        tail = block;
+        tail_index_ = 0;
+    }
+    Stats::operation();
+    tail->contents()[tail_index_] = data;
+    tail_index_++;
+    size_++;
+    Stats::resized(size_);
+}
+
+/**
+ *   Remove um elemento da fila (ChunkedQueue).
+ */
+template<typename T, typename Stats>
+T ChunkedQueue<T, Stats>::dequeue() {
+    if (empty())
+        throw std::out_of_range("Fila vazia!");
+
+    Stats::operation();
+    T return_ = head->contents()[head_index_];
+    head_index_++;
+    size_--;
+
+    if (size_ == 0) {
+        head_index_ = 0;
+        tail_index_ = 0;
+    } else if (head_index_ == block_size_) {
+        Block* next = head->next();
+        release(head);
+        head = next;
+        head_index_ = 0;
+    }
+    return return_;
+}
+
+/**
+ *   Retorna o primeiro elemento da fila (ChunkedQueue).
+ */
+template<typename T, typename Stats>
+T& ChunkedQueue<T, Stats>::front() const {
+    if (empty())
+        throw std::out_of_range("Fila vazia.");
+    return head->contents()[head_index_];
+}
+
+/**
+ *   Retorna o último elemento da fila (ChunkedQueue).
+ */
+template<typename T, typename Stats>
+T& ChunkedQueue<T, Stats>::back() const {
+    if (empty())
+        throw std::out_of_range("Fila vazia.");
+    return tail->contents()[tail_index_ - 1];
+}
+
+/**
+ *   Retorna os contadores da política de estatísticas (ChunkedQueue).
+ */
+template<typename T, typename Stats>
+StatsSnapshot ChunkedQueue<T, Stats>::stats() const {
+    return Stats::snapshot();
+}
+
+/**
+ *   Zera os contadores da política de estatísticas (ChunkedQueue).
+ */
+template<typename T, typename Stats>
+void ChunkedQueue<T, Stats>::reset_stats() {
+    Stats::reset();
+}
+
+/**
+ *   Retorna os bytes que a fila ocupa no heap, blocos reciclados incluídos
+ * (ChunkedQueue).
+ */
+template<typename T, typename Stats>
+std::size_t ChunkedQueue<T, Stats>::bytes_allocated() const {
+    return blocks_ * block_bytes();
+}
+
+/**
+ *   Retorna quantas posições os blocos alocados têm (ChunkedQueue); as já
+ * consumidas no bloco-cabeça só voltam a ser usadas quando ele é reciclado.
+ */
+template<typename T, typename Stats>
+std::size_t ChunkedQueue<T, Stats>::capacity() const {
+    return blocks_ * block_size_;
+}
+
+/**
+ *   Retorna o detalhamento da memória ocupada (ChunkedQueue); cada bloco
+ * conta como um nodo.
+ */
+template<typename T, typename Stats>
+MemoryUsage ChunkedQueue<T, Stats>::memory_usage() const {
+    return detail::block_usage<T>(size_, capacity(), blocks_,
+                                  bytes_allocated());
+}
+
+/**
+ *   Repassa as alocações ao observador com o rótulo site (ChunkedQueue);
+ * exige a política ObservedStats.
+ */
+template<typename T, typename Stats>
+void ChunkedQueue<T, Stats>::observe(AllocationObserver* observer,
+                                     const char* site) {
+    Stats::observe(observer, site);
+}
+
+}  // namespace structures
+
+#endif
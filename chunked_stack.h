@@ -0,0 +1,341 @@
+//  Copyright 2017 Letícia do Nascimento
+
+#ifndef STRUCTURES_CHUNKED_STACK_H
+#define STRUCTURES_CHUNKED_STACK_H
+
+#include <cstdint>  // std::size_t
+#include <stdexcept>  // C++ exceptions
+
+#include "./memory_usage.h"
+#include "./operation_stats.h"
+
+namespace structures {
+
+    /**
+     * @brief      Implementação de uma Pilha (LIFO) sobre blocos de tamanho
+     *             fixo. Quando o bloco do topo enche, um novo bloco é
+     *             encadeado em vez de realocar e copiar o vetor: o push é O(1)
+     *             no pior caso e as referências retornadas por top() continuam
+     *             válidas enquanto o dado estiver na pilha. Blocos esvaziados
+     *             ficam guardados para reuso, evitando alocar e liberar
+     *             repetidamente na fronteira entre dois blocos.
+     *
+     * @tparam     T      Parâmetro genérico de Template
+     * @tparam     Stats  Política de estatísticas (NoStats ou OperationStats)
+     */
+
+    template<typename T, typename Stats = NoStats>
+    class ChunkedStack : private Stats {
+        public:
+            ChunkedStack();
+
+            explicit ChunkedStack(std::size_t chunk_size,
+                                  std::size_t max_spare = 1);
+
+            ~ChunkedStack();
+
+            ChunkedStack(const ChunkedStack&) = delete;
+            ChunkedStack& operator=(const ChunkedStack&) = delete;
+
+            void push(const T& data);  // empilha
+
+            T pop();  // desempilha
+
+            T& top();
+
+            void clear();  // limpa
+
+            void shrink();  // libera os blocos guardados para reuso
+
+            std::size_t size() const;  // tamanho
+
+            std::size_t chunk_size() const;  // elementos por bloco
+
+            std::size_t spare_chunks() const;  // blocos guardados para reuso
+
+            bool empty() const;  // vazia
+
+            StatsSnapshot stats() const;  // contadores de estatísticas
+
+            void reset_stats();  // zera os contadores
+
+            std::size_t bytes_allocated() const;  // bytes no heap
+
+            std::size_t capacity() const;  // dados que cabem sem alocar
+
+            MemoryUsage memory_usage() const;  // detalhamento da memória
+
+            // repassa alocações a um observador (só com ObservedStats)
+            void observe(AllocationObserver* observer, const char* site);
+
+        private:
+            class Chunk {
+             public:
+                explicit Chunk(std::size_t size) : contents_{new T[size]} { }
+                ~Chunk() { delete [] contents_; }
+
+                T* contents() { return contents_; }  // getter: dados
+
+                Chunk* below() { return below_; }  // getter: bloco de baixo
+                void below(Chunk* chunk) { below_ = chunk; }  // setter
+
+             private:
+                T* contents_;
+                Chunk* below_{nullptr};
+            };
+
+            Chunk* acquire();  // bloco vazio, reaproveitado se possível
+            void release(Chunk* chunk);  // devolve bloco vazio
+            void destroy(Chunk* chunk);  // libera um bloco
+
+            // bytes de um bloco: o objeto e o vetor de dados
+            std::size_t chunk_bytes() const {
+                return sizeof(Chunk) + chunk_size_ * sizeof(T);
+            }
+
+            Chunk* top_chunk_;  // bloco do topo
+            Chunk* spare_;  // blocos vazios guardados para reuso
+            std::size_t used_;  // dados ocupados no bloco do topo
+            std::size_t size_;
+            std::size_t chunk_size_;
+            std::size_t spare_count_;
+            std::size_t max_spare_;
+            std::size_t chunks_;  // blocos alocados, em uso ou guardados
+
+            static const auto DEFAULT_CHUNK = 64u;
+    };
+
+}  // namespace structures
+
+#endif
+
+
+//  construtor da classe
+
+template <typename T, typename Stats>
+structures::ChunkedStack<T, Stats>::ChunkedStack() :
+    ChunkedStack(DEFAULT_CHUNK)
+{}
+
+//  construtor da classe com valores passados por parâmetro
+//  param chunk_size - quantidade de elementos em cada bloco
+//  param max_spare - quantos blocos vazios são guardados para reuso
+
+template <typename T, typename Stats>
+structures::ChunkedStack<T, Stats>::ChunkedStack(std::size_t chunk_size,
+                                          std::size_t max_spare) {
+    if (chunk_size == 0)
+        throw std::invalid_argument("Tamanho de bloco inválido.");
+
+    top_chunk_ = nullptr;
+    spare_ = nullptr;
+    used_ = 0;
+    size_ = 0;
+    chunk_size_ = chunk_size;
+    spare_count_ = 0;
+    max_spare_ = max_spare;
+    chunks_ = 0;
+}
+
+//  destrutor da classe
+
+template <typename T, typename Stats>
+structures::ChunkedStack<T, Stats>::~ChunkedStack() {
+    while (top_chunk_ != nullptr) {
+        Chunk* below = top_chunk_->below();
+        destroy(top_chunk_);
+        top_chunk_ = below;
+    }
+    shrink();
+}
+
+//  retorna um bloco vazio, usando os guardados antes de alocar
+
+template <typename T, typename Stats>
+typename structures::ChunkedStack<T, Stats>::Chunk*
+structures::ChunkedStack<T, Stats>::acquire() {
+    if (spare_ == nullptr) {
+        Chunk* chunk = new Chunk(chunk_size_);
+        Stats::allocated(chunk_bytes());
+        chunks_++;
+        return chunk;
+    }
+
+    Chunk* chunk = spare_;
+    spare_ = chunk->below();
+    spare_count_--;
+    return chunk;
+}
+
+//  guarda um bloco vazio para reuso, ou o libera se já há blocos suficientes
+//  param chunk - bloco que deixou de ser usado
+
+template <typename T, typename Stats>
+void structures::ChunkedStack<T, Stats>::release(Chunk* chunk) {
+    if (spare_count_ >= max_spare_) {
+        destroy(chunk);
+        return;
+    }
+    chunk->below(spare_);
+    spare_ = chunk;
+    spare_count_++;
+}
+
+//  libera um bloco, descontando-o da memória alocada
+//  param chunk - bloco que não está na pilha nem entre os guardados
+
+template <typename T, typename Stats>
+void structures::ChunkedStack<T, Stats>::destroy(Chunk* chunk) {
+    Stats::released(chunk_bytes());
+    chunks_--;
+    delete chunk;
+}
+
+//  adiciona dados à pilha
+//  param data - um generico que representa o dado a ser armazenado
+
+template <typename T, typename Stats>
+void structures::ChunkedStack<T, Stats>::push(const T& data) {
+    if (top_chunk_ == nullptr || used_ == chunk_size_) {
+        Chunk* chunk = acquire();
+        chunk->below(top_chunk_);
+        top_chunk_ = chunk;
+        used_ = 0;
+    }
+
+    Stats::operation();
+    top_chunk_->contents()[used_] = data;
+    used_++;
+    size_++;
+    Stats::resized(size_);
+}
+
+//  retira dados da pilha
+
+template <typename T, typename Stats>
+T structures::ChunkedStack<T, Stats>::pop() {
+    if (empty())
+        throw std::out_of_range("Pilha atualmente vazia.");
+
+    Stats::operation();
+    used_--;
+    size_--;
+    T data = top_chunk_->contents()[used_];
+
+    if (used_ == 0 && top_chunk_->below() != nullptr) {
+        Chunk* empty_chunk = top_chunk_;
+        top_chunk_ = top_chunk_->below();
+        used_ = chunk_size_;
+        release(empty_chunk);
+    }
+    return data;
+}
+
+//  limpa a pilha, mantendo o bloco de baixo
+
+template <typename T, typename Stats>
+void structures::ChunkedStack<T, Stats>::clear() {
+    while (top_chunk_ != nullptr && top_chunk_->below() != nullptr) {
+        Chunk* empty_chunk = top_chunk_;
+        top_chunk_ = top_chunk_->below();
+        release(empty_chunk);
+    }
+    used_ = 0;
+    size_ = 0;
+}
+
+//  libera os blocos guardados para reuso
+
+template <typename T, typename Stats>
+void structures::ChunkedStack<T, Stats>::shrink() {
+    while (spare_ != nullptr) {
+        Chunk* below = spare_->below();
+        destroy(spare_);
+        spare_ = below;
+    }
+    spare_count_ = 0;
+}
+
+//  retorna o elemento do topo da pilha
+
+template <typename T, typename Stats>
+T& structures::ChunkedStack<T, Stats>::top() {
+    if (empty())
+        throw std::out_of_range("Pilha vazia.");
+
+    return top_chunk_->contents()[used_ - 1];
+}
+
+//  retorna o tamanho da pilha
+
+template <typename T, typename Stats>
+std::size_t structures::ChunkedStack<T, Stats>::size() const {
+    return size_;
+}
+
+//  retorna a quantidade de elementos em cada bloco
+
+template <typename T, typename Stats>
+std::size_t structures::ChunkedStack<T, Stats>::chunk_size() const {
+    return chunk_size_;
+}
+
+//  retorna quantos blocos vazios estão guardados para reuso
+
+template <typename T, typename Stats>
+std::size_t structures::ChunkedStack<T, Stats>::spare_chunks() const {
+    return spare_count_;
+}
+
+//  verifica se a pilha está vazia
+
+template <typename T, typename Stats>
+bool structures::ChunkedStack<T, Stats>::empty() const {
+    return size_ == 0;
+}
+
+//  retorna os contadores da política de estatísticas
+
+template <typename T, typename Stats>
+structures::StatsSnapshot structures::ChunkedStack<T, Stats>::stats() const {
+    return Stats::snapshot();
+}
+
+//  zera os contadores da política de estatísticas
+
+template <typename T, typename Stats>
+void structures::ChunkedStack<T, Stats>::reset_stats() {
+    Stats::reset();
+}
+
+//  retorna os bytes que a pilha ocupa no heap, blocos guardados incluídos
+
+template <typename T, typename Stats>
+std::size_t structures::ChunkedStack<T, Stats>::bytes_allocated() const {
+    return chunks_ * chunk_bytes();
+}
+
+//  retorna quantos dados cabem sem nova alocação
+
+template <typename T, typename Stats>
+std::size_t structures::ChunkedStack<T, Stats>::capacity() const {
+    return chunks_ * chunk_size_;
+}
+
+//  retorna o detalhamento da memória ocupada; cada bloco conta como um nodo
+
+template <typename T, typename Stats>
+structures::MemoryUsage
+structures::ChunkedStack<T, Stats>::memory_usage() const {
+    return detail::block_usage<T>(size_, capacity(), chunks_,
+                                  bytes_allocated());
+}
+
+//  repassa as alocações ao observador com o rótulo site
+//  exige a política ObservedStats
+
+template <typename T, typename Stats>
+void structures::ChunkedStack<T, Stats>::observe(
+        AllocationObserver* observer, const char* site) {
+    Stats::observe(observer, site);
+}
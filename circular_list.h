@@ -6,6 +6,10 @@
 #include <cstdint>
 #include <stdexcept>
 
+#include "./memory_usage.h"
+#include "./operation_stats.h"
+#include "./prefetch.h"
+
 namespace structures {
 
 /**
@@ -13,11 +17,12 @@ namespace structures {
  *             Organização de dados linear e dinâmica, similar a Lista Encadeada -
  *             Com a diferença que o último elemento aponta para o primeiro.
  *
- * @tparam     T     Parâmetro genérico de Template
+ * @tparam     T      Parâmetro genérico de Template
+ * @tparam     Stats  Política de estatísticas (NoStats ou OperationStats)
  */
 
-template<typename T>
-class CircularList {
+template<typename T, typename Stats = NoStats>
+class CircularList : private Stats {
  public:
     CircularList();
     ~CircularList();
@@ -43,6 +48,14 @@ class CircularList {
 
     std::size_t size() const;  // tamanho da lista
 
+    StatsSnapshot stats() const;  // contadores de estatísticas
+    void reset_stats();  // zera os contadores
+    std::size_t bytes_allocated() const;  // bytes no heap
+    std::size_t capacity() const;  // dados que cabem sem alocar
+    MemoryUsage memory_usage() const;  // detalhamento da memória
+    // repassa alocações a um observador (só com ObservedStats)
+    void observe(AllocationObserver* observer, const char* site);
+
  private:
     class Node {
      public:
@@ -75,9 +88,10 @@ class CircularList {
 /**
  *   Construtor padrão da classe CircularList.
  */
-template <typename T>
-CircularList<T>::CircularList() {
+template<typename T, typename Stats>
+CircularList<T, Stats>::CircularList() {
     head = new Node((T)0, nullptr);
+    Stats::allocated(sizeof(Node));
     head->next(head);
     size_ = 0;
 }
@@ -85,17 +99,18 @@ CircularList<T>::CircularList() {
 /**
  *   Destrutor padrão da classe CircularList.
  */
-template <typename T>
-CircularList<T>::~CircularList() {
+template<typename T, typename Stats>
+CircularList<T, Stats>::~CircularList() {
     clear();
+    Stats::released(sizeof(Node));
     delete head;
 }
 
 /**
  *   Faz uma limpeza da lista encadeada (CircularList).
  */
-template <typename T>
-void CircularList<T>::clear() {
+template<typename T, typename Stats>
+void CircularList<T, Stats>::clear() {
     while (!empty()) {
         pop_front();
     }
@@ -104,35 +119,42 @@ void CircularList<T>::clear() {
 /**
  *   Insere um elemento no fim da lista (CircularList).
  */
-template <typename T>
-void CircularList<T>::push_back(const T& data) {
+template<typename T, typename Stats>
+void CircularList<T, Stats>::push_back(const T& data) {
     if (empty())
         return push_front(data);
 
+    Stats::operation();
     Node *previous = head->next();
 
-    for (int i = 0; i < size_-1; ++i) {
+    for (std::size_t i = 0; i < size_-1; ++i) {
         previous = previous->next();
     }
+    Stats::traversed(size_ - 1);
 
     previous->next(new Node(data, head));
+    Stats::allocated(sizeof(Node));
     size_++;
+    Stats::resized(size_);
 }
 
 /**
  *   Insere um elemento no início da lista (CircularList).
  */
-template <typename T>
-void CircularList<T>::push_front(const T& data) {
+template<typename T, typename Stats>
+void CircularList<T, Stats>::push_front(const T& data) {
+      Stats::operation();
       head->next(new Node(data, head->next()));
+      Stats::allocated(sizeof(Node));
       size_++;
+      Stats::resized(size_);
 }
 
 /**
  *   Insere um elemento num determinado index da lista (CircularList).
  */
-template <typename T>
-void CircularList<T>::insert(const T& data, std::size_t index) {
+template<typename T, typename Stats>
+void CircularList<T, Stats>::insert(const T& data, std::size_t index) {
     if (index > size_)
         throw std::out_of_range("Índice inválido!");
 
@@ -142,31 +164,37 @@ void CircularList<T>::insert(const T& data, std::size_t index) {
     if (index == size_)
         return push_back(data);
 
+    Stats::operation();
     Node *anterior = head->next();
 
-    for (int i = 0; i < index-1; ++i) {
+    for (std::size_t i = 0; i < index-1; ++i) {
         anterior = anterior->next();
     }
+    Stats::traversed(index - 1);
 
     anterior->next(new Node(data, anterior->next()));
+    Stats::allocated(sizeof(Node));
     ++size_;
+    Stats::resized(size_);
 }
 
 /**
  *   Insere um elemento em ordem na lista (CircularList).
  */
-template <typename T>
-void CircularList<T>::insert_sorted(const T& data) {
+template<typename T, typename Stats>
+void CircularList<T, Stats>::insert_sorted(const T& data) {
     if (empty())
         return push_front(data);
 
     Node* atual = head->next();
-    int index = 0;
+    std::size_t index = 0;
 
     while (index < size_ && data > atual->data()) {
         atual = atual->next();
+        STRUCTURES_PREFETCH(atual->next());
         ++index;
     }
+    Stats::traversed(index);
 
     insert(data, index);
 }
@@ -174,20 +202,22 @@ void CircularList<T>::insert_sorted(const T& data) {
 /**
  *   Retorna o dado num determinado index, com checagem de limites (CircularList).
  */
-template <typename T>
-T& CircularList<T>::at(std::size_t index) {
+template<typename T, typename Stats>
+T& CircularList<T, Stats>::at(std::size_t index) {
     if (empty())
         throw std::out_of_range("Lista está vazia!");
 
     if (index > size_ - 1)
         throw std::out_of_range("Índice inválido!");
 
+    Stats::operation();
     Node* current = head->next();
     if (index == 0)
         return current->data();
 
-    for (int i = 0; i < index; i++)
+    for (std::size_t i = 0; i < index; i++)
       current = current->next();
+    Stats::traversed(index);
 
     return current->data();
 }
@@ -195,15 +225,17 @@ T& CircularList<T>::at(std::size_t index) {
 /**
  *   Retorna o dado num determinado index, sem chegagem de limites (CircularList).
  */
-template <typename T>
-const T& CircularList<T>::at(std::size_t index) const {
+template<typename T, typename Stats>
+const T& CircularList<T, Stats>::at(std::size_t index) const {
+    Stats::operation();
     Node* current = head->next();
 
     if (index == 0)
         return current->data();
 
-    for (int i = 0; i < index; i++)
+    for (std::size_t i = 0; i < index; i++)
       current = current->next();
+    Stats::traversed(index);
 
     return current->data();
 }
@@ -211,8 +243,8 @@ const T& CircularList<T>::at(std::size_t index) const {
 /**
  *   Retira um elemento num index da lista (CircularList).
  */
-template <typename T>
-T CircularList<T>::pop(std::size_t index) {
+template<typename T, typename Stats>
+T CircularList<T, Stats>::pop(std::size_t index) {
     if (index > size_ - 1)
         throw std::out_of_range("Índice inválido!");
 
@@ -224,16 +256,19 @@ T CircularList<T>::pop(std::size_t index) {
 
     Node *previous, *current;
     T return_;
+    Stats::operation();
     previous = head->next();
 
-    for (int i = 0; i < index-1; ++i) {
+    for (std::size_t i = 0; i < index-1; ++i) {
         previous = previous->next();
     }
+    Stats::traversed(index - 1);
 
     current = previous->next();
     return_ = current->data();
     previous->next(current->next());
     size_--;
+    Stats::released(sizeof(Node));
     delete current;
     return return_;
 }
@@ -241,8 +276,8 @@ T CircularList<T>::pop(std::size_t index) {
 /**
  *   Retira um elemento do fim da lista (CircularList).
  */
-template <typename T>
-T CircularList<T>::pop_back() {
+template<typename T, typename Stats>
+T CircularList<T, Stats>::pop_back() {
     if (empty())
         throw std::out_of_range("Lista está vazia!");
 
@@ -255,13 +290,15 @@ T CircularList<T>::pop_back() {
 /**
  *   Retira um elemento do início da lista (CircularList).
  */
-template <typename T>
-T CircularList<T>::pop_front() {
+template<typename T, typename Stats>
+T CircularList<T, Stats>::pop_front() {
     if (empty())
         throw std::out_of_range("Lista vazia!");
 
+    Stats::operation();
     T data = head->next()->data();
     Node *aux = head->next()->next();
+    Stats::released(sizeof(Node));
     delete head->next();
     head->next(aux);
     size_--;
@@ -271,8 +308,8 @@ T CircularList<T>::pop_front() {
 /**
  *   Remove um dado específico da lista (CircularList).
  */
-template <typename T>
-void CircularList<T>::remove(const T& data) {
+template<typename T, typename Stats>
+void CircularList<T, Stats>::remove(const T& data) {
     std::size_t test = find(data);
 
     if (test != size_)
@@ -282,16 +319,16 @@ void CircularList<T>::remove(const T& data) {
 /**
  *   Verifica se a lista está vazia (CircularList).
  */
-template<typename T>
-bool CircularList<T>::empty() const {
+template<typename T, typename Stats>
+bool CircularList<T, Stats>::empty() const {
     return size_ == 0;
 }
 
 /**
  *   Verifica se a lista contém determinado dado (CircularList).
  */
-template<typename T>
-bool CircularList<T>::contains(const T& data) const {
+template<typename T, typename Stats>
+bool CircularList<T, Stats>::contains(const T& data) const {
     if (find(data) != size_)
         return true;
     return false;
@@ -300,8 +337,8 @@ bool CircularList<T>::contains(const T& data) const {
 /**
  *   Retorna a posição de um dado na lista (CircularList).
  */
-template<typename T>
-std::size_t CircularList<T>::find(const T& data) const {
+template<typename T, typename Stats>
+std::size_t CircularList<T, Stats>::find(const T& data) const {
     if (empty())
         throw std::out_of_range("Lista está vazia!");
 
@@ -310,6 +347,7 @@ std::size_t CircularList<T>::find(const T& data) const {
     Node* current = head->next();
 
     for (i = 0; i < size_; i++) {
+        STRUCTURES_PREFETCH(current->next());
         if (current->data() == data) {
             index = i;
             break;
@@ -317,17 +355,70 @@ std::size_t CircularList<T>::find(const T& data) const {
         if (i != size_)
             current = current->next();
     }
+    Stats::operation();
+    Stats::traversed(i < size_ ? i + 1 : size_);
     return index;
 }
 
 /**
  *   Verifica e retorna o tamanho da lista encadeada (CircularList).
  */
-template<typename T>
-std::size_t CircularList<T>::size() const {
+template<typename T, typename Stats>
+std::size_t CircularList<T, Stats>::size() const {
     return size_;
 }
 
+/**
+ *   Retorna os contadores da política de estatísticas (CircularList).
+ */
+template<typename T, typename Stats>
+StatsSnapshot CircularList<T, Stats>::stats() const {
+    return Stats::snapshot();
+}
+
+/**
+ *   Zera os contadores da política de estatísticas (CircularList).
+ */
+template<typename T, typename Stats>
+void CircularList<T, Stats>::reset_stats() {
+    Stats::reset();
+}
+
+/**
+ *   Retorna os bytes que a lista ocupa no heap (CircularList).
+ */
+template<typename T, typename Stats>
+std::size_t CircularList<T, Stats>::bytes_allocated() const {
+    return (size_ + 1) * sizeof(Node);
+}
+
+/**
+ *   Retorna quantos dados cabem sem nova alocação (CircularList): cada
+ * dado novo aloca um nodo.
+ */
+template<typename T, typename Stats>
+std::size_t CircularList<T, Stats>::capacity() const {
+    return size_;
+}
+
+/**
+ *   Retorna o detalhamento da memória ocupada (CircularList).
+ */
+template<typename T, typename Stats>
+MemoryUsage CircularList<T, Stats>::memory_usage() const {
+    return detail::node_usage<T, Node>(size_, size_ + 1);
+}
+
+/**
+ *   Repassa as alocações ao observador com o rótulo site (CircularList);
+ * exige a política ObservedStats.
+ */
+template<typename T, typename Stats>
+void CircularList<T, Stats>::observe(AllocationObserver* observer,
+                                     const char* site) {
+    Stats::observe(observer, site);
+}
+
 }  // namespace structures
 
 #endif
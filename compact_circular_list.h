@@ -0,0 +1,430 @@
+// Copyright 2017 Letícia do Nascimento
+
+#ifndef STRUCTURES_COMPACT_CIRCULAR_LIST_H
+#define STRUCTURES_COMPACT_CIRCULAR_LIST_H
+
+#include <cstdint>
+#include <stdexcept>  // C++ exception
+
+#include "./index_node_pool.h"
+#include "./memory_usage.h"
+#include "./operation_stats.h"
+
+namespace structures {
+
+/**
+ * @brief      Lista Circular com a interface da CircularList, mas com os
+ *             nodos num IndexNodePool, ligados por índices de 32 bits. Guarda
+ *             só o último nodo, cujo próximo é o primeiro, então inserir nas
+ *             duas pontas é O(1) e não há nodo sentinela.
+ *
+ * @tparam     T      Parâmetro genérico de Template
+ * @tparam     Stats  Política de estatísticas; conta as trocas do vetor de
+ *                    nodos, não cada nodo
+ */
+template<typename T, typename Stats = NoStats>
+class CompactCircularList : private Stats {
+ public:
+    CompactCircularList();
+    explicit CompactCircularList(std::size_t capacity);
+    CompactCircularList(const CompactCircularList& other);
+    ~CompactCircularList();
+
+    CompactCircularList& operator=(const CompactCircularList& other);
+
+    void clear();
+    void push_back(const T& data);
+    void push_front(const T& data);
+    void insert(const T& data, std::size_t index);
+    void insert_sorted(const T& data);
+    T& at(std::size_t index);
+    const T& at(std::size_t index) const;
+    T pop(std::size_t index);
+    T pop_back();
+    T pop_front();
+    void remove(const T& data);
+    bool empty() const;
+    bool contains(const T& data) const;
+    std::size_t find(const T& data) const;
+    std::size_t size() const;
+    void compact();  // reordena os nodos na ordem da lista
+
+    StatsSnapshot stats() const;  // contadores de estatísticas
+    void reset_stats();  // zera os contadores
+    std::size_t bytes_allocated() const;  // bytes no heap
+    std::size_t capacity() const;  // dados que cabem sem alocar
+    MemoryUsage memory_usage() const;  // detalhamento da memória
+    // repassa alocações a um observador (só com ObservedStats)
+    void observe(AllocationObserver* observer, const char* site);
+
+ private:
+    struct Node {
+        T data;
+        NodeIndex next;
+    };
+
+    // nodo anterior à posição index (o último, para index 0)
+    NodeIndex before(std::size_t index) const {
+        NodeIndex it = tail_;
+        for (std::size_t i = 0; i < index; i++)
+            it = nodes_[it].next;
+        return it;
+    }
+
+    void link_after(NodeIndex previous, const T& data);  // insere após previous
+    T unlink_after(NodeIndex previous);  // retira o nodo após previous
+
+    // nodo livre do pool, avisando a política quando o vetor é trocado
+    NodeIndex allocate() {
+        std::size_t before = nodes_.bytes_allocated();
+        NodeIndex node = nodes_.allocate();
+        if (nodes_.bytes_allocated() != before) {
+            Stats::allocated(nodes_.bytes_allocated());
+            Stats::released(before);
+        }
+        return node;
+    }
+
+    IndexNodePool<Node> nodes_;
+    NodeIndex tail_{NIL_INDEX};  // último nodo; tail_.next é o primeiro
+    std::size_t size_{0u};
+};
+
+/**
+ *   Construtor padrão da classe CompactCircularList.
+ */
+template<typename T, typename Stats>
+CompactCircularList<T, Stats>::CompactCircularList() :
+    nodes_()
+{
+    Stats::allocated(nodes_.bytes_allocated());
+}
+
+/**
+ *   Construtor da classe CompactCircularList com espaço inicial para
+ * capacity nodos.
+ */
+template<typename T, typename Stats>
+CompactCircularList<T, Stats>::CompactCircularList(std::size_t capacity) :
+    nodes_(capacity)
+{
+    Stats::allocated(nodes_.bytes_allocated());
+}
+
+/**
+ *   Construtor de cópia da classe CompactCircularList: copia o pool inteiro, e
+ * os índices continuam válidos. A cópia começa com estatísticas novas.
+ */
+template<typename T, typename Stats>
+CompactCircularList<T, Stats>::CompactCircularList(
+        const CompactCircularList& other) :
+    Stats(),
+    nodes_(other.nodes_),
+    tail_{other.tail_},
+    size_{other.size_}
+{
+    Stats::allocated(nodes_.bytes_allocated());
+}
+
+/**
+ *   Destrutor da classe CompactCircularList.
+ */
+template<typename T, typename Stats>
+CompactCircularList<T, Stats>::~CompactCircularList() {
+    Stats::released(nodes_.bytes_allocated());
+}
+
+/**
+ *   Atribuição de cópia da classe CompactCircularList; mantém as estatísticas.
+ */
+template<typename T, typename Stats>
+CompactCircularList<T, Stats>& CompactCircularList<T, Stats>::operator=(
+        const CompactCircularList& other) {
+    if (this != &other) {
+        std::size_t before = nodes_.bytes_allocated();
+        nodes_ = other.nodes_;
+        tail_ = other.tail_;
+        size_ = other.size_;
+        Stats::allocated(nodes_.bytes_allocated());
+        Stats::released(before);
+    }
+    return *this;
+}
+
+/**
+ *   Insere data logo após previous; numa lista vazia, cria o anel de um nodo
+ * (CompactCircularList).
+ */
+template<typename T, typename Stats>
+void CompactCircularList<T, Stats>::link_after(
+        NodeIndex previous, const T& data) {
+    NodeIndex node = allocate();
+    nodes_[node].data = data;
+    if (previous == NIL_INDEX) {
+        nodes_[node].next = node;
+        tail_ = node;
+    } else {
+        nodes_[node].next = nodes_[previous].next;
+        nodes_[previous].next = node;
+    }
+    size_++;
+}
+
+/**
+ *   Retira o nodo após previous e retorna seu dado (CompactCircularList).
+ */
+template<typename T, typename Stats>
+T CompactCircularList<T, Stats>::unlink_after(NodeIndex previous) {
+    NodeIndex node = nodes_[previous].next;
+    T data = nodes_[node].data;
+    if (node == previous) {
+        tail_ = NIL_INDEX;
+    } else {
+        nodes_[previous].next = nodes_[node].next;
+        if (node == tail_)
+            tail_ = previous;
+    }
+    nodes_.release(node);
+    size_--;
+    return data;
+}
+
+/**
+ *   Faz uma limpeza da lista (CompactCircularList), mantendo o pool.
+ */
+template<typename T, typename Stats>
+void CompactCircularList<T, Stats>::clear() {
+    nodes_.clear();
+    tail_ = NIL_INDEX;
+    size_ = 0;
+}
+
+/**
+ *   Insere um elemento no fim da lista (CompactCircularList).
+ */
+template<typename T, typename Stats>
+void CompactCircularList<T, Stats>::push_back(const T& data) {
+    link_after(tail_, data);
+    tail_ = nodes_[tail_].next;
+}
+
+/**
+ *   Insere um elemento no início da lista (CompactCircularList).
+ */
+template<typename T, typename Stats>
+void CompactCircularList<T, Stats>::push_front(const T& data) {
+    link_after(tail_, data);
+}
+
+/**
+ *   Insere um elemento num determinado index da lista (CompactCircularList).
+ */
+template<typename T, typename Stats>
+void CompactCircularList<T, Stats>::insert(const T& data, std::size_t index) {
+    if (index > size_)
+        throw std::out_of_range("Índice inválido!");
+    if (index == size_)
+        return push_back(data);
+    link_after(before(index), data);
+}
+
+/**
+ *   Insere um elemento em ordem na lista (CompactCircularList).
+ */
+template<typename T, typename Stats>
+void CompactCircularList<T, Stats>::insert_sorted(const T& data) {
+    NodeIndex previous = tail_;
+    std::size_t index = 0;
+    while (index < size_ && data > nodes_[nodes_[previous].next].data) {
+        previous = nodes_[previous].next;
+        index++;
+    }
+    if (index == size_)
+        push_back(data);
+    else
+        link_after(previous, data);
+}
+
+/**
+ *   Retorna o dado num determinado index (CompactCircularList).
+ */
+template<typename T, typename Stats>
+T& CompactCircularList<T, Stats>::at(std::size_t index) {
+    if (empty())
+        throw std::out_of_range("Lista está vazia!");
+    if (index >= size_)
+        throw std::out_of_range("Índice inválido!");
+    return nodes_[nodes_[before(index)].next].data;
+}
+
+/**
+ *   Retorna o dado num determinado index (CompactCircularList) - versão
+ * const.
+ */
+template<typename T, typename Stats>
+const T& CompactCircularList<T, Stats>::at(std::size_t index) const {
+    if (empty())
+        throw std::out_of_range("Lista está vazia!");
+    if (index >= size_)
+        throw std::out_of_range("Índice inválido!");
+    return nodes_[nodes_[before(index)].next].data;
+}
+
+/**
+ *   Retira um elemento num index da lista (CompactCircularList).
+ */
+template<typename T, typename Stats>
+T CompactCircularList<T, Stats>::pop(std::size_t index) {
+    if (empty())
+        throw std::out_of_range("Lista vazia!");
+    if (index >= size_)
+        throw std::out_of_range("Índice inválido!");
+    return unlink_after(before(index));
+}
+
+/**
+ *   Retira um elemento do fim da lista (CompactCircularList).
+ */
+template<typename T, typename Stats>
+T CompactCircularList<T, Stats>::pop_back() {
+    if (empty())
+        throw std::out_of_range("Lista está vazia!");
+    return pop(size_ - 1);
+}
+
+/**
+ *   Retira um elemento do início da lista (CompactCircularList).
+ */
+template<typename T, typename Stats>
+T CompactCircularList<T, Stats>::pop_front() {
+    if (empty())
+        throw std::out_of_range("Lista vazia!");
+    return unlink_after(tail_);
+}
+
+/**
+ *   Remove um dado específico da lista (CompactCircularList).
+ */
+template<typename T, typename Stats>
+void CompactCircularList<T, Stats>::remove(const T& data) {
+    std::size_t index = find(data);
+    if (index != size_)
+        pop(index);
+}
+
+/**
+ *   Verifica se a lista está vazia (CompactCircularList).
+ */
+template<typename T, typename Stats>
+bool CompactCircularList<T, Stats>::empty() const {
+    return size_ == 0;
+}
+
+/**
+ *   Verifica se a lista contém determinado dado (CompactCircularList).
+ */
+template<typename T, typename Stats>
+bool CompactCircularList<T, Stats>::contains(const T& data) const {
+    return find(data) != size_;
+}
+
+/**
+ *   Retorna a posição de um dado na lista, ou size() se não encontrado
+ * (CompactCircularList).
+ */
+template<typename T, typename Stats>
+std::size_t CompactCircularList<T, Stats>::find(const T& data) const {
+    if (empty())
+        return 0;
+
+    NodeIndex current = nodes_[tail_].next;
+    std::size_t index = 0;
+    while (index < size_ && !(nodes_[current].data == data)) {
+        current = nodes_[current].next;
+        index++;
+    }
+    return index;
+}
+
+/**
+ *   Retorna o tamanho da lista (CompactCircularList).
+ */
+template<typename T, typename Stats>
+std::size_t CompactCircularList<T, Stats>::size() const {
+    return size_;
+}
+
+/**
+ *   Copia os nodos para um pool novo, na ordem da lista e sem buracos
+ * (CompactCircularList); o primeiro fica no índice 0.
+ */
+template<typename T, typename Stats>
+void CompactCircularList<T, Stats>::compact() {
+    IndexNodePool<Node> nodes(size_);
+    NodeIndex current = empty() ? NIL_INDEX : nodes_[tail_].next;
+    for (std::size_t i = 0; i < size_; i++) {
+        NodeIndex node = nodes.allocate();  // o i-ésimo nodo de um pool novo
+        nodes[node].data = nodes_[current].data;
+        nodes[node].next = i + 1 < size_ ? node + 1 : 0;
+        current = nodes_[current].next;
+    }
+    Stats::allocated(nodes.bytes_allocated());
+    Stats::released(nodes_.bytes_allocated());
+    nodes_.swap(nodes);
+    tail_ = size_ > 0 ? static_cast<NodeIndex>(size_ - 1) : NIL_INDEX;
+}
+
+/**
+ *   Retorna os contadores da política de estatísticas (CompactCircularList).
+ */
+template<typename T, typename Stats>
+StatsSnapshot CompactCircularList<T, Stats>::stats() const {
+    return Stats::snapshot();
+}
+
+/**
+ *   Zera os contadores da política de estatísticas (CompactCircularList).
+ */
+template<typename T, typename Stats>
+void CompactCircularList<T, Stats>::reset_stats() {
+    Stats::reset();
+}
+
+/**
+ *   Retorna os bytes que a lista ocupa no heap: o vetor do pool inteiro
+ * (CompactCircularList).
+ */
+template<typename T, typename Stats>
+std::size_t CompactCircularList<T, Stats>::bytes_allocated() const {
+    return nodes_.bytes_allocated();
+}
+
+/**
+ *   Retorna quantos dados cabem antes de o pool crescer (CompactCircularList).
+ */
+template<typename T, typename Stats>
+std::size_t CompactCircularList<T, Stats>::capacity() const {
+    return nodes_.capacity();
+}
+
+/**
+ *   Retorna o detalhamento da memória ocupada (CompactCircularList).
+ */
+template<typename T, typename Stats>
+MemoryUsage CompactCircularList<T, Stats>::memory_usage() const {
+    return detail::pool_usage<T, Node>(size_, nodes_.capacity());
+}
+
+/**
+ *   Repassa as alocações ao observador com o rótulo site (CompactCircularList);
+ * exige a política ObservedStats.
+ */
+template<typename T, typename Stats>
+void CompactCircularList<T, Stats>::observe(AllocationObserver* observer,
+                                                   const char* site) {
+    Stats::observe(observer, site);
+}
+
+}  // namespace structures
+
+#endif
@@ -0,0 +1,458 @@
+// Copyright 2017 Letícia do Nascimento
+
+#ifndef STRUCTURES_COMPACT_DOUBLY_LINKED_LIST_H
+#define STRUCTURES_COMPACT_DOUBLY_LINKED_LIST_H
+
+#include <cstdint>
+#include <stdexcept>  // C++ exception
+
+#include "./index_node_pool.h"
+#include "./memory_usage.h"
+#include "./operation_stats.h"
+
+namespace structures {
+
+/**
+ * @brief      Lista Duplamente Encadeada com a interface da DoublyLinkedList,
+ *             mas com os nodos num IndexNodePool, ligados por índices de 32
+ *             bits: 8 bytes de elos por nodo em vez de 16, sem cabeçalho de
+ *             malloc. Acessos por posição partem da ponta mais próxima.
+ *
+ * @tparam     T      Parâmetro genérico de Template
+ * @tparam     Stats  Política de estatísticas; conta as trocas do vetor de
+ *                    nodos, não cada nodo
+ */
+template<typename T, typename Stats = NoStats>
+class CompactDoublyLinkedList : private Stats {
+ public:
+    CompactDoublyLinkedList();
+    explicit CompactDoublyLinkedList(std::size_t capacity);
+    CompactDoublyLinkedList(const CompactDoublyLinkedList& other);
+    ~CompactDoublyLinkedList();
+
+    CompactDoublyLinkedList& operator=(const CompactDoublyLinkedList& other);
+
+    void clear();
+    void push_back(const T& data);
+    void push_front(const T& data);
+    void insert(const T& data, std::size_t index);
+    void insert_sorted(const T& data);
+    T& at(std::size_t index);
+    const T& at(std::size_t index) const;
+    T pop(std::size_t index);
+    T pop_back();
+    T pop_front();
+    void remove(const T& data);
+    bool empty() const;
+    bool contains(const T& data) const;
+    std::size_t find(const T& data) const;
+    std::size_t size() const;
+    void compact();  // reordena os nodos na ordem da lista
+
+    StatsSnapshot stats() const;  // contadores de estatísticas
+    void reset_stats();  // zera os contadores
+    std::size_t bytes_allocated() const;  // bytes no heap
+    std::size_t capacity() const;  // dados que cabem sem alocar
+    MemoryUsage memory_usage() const;  // detalhamento da memória
+    // repassa alocações a um observador (só com ObservedStats)
+    void observe(AllocationObserver* observer, const char* site);
+
+ private:
+    struct Node {
+        T data;
+        NodeIndex prev;
+        NodeIndex next;
+    };
+
+    // nodo na posição index, partindo da ponta mais próxima
+    NodeIndex walk(std::size_t index) const {
+        NodeIndex it;
+        if (index < size_ / 2) {
+            it = head_;
+            for (std::size_t i = 0; i < index; i++)
+                it = nodes_[it].next;
+        } else {
+            it = tail_;
+            for (std::size_t i = size_ - 1; i > index; i--)
+                it = nodes_[it].prev;
+        }
+        return it;
+    }
+
+    void link(NodeIndex node, NodeIndex prev, NodeIndex next);  // entre prev e next
+    T unlink(NodeIndex node);  // retira e libera o nodo
+
+    // nodo livre do pool, avisando a política quando o vetor é trocado
+    NodeIndex allocate() {
+        std::size_t before = nodes_.bytes_allocated();
+        NodeIndex node = nodes_.allocate();
+        if (nodes_.bytes_allocated() != before) {
+            Stats::allocated(nodes_.bytes_allocated());
+            Stats::released(before);
+        }
+        return node;
+    }
+
+    IndexNodePool<Node> nodes_;
+    NodeIndex head_{NIL_INDEX};
+    NodeIndex tail_{NIL_INDEX};
+    std::size_t size_{0u};
+};
+
+/**
+ *   Construtor padrão da classe CompactDoublyLinkedList.
+ */
+template<typename T, typename Stats>
+CompactDoublyLinkedList<T, Stats>::CompactDoublyLinkedList() :
+    nodes_()
+{
+    Stats::allocated(nodes_.bytes_allocated());
+}
+
+/**
+ *   Construtor da classe CompactDoublyLinkedList com espaço inicial para
+ * capacity nodos.
+ */
+template<typename T, typename Stats>
+CompactDoublyLinkedList<T, Stats>::CompactDoublyLinkedList(
+        std::size_t capacity) :
+    nodes_(capacity)
+{
+    Stats::allocated(nodes_.bytes_allocated());
+}
+
+/**
+ *   Construtor de cópia da classe CompactDoublyLinkedList: copia o pool
+ * inteiro, e os índices continuam válidos. A cópia começa com estatísticas
+ * novas.
+ */
+template<typename T, typename Stats>
+CompactDoublyLinkedList<T, Stats>::CompactDoublyLinkedList(
+        const CompactDoublyLinkedList& other) :
+    Stats(),
+    nodes_(other.nodes_),
+    head_{other.head_},
+    tail_{other.tail_},
+    size_{other.size_}
+{
+    Stats::allocated(nodes_.bytes_allocated());
+}
+
+/**
+ *   Destrutor da classe CompactDoublyLinkedList.
+ */
+template<typename T, typename Stats>
+CompactDoublyLinkedList<T, Stats>::~CompactDoublyLinkedList() {
+    Stats::released(nodes_.bytes_allocated());
+}
+
+/**
+ *   Atribuição de cópia da classe CompactDoublyLinkedList; mantém as
+ * estatísticas.
+ */
+template<typename T, typename Stats>
+CompactDoublyLinkedList<T, Stats>& CompactDoublyLinkedList<T, Stats>::operator=(
+        const CompactDoublyLinkedList& other) {
+    if (this != &other) {
+        std::size_t before = nodes_.bytes_allocated();
+        nodes_ = other.nodes_;
+        head_ = other.head_;
+        tail_ = other.tail_;
+        size_ = other.size_;
+        Stats::allocated(nodes_.bytes_allocated());
+        Stats::released(before);
+    }
+    return *this;
+}
+
+/**
+ *   Liga node entre prev e next, que podem ser NIL_INDEX nas pontas
+ * (CompactDoublyLinkedList).
+ */
+template<typename T, typename Stats>
+void CompactDoublyLinkedList<T, Stats>::link(NodeIndex node, NodeIndex prev,
+                                      NodeIndex next) {
+    nodes_[node].prev = prev;
+    nodes_[node].next = next;
+    if (prev == NIL_INDEX)
+        head_ = node;
+    else
+        nodes_[prev].next = node;
+    if (next == NIL_INDEX)
+        tail_ = node;
+    else
+        nodes_[next].prev = node;
+    size_++;
+}
+
+/**
+ *   Desliga node dos vizinhos, devolve-o ao pool e retorna seu dado
+ * (CompactDoublyLinkedList).
+ */
+template<typename T, typename Stats>
+T CompactDoublyLinkedList<T, Stats>::unlink(NodeIndex node) {
+    NodeIndex prev = nodes_[node].prev;
+    NodeIndex next = nodes_[node].next;
+    if (prev == NIL_INDEX)
+        head_ = next;
+    else
+        nodes_[prev].next = next;
+    if (next == NIL_INDEX)
+        tail_ = prev;
+    else
+        nodes_[next].prev = prev;
+
+    T data = nodes_[node].data;
+    nodes_.release(node);
+    size_--;
+    return data;
+}
+
+/**
+ *   Faz uma limpeza da lista (CompactDoublyLinkedList), mantendo o pool.
+ */
+template<typename T, typename Stats>
+void CompactDoublyLinkedList<T, Stats>::clear() {
+    nodes_.clear();
+    head_ = tail_ = NIL_INDEX;
+    size_ = 0;
+}
+
+/**
+ *   Insere um elemento no fim da lista (CompactDoublyLinkedList).
+ */
+template<typename T, typename Stats>
+void CompactDoublyLinkedList<T, Stats>::push_back(const T& data) {
+    NodeIndex node = allocate();
+    nodes_[node].data = data;
+    link(node, tail_, NIL_INDEX);
+}
+
+/**
+ *   Insere um elemento no início da lista (CompactDoublyLinkedList).
+ */
+template<typename T, typename Stats>
+void CompactDoublyLinkedList<T, Stats>::push_front(const T& data) {
+    NodeIndex node = allocate();
+    nodes_[node].data = data;
+    link(node, NIL_INDEX, head_);
+}
+
+/**
+ *   Insere um elemento num determinado index da lista
+ * (CompactDoublyLinkedList).
+ */
+template<typename T, typename Stats>
+void CompactDoublyLinkedList<T, Stats>::insert(
+        const T& data, std::size_t index) {
+    if (index > size_)
+        throw std::out_of_range("Índice inválido");
+    if (index == size_)
+        return push_back(data);
+
+    NodeIndex next = walk(index);
+    NodeIndex node = allocate();
+    nodes_[node].data = data;
+    link(node, nodes_[next].prev, next);
+}
+
+/**
+ *   Insere um elemento em ordem na lista (CompactDoublyLinkedList).
+ */
+template<typename T, typename Stats>
+void CompactDoublyLinkedList<T, Stats>::insert_sorted(const T& data) {
+    NodeIndex current = head_;
+    while (current != NIL_INDEX && data > nodes_[current].data)
+        current = nodes_[current].next;
+
+    NodeIndex node = allocate();
+    nodes_[node].data = data;
+    if (current == NIL_INDEX)
+        link(node, tail_, NIL_INDEX);
+    else
+        link(node, nodes_[current].prev, current);
+}
+
+/**
+ *   Retorna o dado num determinado index (CompactDoublyLinkedList).
+ */
+template<typename T, typename Stats>
+T& CompactDoublyLinkedList<T, Stats>::at(std::size_t index) {
+    if (index >= size_)
+        throw std::out_of_range("Índice inválido!");
+    return nodes_[walk(index)].data;
+}
+
+/**
+ *   Retorna o dado num determinado index (CompactDoublyLinkedList) - versão
+ * const.
+ */
+template<typename T, typename Stats>
+const T& CompactDoublyLinkedList<T, Stats>::at(std::size_t index) const {
+    if (index >= size_)
+        throw std::out_of_range("Índice inválido!");
+    return nodes_[walk(index)].data;
+}
+
+/**
+ *   Retira um elemento num index da lista (CompactDoublyLinkedList).
+ */
+template<typename T, typename Stats>
+T CompactDoublyLinkedList<T, Stats>::pop(std::size_t index) {
+    if (empty())
+        throw std::out_of_range("Lista vazia!");
+    if (index >= size_)
+        throw std::out_of_range("Índice inválido!");
+    return unlink(walk(index));
+}
+
+/**
+ *   Retira um elemento do fim da lista (CompactDoublyLinkedList).
+ */
+template<typename T, typename Stats>
+T CompactDoublyLinkedList<T, Stats>::pop_back() {
+    if (empty())
+        throw std::out_of_range("Lista está vazia!");
+    return unlink(tail_);
+}
+
+/**
+ *   Retira um elemento do início da lista (CompactDoublyLinkedList).
+ */
+template<typename T, typename Stats>
+T CompactDoublyLinkedList<T, Stats>::pop_front() {
+    if (empty())
+        throw std::out_of_range("Lista vazia!");
+    return unlink(head_);
+}
+
+/**
+ *   Remove um dado específico da lista (CompactDoublyLinkedList).
+ */
+template<typename T, typename Stats>
+void CompactDoublyLinkedList<T, Stats>::remove(const T& data) {
+    NodeIndex current = head_;
+    while (current != NIL_INDEX && !(nodes_[current].data == data))
+        current = nodes_[current].next;
+    if (current != NIL_INDEX)
+        unlink(current);
+}
+
+/**
+ *   Verifica se a lista está vazia (CompactDoublyLinkedList).
+ */
+template<typename T, typename Stats>
+bool CompactDoublyLinkedList<T, Stats>::empty() const {
+    return size_ == 0;
+}
+
+/**
+ *   Verifica se a lista contém determinado dado (CompactDoublyLinkedList).
+ */
+template<typename T, typename Stats>
+bool CompactDoublyLinkedList<T, Stats>::contains(const T& data) const {
+    return find(data) != size_;
+}
+
+/**
+ *   Retorna a posição de um dado na lista, ou size() se não encontrado
+ * (CompactDoublyLinkedList).
+ */
+template<typename T, typename Stats>
+std::size_t CompactDoublyLinkedList<T, Stats>::find(const T& data) const {
+    NodeIndex current = head_;
+    std::size_t index = 0;
+    while (index < size_ && !(nodes_[current].data == data)) {
+        current = nodes_[current].next;
+        index++;
+    }
+    return index;
+}
+
+/**
+ *   Retorna o tamanho da lista (CompactDoublyLinkedList).
+ */
+template<typename T, typename Stats>
+std::size_t CompactDoublyLinkedList<T, Stats>::size() const {
+    return size_;
+}
+
+/**
+ *   Copia os nodos para um pool novo, na ordem da lista e sem buracos
+ * (CompactDoublyLinkedList); percursos nos dois sentidos passam a ler o
+ * vetor em sequência.
+ */
+template<typename T, typename Stats>
+void CompactDoublyLinkedList<T, Stats>::compact() {
+    IndexNodePool<Node> nodes(size_);
+    NodeIndex current = head_;
+    for (std::size_t i = 0; i < size_; i++) {
+        NodeIndex node = nodes.allocate();  // o i-ésimo nodo de um pool novo
+        nodes[node].data = nodes_[current].data;
+        nodes[node].prev = i > 0 ? node - 1 : NIL_INDEX;
+        nodes[node].next = i + 1 < size_ ? node + 1 : NIL_INDEX;
+        current = nodes_[current].next;
+    }
+    Stats::allocated(nodes.bytes_allocated());
+    Stats::released(nodes_.bytes_allocated());
+    nodes_.swap(nodes);
+    head_ = size_ > 0 ? 0 : NIL_INDEX;
+    tail_ = size_ > 0 ? static_cast<NodeIndex>(size_ - 1) : NIL_INDEX;
+}
+
+/**
+ *   Retorna os contadores da política de estatísticas
+ * (CompactDoublyLinkedList).
+ */
+template<typename T, typename Stats>
+StatsSnapshot CompactDoublyLinkedList<T, Stats>::stats() const {
+    return Stats::snapshot();
+}
+
+/**
+ *   Zera os contadores da política de estatísticas (CompactDoublyLinkedList).
+ */
+template<typename T, typename Stats>
+void CompactDoublyLinkedList<T, Stats>::reset_stats() {
+    Stats::reset();
+}
+
+/**
+ *   Retorna os bytes que a lista ocupa no heap: o vetor do pool inteiro
+ * (CompactDoublyLinkedList).
+ */
+template<typename T, typename Stats>
+std::size_t CompactDoublyLinkedList<T, Stats>::bytes_allocated() const {
+    return nodes_.bytes_allocated();
+}
+
+/**
+ *   Retorna quantos dados cabem antes de o pool crescer
+ * (CompactDoublyLinkedList).
+ */
+template<typename T, typename Stats>
+std::size_t CompactDoublyLinkedList<T, Stats>::capacity() const {
+    return nodes_.capacity();
+}
+
+/**
+ *   Retorna o detalhamento da memória ocupada (CompactDoublyLinkedList).
+ */
+template<typename T, typename Stats>
+MemoryUsage CompactDoublyLinkedList<T, Stats>::memory_usage() const {
+    return detail::pool_usage<T, Node>(size_, nodes_.capacity());
+}
+
+/**
+ *   Repassa as alocações ao observador com o rótulo site
+ * (CompactDoublyLinkedList); exige a política ObservedStats.
+ */
+template<typename T, typename Stats>
+void CompactDoublyLinkedList<T, Stats>::observe(AllocationObserver* observer,
+                                                       const char* site) {
+    Stats::observe(observer, site);
+}
+
+}  // namespace structures
+
+#endif
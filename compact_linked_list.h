@@ -0,0 +1,423 @@
+// Copyright 2017 Letícia do Nascimento
+
+#ifndef STRUCTURES_COMPACT_LINKED_LIST_H
+#define STRUCTURES_COMPACT_LINKED_LIST_H
+
+#include <cstdint>
+#include <stdexcept>  // C++ exception
+
+#include "./index_node_pool.h"
+#include "./memory_usage.h"
+#include "./operation_stats.h"
+
+namespace structures {
+
+/**
+ * @brief      Lista Encadeada com a interface da LinkedList, mas com os nodos
+ *             num IndexNodePool, ligados por índices de 32 bits em vez de
+ *             ponteiros. Cada nodo gasta 4 bytes de elo e nenhum cabeçalho de
+ *             malloc, os nodos ficam próximos na memória, e a lista inteira
+ *             pode ser copiada ou gravada como um bloco.
+ *
+ * @tparam     T      Parâmetro genérico de Template
+ * @tparam     Stats  Política de estatísticas; conta as trocas do vetor de
+ *                    nodos, não cada nodo
+ */
+template<typename T, typename Stats = NoStats>
+class CompactLinkedList : private Stats {
+ public:
+    CompactLinkedList();
+    explicit CompactLinkedList(std::size_t capacity);
+    CompactLinkedList(const CompactLinkedList& other);
+    ~CompactLinkedList();
+
+    CompactLinkedList& operator=(const CompactLinkedList& other);
+
+    void clear();
+    void push_back(const T& data);
+    void push_front(const T& data);
+    void insert(const T& data, std::size_t index);
+    void insert_sorted(const T& data);
+    T& at(std::size_t index);
+    const T& at(std::size_t index) const;
+    T pop(std::size_t index);
+    T pop_back();
+    T pop_front();
+    void remove(const T& data);
+    bool empty() const;
+    bool contains(const T& data) const;
+    std::size_t find(const T& data) const;
+    std::size_t size() const;
+    void compact();  // reordena os nodos na ordem da lista
+
+    StatsSnapshot stats() const;  // contadores de estatísticas
+    void reset_stats();  // zera os contadores
+    std::size_t bytes_allocated() const;  // bytes no heap
+    std::size_t capacity() const;  // dados que cabem sem alocar
+    MemoryUsage memory_usage() const;  // detalhamento da memória
+    // repassa alocações a um observador (só com ObservedStats)
+    void observe(AllocationObserver* observer, const char* site);
+
+ private:
+    struct Node {
+        T data;
+        NodeIndex next;
+    };
+
+    // nodo na posição index, a partir da cabeça
+    NodeIndex walk(std::size_t index) const {
+        NodeIndex it = head_;
+        for (std::size_t i = 0; i < index; i++)
+            it = nodes_[it].next;
+        return it;
+    }
+
+    NodeIndex make(const T& data, NodeIndex next) {
+        NodeIndex node = allocate();
+        nodes_[node].data = data;
+        nodes_[node].next = next;
+        return node;
+    }
+
+    // nodo livre do pool, avisando a política quando o vetor é trocado
+    NodeIndex allocate() {
+        std::size_t before = nodes_.bytes_allocated();
+        NodeIndex node = nodes_.allocate();
+        if (nodes_.bytes_allocated() != before) {
+            Stats::allocated(nodes_.bytes_allocated());
+            Stats::released(before);
+        }
+        return node;
+    }
+
+    IndexNodePool<Node> nodes_;
+    NodeIndex head_{NIL_INDEX};
+    NodeIndex tail_{NIL_INDEX};
+    std::size_t size_{0u};
+};
+
+/**
+ *   Construtor padrão da classe CompactLinkedList.
+ */
+template<typename T, typename Stats>
+CompactLinkedList<T, Stats>::CompactLinkedList() :
+    nodes_()
+{
+    Stats::allocated(nodes_.bytes_allocated());
+}
+
+/**
+ *   Construtor da classe CompactLinkedList com espaço inicial para capacity
+ * nodos.
+ */
+template<typename T, typename Stats>
+CompactLinkedList<T, Stats>::CompactLinkedList(std::size_t capacity) :
+    nodes_(capacity)
+{
+    Stats::allocated(nodes_.bytes_allocated());
+}
+
+/**
+ *   Construtor de cópia da classe CompactLinkedList: copia o pool inteiro, e os
+ * índices continuam válidos. A cópia começa com estatísticas novas.
+ */
+template<typename T, typename Stats>
+CompactLinkedList<T, Stats>::CompactLinkedList(const CompactLinkedList& other) :
+    Stats(),
+    nodes_(other.nodes_),
+    head_{other.head_},
+    tail_{other.tail_},
+    size_{other.size_}
+{
+    Stats::allocated(nodes_.bytes_allocated());
+}
+
+/**
+ *   Destrutor da classe CompactLinkedList.
+ */
+template<typename T, typename Stats>
+CompactLinkedList<T, Stats>::~CompactLinkedList() {
+    Stats::released(nodes_.bytes_allocated());
+}
+
+/**
+ *   Atribuição de cópia da classe CompactLinkedList; mantém as estatísticas.
+ */
+template<typename T, typename Stats>
+CompactLinkedList<T, Stats>& CompactLinkedList<T, Stats>::operator=(
+        const CompactLinkedList& other) {
+    if (this != &other) {
+        std::size_t before = nodes_.bytes_allocated();
+        nodes_ = other.nodes_;
+        head_ = other.head_;
+        tail_ = other.tail_;
+        size_ = other.size_;
+        Stats::allocated(nodes_.bytes_allocated());
+        Stats::released(before);
+    }
+    return *this;
+}
+
+/**
+ *   Faz uma limpeza da lista (CompactLinkedList), mantendo o pool.
+ */
+template<typename T, typename Stats>
+void CompactLinkedList<T, Stats>::clear() {
+    nodes_.clear();
+    head_ = tail_ = NIL_INDEX;
+    size_ = 0;
+}
+
+/**
+ *   Insere um elemento no fim da lista (CompactLinkedList).
+ */
+template<typename T, typename Stats>
+void CompactLinkedList<T, Stats>::push_back(const T& data) {
+    NodeIndex node = make(data, NIL_INDEX);
+    if (empty())
+        head_ = node;
+    else
+        nodes_[tail_].next = node;
+    tail_ = node;
+    size_++;
+}
+
+/**
+ *   Insere um elemento no início da lista (CompactLinkedList).
+ */
+template<typename T, typename Stats>
+void CompactLinkedList<T, Stats>::push_front(const T& data) {
+    head_ = make(data, head_);
+    if (empty())
+        tail_ = head_;
+    size_++;
+}
+
+/**
+ *   Insere um elemento num determinado index da lista (CompactLinkedList).
+ */
+template<typename T, typename Stats>
+void CompactLinkedList<T, Stats>::insert(const T& data, std::size_t index) {
+    if (index > size_)
+        throw std::out_of_range("Índice inválido!");
+    if (index == 0)
+        return push_front(data);
+    if (index == size_)
+        return push_back(data);
+
+    NodeIndex previous = walk(index - 1);
+    NodeIndex node = make(data, nodes_[previous].next);
+    nodes_[previous].next = node;
+    size_++;
+}
+
+/**
+ *   Insere um elemento em ordem na lista (CompactLinkedList).
+ */
+template<typename T, typename Stats>
+void CompactLinkedList<T, Stats>::insert_sorted(const T& data) {
+    NodeIndex current = head_;
+    std::size_t index = 0;
+    while (index < size_ && data > nodes_[current].data) {
+        current = nodes_[current].next;
+        index++;
+    }
+    insert(data, index);
+}
+
+/**
+ *   Retorna o dado num determinado index (CompactLinkedList).
+ */
+template<typename T, typename Stats>
+T& CompactLinkedList<T, Stats>::at(std::size_t index) {
+    if (index >= size_)
+        throw std::out_of_range("Índice inválido!");
+    return nodes_[walk(index)].data;
+}
+
+/**
+ *   Retorna o dado num determinado index (CompactLinkedList) - versão const.
+ */
+template<typename T, typename Stats>
+const T& CompactLinkedList<T, Stats>::at(std::size_t index) const {
+    if (index >= size_)
+        throw std::out_of_range("Índice inválido!");
+    return nodes_[walk(index)].data;
+}
+
+/**
+ *   Retira um elemento num index da lista (CompactLinkedList).
+ */
+template<typename T, typename Stats>
+T CompactLinkedList<T, Stats>::pop(std::size_t index) {
+    if (empty())
+        throw std::out_of_range("Lista vazia!");
+    if (index >= size_)
+        throw std::out_of_range("Índice inválido!");
+    if (index == 0)
+        return pop_front();
+
+    NodeIndex previous = walk(index - 1);
+    NodeIndex node = nodes_[previous].next;
+    T data = nodes_[node].data;
+    nodes_[previous].next = nodes_[node].next;
+    if (node == tail_)
+        tail_ = previous;
+    nodes_.release(node);
+    size_--;
+    return data;
+}
+
+/**
+ *   Retira um elemento do fim da lista (CompactLinkedList).
+ */
+template<typename T, typename Stats>
+T CompactLinkedList<T, Stats>::pop_back() {
+    if (empty())
+        throw std::out_of_range("Lista está vazia!");
+    return pop(size_ - 1);
+}
+
+/**
+ *   Retira um elemento do início da lista (CompactLinkedList).
+ */
+template<typename T, typename Stats>
+T CompactLinkedList<T, Stats>::pop_front() {
+    if (empty())
+        throw std::out_of_range("Lista vazia!");
+
+    NodeIndex node = head_;
+    T data = nodes_[node].data;
+    head_ = nodes_[node].next;
+    if (head_ == NIL_INDEX)
+        tail_ = NIL_INDEX;
+    nodes_.release(node);
+    size_--;
+    return data;
+}
+
+/**
+ *   Remove um dado específico da lista (CompactLinkedList).
+ */
+template<typename T, typename Stats>
+void CompactLinkedList<T, Stats>::remove(const T& data) {
+    std::size_t index = find(data);
+    if (index != size_)
+        pop(index);
+}
+
+/**
+ *   Verifica se a lista está vazia (CompactLinkedList).
+ */
+template<typename T, typename Stats>
+bool CompactLinkedList<T, Stats>::empty() const {
+    return size_ == 0;
+}
+
+/**
+ *   Verifica se a lista contém determinado dado (CompactLinkedList).
+ */
+template<typename T, typename Stats>
+bool CompactLinkedList<T, Stats>::contains(const T& data) const {
+    return find(data) != size_;
+}
+
+/**
+ *   Retorna a posição de um dado na lista, ou size() se não encontrado
+ * (CompactLinkedList).
+ */
+template<typename T, typename Stats>
+std::size_t CompactLinkedList<T, Stats>::find(const T& data) const {
+    NodeIndex current = head_;
+    std::size_t index = 0;
+    while (index < size_ && !(nodes_[current].data == data)) {
+        current = nodes_[current].next;
+        index++;
+    }
+    return index;
+}
+
+/**
+ *   Retorna o tamanho da lista (CompactLinkedList).
+ */
+template<typename T, typename Stats>
+std::size_t CompactLinkedList<T, Stats>::size() const {
+    return size_;
+}
+
+/**
+ *   Copia os nodos para um pool novo, na ordem da lista e sem buracos
+ * (CompactLinkedList). Depois disso percorrer a lista é ler o vetor em
+ * sequência, o que o prefetch do próprio processador acompanha.
+ */
+template<typename T, typename Stats>
+void CompactLinkedList<T, Stats>::compact() {
+    IndexNodePool<Node> nodes(size_);
+    NodeIndex current = head_;
+    for (std::size_t i = 0; i < size_; i++) {
+        NodeIndex node = nodes.allocate();  // o i-ésimo nodo de um pool novo
+        nodes[node].data = nodes_[current].data;
+        nodes[node].next = i + 1 < size_ ? node + 1 : NIL_INDEX;
+        current = nodes_[current].next;
+    }
+    Stats::allocated(nodes.bytes_allocated());
+    Stats::released(nodes_.bytes_allocated());
+    nodes_.swap(nodes);
+    head_ = size_ > 0 ? 0 : NIL_INDEX;
+    tail_ = size_ > 0 ? static_cast<NodeIndex>(size_ - 1) : NIL_INDEX;
+}
+
+/**
+ *   Retorna os contadores da política de estatísticas (CompactLinkedList).
+ */
+template<typename T, typename Stats>
+StatsSnapshot CompactLinkedList<T, Stats>::stats() const {
+    return Stats::snapshot();
+}
+
+/**
+ *   Zera os contadores da política de estatísticas (CompactLinkedList).
+ */
+template<typename T, typename Stats>
+void CompactLinkedList<T, Stats>::reset_stats() {
+    Stats::reset();
+}
+
+/**
+ *   Retorna os bytes que a lista ocupa no heap: o vetor do pool inteiro
+ * (CompactLinkedList).
+ */
+template<typename T, typename Stats>
+std::size_t CompactLinkedList<T, Stats>::bytes_allocated() const {
+    return nodes_.bytes_allocated();
+}
+
+/**
+ *   Retorna quantos dados cabem antes de o pool crescer (CompactLinkedList).
+ */
+template<typename T, typename Stats>
+std::size_t CompactLinkedList<T, Stats>::capacity() const {
+    return nodes_.capacity();
+}
+
+/**
+ *   Retorna o detalhamento da memória ocupada (CompactLinkedList).
+ */
+template<typename T, typename Stats>
+MemoryUsage CompactLinkedList<T, Stats>::memory_usage() const {
+    return detail::pool_usage<T, Node>(size_, nodes_.capacity());
+}
+
+/**
+ *   Repassa as alocações ao observador com o rótulo site (CompactLinkedList);
+ * exige a política ObservedStats.
+ */
+template<typename T, typename Stats>
+void CompactLinkedList<T, Stats>::observe(AllocationObserver* observer,
+                                                 const char* site) {
+    Stats::observe(observer, site);
+}
+
+}  // namespace structures
+
+#endif
@@ -0,0 +1,271 @@
+// Copyright 2017 Letícia do Nascimento
+
+#ifndef STRUCTURES_CONCURRENT_ARRAY_QUEUE_H
+#define STRUCTURES_CONCURRENT_ARRAY_QUEUE_H
+
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>  // C++ exception
+
+#include "./memory_usage.h"
+#include "./operation_stats.h"
+
+namespace structures {
+
+/**
+ * @brief      Fila (FIFO) limitada para vários produtores e vários
+ *             consumidores, sem travas (algoritmo de Dmitry Vyukov). Usa o
+ *             vetor circular da ArrayQueue com um número de sequência em cada
+ *             posição: cada thread disputa só a posição que vai usar, em vez
+ *             de uma trava sobre a fila inteira. Não aloca depois de
+ *             construída.
+ *
+ * @tparam     T      Parâmetro genérico de Template
+ * @tparam     Stats  Política de estatísticas; como os contadores não são
+ *                    atômicos, só a alocação do vetor (no construtor e no
+ *                    destrutor) é contada, nunca as operações
+ */
+template<typename T, typename Stats = NoStats>
+class ConcurrentArrayQueue : private Stats {
+ public:
+    ConcurrentArrayQueue();
+    explicit ConcurrentArrayQueue(std::size_t max);
+    ~ConcurrentArrayQueue();
+
+    ConcurrentArrayQueue(const ConcurrentArrayQueue&) = delete;
+    ConcurrentArrayQueue& operator=(const ConcurrentArrayQueue&) = delete;
+
+    bool try_enqueue(const T& data);  // enfila, se houver espaço
+    bool try_dequeue(T& data);  // desenfila, se houver dado
+
+    void enqueue(const T& data);  // enfila
+    T dequeue();  // desenfila
+
+    bool empty() const;  // fila vazia (aproximado sob concorrência)
+    std::size_t size() const;  // tamanho (aproximado sob concorrência)
+    std::size_t max_size() const;  // tamanho máximo
+
+    StatsSnapshot stats() const;  // contadores de estatísticas
+    void reset_stats();  // zera os contadores
+    std::size_t bytes_allocated() const;  // bytes no heap
+    std::size_t capacity() const;  // dados que cabem sem alocar
+    MemoryUsage memory_usage() const;  // detalhamento da memória
+    // repassa alocações a um observador (só com ObservedStats)
+    void observe(AllocationObserver* observer, const char* site);
+
+ private:
+    static const std::size_t CACHE_LINE = 64;
+    static const std::size_t DEFAULT_SIZE = 16;
+
+    struct Cell {
+        std::atomic<std::size_t> sequence;
+        T data;
+    };
+
+    Cell* contents;
+    std::size_t mask_;  // max_size_ - 1, para o índice circular
+    std::size_t max_size_;
+
+    // cada posição em sua linha de cache, sem falso compartilhamento
+    alignas(CACHE_LINE) std::atomic<std::size_t> enqueue_pos_;
+    alignas(CACHE_LINE) std::atomic<std::size_t> dequeue_pos_;
+};
+
+/**
+ *   Construtor padrão da classe ConcurrentArrayQueue.
+ */
+template<typename T, typename Stats>
+ConcurrentArrayQueue<T, Stats>::ConcurrentArrayQueue() :
+    ConcurrentArrayQueue(DEFAULT_SIZE)
+{}
+
+/**
+ *   Construtor da classe ConcurrentArrayQueue com tamanho máximo, arredondado
+ * para a próxima potência de 2 para que o índice circular seja uma máscara.
+ */
+template<typename T, typename Stats>
+ConcurrentArrayQueue<T, Stats>::ConcurrentArrayQueue(std::size_t max) {
+    max_size_ = 2;
+    while (max_size_ < max)
+        max_size_ *= 2;
+    mask_ = max_size_ - 1;
+    contents = new Cell[max_size_];
+    Stats::allocated(max_size_ * sizeof(Cell));
+    for (std::size_t i = 0; i < max_size_; i++)
+        contents[i].sequence.store(i, std::memory_order_relaxed);
+    enqueue_pos_.store(0, std::memory_order_relaxed);
+    dequeue_pos_.store(0, std::memory_order_relaxed);
+}
+
+/**
+ *   Destrutor da classe ConcurrentArrayQueue.
+ */
+template<typename T, typename Stats>
+ConcurrentArrayQueue<T, Stats>::~ConcurrentArrayQueue() {
+    Stats::released(max_size_ * sizeof(Cell));
+    delete [] contents;
+}
+
+/**
+ *   Tenta inserir data no fim da fila (ConcurrentArrayQueue); retorna false
+ * se ela estiver cheia. A posição está livre quando sua sequência é igual à
+ * posição de inserção.
+ */
+template<typename T, typename Stats>
+bool ConcurrentArrayQueue<T, Stats>::try_enqueue(const T& data) {
+    Cell* cell;
+    std::size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+    while (true) {
+        cell = &contents[pos & mask_];
+        std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+        std::intptr_t diff = static_cast<std::intptr_t>(sequence) -
+                             static_cast<std::intptr_t>(pos);
+        if (diff == 0) {
+            if (enqueue_pos_.compare_exchange_weak(pos, pos + 1,
+                                                   std::memory_order_relaxed))
+                break;
+        } else if (diff < 0) {
+            return false;  // ainda não consumida uma volta atrás: cheia
+        } else {
+            pos = enqueue_pos_.load(std::memory_order_relaxed);
+        }
+    }
+    cell->data = data;
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+/**
+ *   Tenta retirar o início da fila para data (ConcurrentArrayQueue); retorna
+ * false se ela estiver vazia. A posição está preenchida quando sua sequência
+ * é a posição de retirada + 1.
+ */
+template<typename T, typename Stats>
+bool ConcurrentArrayQueue<T, Stats>::try_dequeue(T& data) {
+    Cell* cell;
+    std::size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+    while (true) {
+        cell = &contents[pos & mask_];
+        std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+        std::intptr_t diff = static_cast<std::intptr_t>(sequence) -
+                             static_cast<std::intptr_t>(pos + 1);
+        if (diff == 0) {
+            if (dequeue_pos_.compare_exchange_weak(pos, pos + 1,
+                                                   std::memory_order_relaxed))
+                break;
+        } else if (diff < 0) {
+            return false;  // ainda não preenchida: vazia
+        } else {
+            pos = dequeue_pos_.load(std::memory_order_relaxed);
+        }
+    }
+    data = cell->data;
+    cell->sequence.store(pos + max_size_, std::memory_order_release);
+    return true;
+}
+
+/**
+ *   Insere data no fim da fila (ConcurrentArrayQueue).
+ */
+template<typename T, typename Stats>
+void ConcurrentArrayQueue<T, Stats>::enqueue(const T& data) {
+    if (!try_enqueue(data))
+        throw std::out_of_range("Fila cheia.");
+}
+
+/**
+ *   Retira e retorna o início da fila (ConcurrentArrayQueue).
+ */
+template<typename T, typename Stats>
+T ConcurrentArrayQueue<T, Stats>::dequeue() {
+    T data;
+    if (!try_dequeue(data))
+        throw std::out_of_range("Fila vazia.");
+    return data;
+}
+
+/**
+ *   Verifica se a fila (ConcurrentArrayQueue) está vazia.
+ */
+template<typename T, typename Stats>
+bool ConcurrentArrayQueue<T, Stats>::empty() const {
+    return size() == 0;
+}
+
+/**
+ *   Retorna o tamanho da fila (ConcurrentArrayQueue); com outras threads
+ * operando, é só uma estimativa.
+ */
+template<typename T, typename Stats>
+std::size_t ConcurrentArrayQueue<T, Stats>::size() const {
+    std::size_t head = dequeue_pos_.load(std::memory_order_acquire);
+    std::size_t tail = enqueue_pos_.load(std::memory_order_acquire);
+    return tail > head ? tail - head : 0;
+}
+
+/**
+ *   Retorna o tamanho máximo da fila (ConcurrentArrayQueue).
+ */
+template<typename T, typename Stats>
+std::size_t ConcurrentArrayQueue<T, Stats>::max_size() const {
+    return max_size_;
+}
+
+/**
+ *   Retorna os contadores da política de estatísticas (ConcurrentArrayQueue).
+ */
+template<typename T, typename Stats>
+StatsSnapshot ConcurrentArrayQueue<T, Stats>::stats() const {
+    return Stats::snapshot();
+}
+
+/**
+ *   Zera os contadores da política de estatísticas (ConcurrentArrayQueue).
+ */
+template<typename T, typename Stats>
+void ConcurrentArrayQueue<T, Stats>::reset_stats() {
+    Stats::reset();
+}
+
+/**
+ *   Retorna os bytes do vetor de posições (ConcurrentArrayQueue).
+ */
+template<typename T, typename Stats>
+std::size_t ConcurrentArrayQueue<T, Stats>::bytes_allocated() const {
+    return max_size_ * sizeof(Cell);
+}
+
+/**
+ *   Retorna quantos dados cabem na fila (ConcurrentArrayQueue).
+ */
+template<typename T, typename Stats>
+std::size_t ConcurrentArrayQueue<T, Stats>::capacity() const {
+    return max_size_;
+}
+
+/**
+ *   Retorna o detalhamento da memória ocupada (ConcurrentArrayQueue); as
+ * sequências de cada posição contam como elos. Sob concorrência, elements é
+ * aproximado como size().
+ */
+template<typename T, typename Stats>
+MemoryUsage ConcurrentArrayQueue<T, Stats>::memory_usage() const {
+    MemoryUsage usage = detail::array_usage<T>(size(), max_size_,
+                                               bytes_allocated());
+    usage.link_bytes = bytes_allocated() - max_size_ * sizeof(T);
+    return usage;
+}
+
+/**
+ *   Repassa as alocações ao observador com o rótulo site
+ * (ConcurrentArrayQueue); exige a política ObservedStats.
+ */
+template<typename T, typename Stats>
+void ConcurrentArrayQueue<T, Stats>::observe(AllocationObserver* observer,
+                                             const char* site) {
+    Stats::observe(observer, site);
+}
+
+}  // namespace structures
+
+#endif
@@ -1,8 +1,15 @@
 // Copyright 2017 Letícia do Nascimento
 
+#ifndef STRUCTURES_DOUBLY_LINKED_LIST_H
+#define STRUCTURES_DOUBLY_LINKED_LIST_H
+
 #include <stdexcept>  // C++ exception
 #include <cstdint>
 
+#include "./memory_usage.h"
+#include "./operation_stats.h"
+#include "./prefetch.h"
+
 namespace structures {
 
 /**
@@ -11,11 +18,12 @@ namespace structures {
  *             células que apontam para o próximo elemento da lista, e para
  *             o anterior.
  *
- * @tparam     T     Parâmetro genérico de Template
+ * @tparam     T      Parâmetro genérico de Template
+ * @tparam     Stats  Política de estatísticas (NoStats ou OperationStats)
  */
 
-template<typename T>
-class DoublyLinkedList {
+template<typename T, typename Stats = NoStats>
+class DoublyLinkedList : private Stats {
  public:
     DoublyLinkedList();
     ~DoublyLinkedList();
@@ -40,6 +48,14 @@ class DoublyLinkedList {
     std::size_t find(const T& data) const;  // posição de um dado
     std::size_t size() const;  // tamanho
 
+    StatsSnapshot stats() const;  // contadores de estatísticas
+    void reset_stats();  // zera os contadores
+    std::size_t bytes_allocated() const;  // bytes no heap
+    std::size_t capacity() const;  // dados que cabem sem alocar
+    MemoryUsage memory_usage() const;  // detalhamento da memória
+    // repassa alocações a um observador (só com ObservedStats)
+    void observe(AllocationObserver* observer, const char* site);
+
  private:
     class Node {
      public:
@@ -73,8 +89,8 @@ class DoublyLinkedList {
 /**
  *   Construtor padrão da classe DoublyLinkedList.
  */
-template <typename T>
-DoublyLinkedList<T>::DoublyLinkedList() {
+template<typename T, typename Stats>
+DoublyLinkedList<T, Stats>::DoublyLinkedList() {
     head = nullptr;
     size_ = 0;
 }
@@ -82,16 +98,16 @@ DoublyLinkedList<T>::DoublyLinkedList() {
 /**
  *   Destrutor padrão da classe DoublyLinkedList.
  */
-template<typename T>
-DoublyLinkedList<T>::~DoublyLinkedList() {
+template<typename T, typename Stats>
+DoublyLinkedList<T, Stats>::~DoublyLinkedList() {
     clear();
 }
 
 /**
  *   Faz uma limpeza da lista encadeada DoublyLinkedList.
  */
-template<typename T>
-void DoublyLinkedList<T>::clear() {
+template<typename T, typename Stats>
+void DoublyLinkedList<T, Stats>::clear() {
     while (!empty()) {
         pop_front();
     }
@@ -100,32 +116,32 @@ void DoublyLinkedList<T>::clear() {
 /**
  *   Verifica se a lista encadeada (DoublyLinkedList) está vazia.
  */
-template<typename T>
-bool DoublyLinkedList<T>::empty() const {
+template<typename T, typename Stats>
+bool DoublyLinkedList<T, Stats>::empty() const {
     return size_ == 0;
 }
 
 /**
  *   Verifica e retorna o tamanho da lista encadeada (DoublyLinkedList).
  */
-template<typename T>
-std::size_t DoublyLinkedList<T>::size() const {
+template<typename T, typename Stats>
+std::size_t DoublyLinkedList<T, Stats>::size() const {
     return size_;
 }
 
 /**
  *   Inserir novo elemento do fim da lista encadeada (DoublyLinkedList).
  */
-template<typename T>
-void DoublyLinkedList<T>::push_back(const T& data) {
+template<typename T, typename Stats>
+void DoublyLinkedList<T, Stats>::push_back(const T& data) {
     insert(data, size_);
 }
 
 /**
  *   Inserir novo elemento no índice específico da lista encadeada (DoublyLinkedList).
  */
-template<typename T>
-void DoublyLinkedList<T>::insert(const T& data, std::size_t index) {
+template<typename T, typename Stats>
+void DoublyLinkedList<T, Stats>::insert(const T& data, std::size_t index) {
     if (index < 0 || index > size_) {
         throw std::out_of_range("Índice inválido");
     }
@@ -134,13 +150,16 @@ void DoublyLinkedList<T>::insert(const T& data, std::size_t index) {
         return push_front(data);
     }
 
+    Stats::operation();
     Node* current = head;
 
-    for (int i = 0; i < index - 1; i++) {
+    for (std::size_t i = 0; i < index - 1; i++) {
         current = current->next();
     }
+    Stats::traversed(index - 1);
 
     Node* new_ = new Node(data, current, current->next());
+    Stats::allocated(sizeof(Node));
     current->next(new_);
 
     if (new_->next()) {
@@ -148,14 +167,17 @@ void DoublyLinkedList<T>::insert(const T& data, std::size_t index) {
     }
 
     size_++;
+    Stats::resized(size_);
 }
 
 /**
  * Inserir novo elemento no começo da lista encadeada (DoublyLinkedList).
  */
-template<typename T>
-void DoublyLinkedList<T>::push_front(const T& data) {
+template<typename T, typename Stats>
+void DoublyLinkedList<T, Stats>::push_front(const T& data) {
     Node* first_node = new Node(data);
+    Stats::operation();
+    Stats::allocated(sizeof(Node));
     first_node->next(head);
     first_node->prev(nullptr);
     head = first_node;
@@ -165,14 +187,15 @@ void DoublyLinkedList<T>::push_front(const T& data) {
     }
 
     size_++;
+    Stats::resized(size_);
 }
 
 /**
  *   Insere novo elemento na ordem definida pela lista encadeada
  * (DoublyLinkedList).
  */
-template<typename T>
-void DoublyLinkedList<T>::insert_sorted(const T& data) {
+template<typename T, typename Stats>
+void DoublyLinkedList<T, Stats>::insert_sorted(const T& data) {
     if (empty()) {
         push_front(data);
     } else {
@@ -180,7 +203,10 @@ void DoublyLinkedList<T>::insert_sorted(const T& data) {
         Node* current = head;
         for (i = 0; i < size_ && data > current->data(); i++) {
           current = current->next();
+          if (current != nullptr)
+              STRUCTURES_PREFETCH(current->next());
         }
+        Stats::traversed(i);
         insert(data, i);
     }
 }
@@ -189,18 +215,20 @@ void DoublyLinkedList<T>::insert_sorted(const T& data) {
  *   Retorna um elemento da lista encadeada que está em uma posição específica
  * (DoublyLinkedList).
  */
-template<typename T>
-T& DoublyLinkedList<T>::at(std::size_t index) {
+template<typename T, typename Stats>
+T& DoublyLinkedList<T, Stats>::at(std::size_t index) {
     if (index < 0 || index > size_ - 1)
         throw std::out_of_range("Índice inválido!");
 
+    Stats::operation();
     Node* current = head;
 
     if (index == 0)
         return current->data();
 
-    for (int i = 0; i < index; i++)
+    for (std::size_t i = 0; i < index; i++)
       current = current->next();
+    Stats::traversed(index);
 
     return current->data();
 }
@@ -208,8 +236,8 @@ T& DoublyLinkedList<T>::at(std::size_t index) {
 /**
  *   Remove um elemento da lista encadeada (DoublyLinkedList).
  */
-template<typename T>
-T DoublyLinkedList<T>::pop(std::size_t index) {
+template<typename T, typename Stats>
+T DoublyLinkedList<T, Stats>::pop(std::size_t index) {
     if (empty())
         throw std::out_of_range("Lista vazia!");
 
@@ -219,12 +247,14 @@ T DoublyLinkedList<T>::pop(std::size_t index) {
     if (index == 0)
         return pop_front();
 
+    Stats::operation();
     std::size_t i = 0;
     Node* previous = head;
 
     for (i = 0; i < index - 1; i++) {
       previous = previous->next();
     }
+    Stats::traversed(index - 1);
 
     Node* current = previous->next();
     T return_ = current->data();
@@ -235,6 +265,7 @@ T DoublyLinkedList<T>::pop(std::size_t index) {
     }
 
     size_--;
+    Stats::released(sizeof(Node));
     delete current;
     return return_;
 }
@@ -242,19 +273,20 @@ T DoublyLinkedList<T>::pop(std::size_t index) {
 /**
  *   Remove o último elemento da lista encadeada (DoublyLinkedList).
  */
-template<typename T>
-T DoublyLinkedList<T>::pop_back() {
+template<typename T, typename Stats>
+T DoublyLinkedList<T, Stats>::pop_back() {
     return pop(size_ - 1);
 }
 
 /**
  *   Remove o primeiro elemento da lista encadeada (DoublyLinkedList).
  */
-template<typename T>
-T DoublyLinkedList<T>::pop_front() {
+template<typename T, typename Stats>
+T DoublyLinkedList<T, Stats>::pop_front() {
     if (empty())
         throw std::out_of_range("Lista está vazia!");
 
+    Stats::operation();
     Node* previous = head;
     T out_ = previous->data();
     head = previous->next();
@@ -262,6 +294,7 @@ T DoublyLinkedList<T>::pop_front() {
     if (head != nullptr)
         head->prev(nullptr);
 
+    Stats::released(sizeof(Node));
     delete previous;
     size_--;
     return out_;
@@ -270,8 +303,8 @@ T DoublyLinkedList<T>::pop_front() {
 /**
  *   Remove um item específico da lista encadeada (DoublyLinkedList).
  */
-template<typename T>
-void DoublyLinkedList<T>::remove(const T& data) {
+template<typename T, typename Stats>
+void DoublyLinkedList<T, Stats>::remove(const T& data) {
     std::size_t test = find(data);
     if (test != size_)
         pop(test);
@@ -281,8 +314,8 @@ void DoublyLinkedList<T>::remove(const T& data) {
  *   Verifica se a lista encadeada (DoublyLinkedList) possui um elemento
  * específico de acordo com o elemento fornecido.
  */ 
-template<typename T>
-bool DoublyLinkedList<T>::contains(const T& data) const {
+template<typename T, typename Stats>
+bool DoublyLinkedList<T, Stats>::contains(const T& data) const {
     if (find(data) != size_)
         return true;
     return false;
@@ -292,13 +325,14 @@ bool DoublyLinkedList<T>::contains(const T& data) const {
  *   Retorna o índice de um elemento específico na lista encadeada
  * (DoublyLinkedList).
  */
-template<typename T>
-std::size_t DoublyLinkedList<T>::find(const T& data) const {
+template<typename T, typename Stats>
+std::size_t DoublyLinkedList<T, Stats>::find(const T& data) const {
     std::size_t i;
     std::size_t index = size_;
     Node* current = head;
 
     for (i = 0; i < size_; i++) {
+        STRUCTURES_PREFETCH(current->next());
         if (current->data() == data) {
             index = i;
             break;
@@ -306,6 +340,8 @@ std::size_t DoublyLinkedList<T>::find(const T& data) const {
         if (i != size_)
             current = current->next();
     }
+    Stats::operation();
+    Stats::traversed(i < size_ ? i + 1 : size_);
     return index;
 }
 
@@ -313,17 +349,69 @@ std::size_t DoublyLinkedList<T>::find(const T& data) const {
  *  Retorna um elemento específico na lista encadeada sem checagens
  * (DoublyLinkedList).
  */
-template<typename T>
-const T& DoublyLinkedList<T>::at(std::size_t index) const {
-    std::size_t i;
-    Node* current = head;
+template<typename T, typename Stats>
+const T& DoublyLinkedList<T, Stats>::at(std::size_t index) const {
+    Stats::operation();
+    const Node* current = head;
 
-    while (index < i) {
-        i++;
+    for (std::size_t i = 0; i < index; i++)
         current = current->next();
-    }
+    Stats::traversed(index);
 
     return current->data();
 }
 
+/**
+ *   Retorna os contadores da política de estatísticas (DoublyLinkedList).
+ */
+template<typename T, typename Stats>
+StatsSnapshot DoublyLinkedList<T, Stats>::stats() const {
+    return Stats::snapshot();
+}
+
+/**
+ *   Zera os contadores da política de estatísticas (DoublyLinkedList).
+ */
+template<typename T, typename Stats>
+void DoublyLinkedList<T, Stats>::reset_stats() {
+    Stats::reset();
+}
+
+/**
+ *   Retorna os bytes que a lista ocupa no heap (DoublyLinkedList).
+ */
+template<typename T, typename Stats>
+std::size_t DoublyLinkedList<T, Stats>::bytes_allocated() const {
+    return size_ * sizeof(Node);
+}
+
+/**
+ *   Retorna quantos dados cabem sem nova alocação (DoublyLinkedList): cada
+ * dado novo aloca um nodo.
+ */
+template<typename T, typename Stats>
+std::size_t DoublyLinkedList<T, Stats>::capacity() const {
+    return size_;
+}
+
+/**
+ *   Retorna o detalhamento da memória ocupada (DoublyLinkedList).
+ */
+template<typename T, typename Stats>
+MemoryUsage DoublyLinkedList<T, Stats>::memory_usage() const {
+    return detail::node_usage<T, Node>(size_, size_);
+}
+
+/**
+ *   Repassa as alocações ao observador com o rótulo site (DoublyLinkedList);
+ * exige a política ObservedStats.
+ */
+template<typename T, typename Stats>
+void DoublyLinkedList<T, Stats>::observe(AllocationObserver* observer,
+                                         const char* site) {
+    Stats::observe(observer, site);
+}
+
 }  // namespace structures
+
+#endif
@@ -0,0 +1,295 @@
+// Copyright 2017 Letícia do Nascimento
+
+#ifndef STRUCTURES_FIXED_ARRAY_LIST_H
+#define STRUCTURES_FIXED_ARRAY_LIST_H
+
+#include <cstdint>
+#include <stdexcept>  // C++ exception
+
+#include "./memory_usage.h"
+
+namespace structures {
+
+/**
+ * @brief      Lista com capacidade fixa em tempo de compilação, com a mesma
+ *             interface da ArrayList. Os dados ficam num vetor dentro do
+ *             próprio objeto, sem uso do heap, e os limites são constantes
+ *             que o compilador pode propagar. Pode ser usada em expressões
+ *             constexpr (C++14) quando T é um tipo literal.
+ *
+ * @tparam     T     Parâmetro genérico de Template
+ * @tparam     N     Capacidade da lista
+ */
+template<typename T, std::size_t N>
+class FixedArrayList {
+ public:
+    constexpr FixedArrayList() = default;
+
+    constexpr void clear();  // limpa
+    constexpr void push_back(const T& data);  // insere no fim
+    constexpr void push_front(const T& data);  // insere no início
+    constexpr void insert(const T& data, std::size_t index);  // insere na posição
+    constexpr void insert_sorted(const T& data);  // insere em ordem
+    constexpr T pop(std::size_t index);  // retira da posição
+    constexpr T pop_back();  // retira do fim
+    constexpr T pop_front();  // retira do início
+    constexpr void remove(const T& data);  // retira um dado
+    constexpr bool full() const;  // lista cheia
+    constexpr bool empty() const;  // lista vazia
+    constexpr bool contains(const T& data) const;  // dado está na lista
+    constexpr std::size_t find(const T& data) const;  // posição do dado
+    constexpr std::size_t size() const;  // tamanho
+    static constexpr std::size_t max_size();  // tamanho máximo
+    static constexpr std::size_t bytes_allocated();  // bytes no heap (0)
+    static constexpr std::size_t capacity();  // dados que cabem
+    constexpr MemoryUsage memory_usage() const;  // detalhamento da memória
+    constexpr T& at(std::size_t index);  // dado na posição, verificada
+    constexpr const T& at(std::size_t index) const;
+    constexpr T& operator[](std::size_t index);  // dado na posição
+    constexpr const T& operator[](std::size_t index) const;
+    constexpr T* data();  // vetor de dados
+    constexpr const T* data() const;
+
+ private:
+    static_assert(N > 0, "Capacidade precisa ser positiva.");
+
+    T contents[N]{};
+    std::size_t size_{0};
+};
+
+/**
+ *   Faz uma limpeza da lista (FixedArrayList).
+ */
+template<typename T, std::size_t N>
+constexpr void FixedArrayList<T, N>::clear() {
+    size_ = 0;
+}
+
+/**
+ *   Insere data no fim da lista (FixedArrayList).
+ */
+template<typename T, std::size_t N>
+constexpr void FixedArrayList<T, N>::push_back(const T& data) {
+    insert(data, size_);
+}
+
+/**
+ *   Insere data no início da lista (FixedArrayList).
+ */
+template<typename T, std::size_t N>
+constexpr void FixedArrayList<T, N>::push_front(const T& data) {
+    insert(data, 0);
+}
+
+/**
+ *   Insere data na posição index, deslocando os seguintes (FixedArrayList).
+ */
+template<typename T, std::size_t N>
+constexpr void FixedArrayList<T, N>::insert(const T& data, std::size_t index) {
+    if (full())
+        throw std::out_of_range("Lista atualmente cheia.");
+    if (index > size_)
+        throw std::out_of_range("Erro! Posição inexistente.");
+
+    for (std::size_t i = size_; i > index; i--)
+        contents[i] = contents[i - 1];
+    contents[index] = data;
+    size_++;
+}
+
+/**
+ *   Insere data antes do primeiro elemento maior que ele (FixedArrayList).
+ */
+template<typename T, std::size_t N>
+constexpr void FixedArrayList<T, N>::insert_sorted(const T& data) {
+    std::size_t index = 0;
+    while (index < size_ && !(data < contents[index]))
+        index++;
+    insert(data, index);
+}
+
+/**
+ *   Retira e retorna o dado da posição index (FixedArrayList).
+ */
+template<typename T, std::size_t N>
+constexpr T FixedArrayList<T, N>::pop(std::size_t index) {
+    if (empty())
+        throw std::out_of_range("Lista atualmente vazia.");
+    if (index >= size_)
+        throw std::out_of_range("Erro! Posição inexistente.");
+
+    T data = contents[index];
+    for (std::size_t i = index + 1; i < size_; i++)
+        contents[i - 1] = contents[i];
+    size_--;
+    return data;
+}
+
+/**
+ *   Retira e retorna o fim da lista (FixedArrayList).
+ */
+template<typename T, std::size_t N>
+constexpr T FixedArrayList<T, N>::pop_back() {
+    if (empty())
+        throw std::out_of_range("Lista atualmente vazia.");
+    return contents[--size_];
+}
+
+/**
+ *   Retira e retorna o início da lista (FixedArrayList).
+ */
+template<typename T, std::size_t N>
+constexpr T FixedArrayList<T, N>::pop_front() {
+    return pop(0);
+}
+
+/**
+ *   Retira a primeira ocorrência de data (FixedArrayList).
+ */
+template<typename T, std::size_t N>
+constexpr void FixedArrayList<T, N>::remove(const T& data) {
+    std::size_t index = find(data);
+    if (index == size_)
+        throw std::out_of_range("Elemento inexistente");
+    pop(index);
+}
+
+/**
+ *   Verifica se a lista (FixedArrayList) está cheia.
+ */
+template<typename T, std::size_t N>
+constexpr bool FixedArrayList<T, N>::full() const {
+    return size_ == N;
+}
+
+/**
+ *   Verifica se a lista (FixedArrayList) está vazia.
+ */
+template<typename T, std::size_t N>
+constexpr bool FixedArrayList<T, N>::empty() const {
+    return size_ == 0;
+}
+
+/**
+ *   Verifica se data está na lista (FixedArrayList).
+ */
+template<typename T, std::size_t N>
+constexpr bool FixedArrayList<T, N>::contains(const T& data) const {
+    return find(data) != size_;
+}
+
+/**
+ *   Retorna a posição da primeira ocorrência de data, ou size() se não
+ * encontrado (FixedArrayList).
+ */
+template<typename T, std::size_t N>
+constexpr std::size_t FixedArrayList<T, N>::find(const T& data) const {
+    std::size_t i = 0;
+    while (i < size_ && !(contents[i] == data))
+        i++;
+    return i;
+}
+
+/**
+ *   Retorna o tamanho da lista (FixedArrayList).
+ */
+template<typename T, std::size_t N>
+constexpr std::size_t FixedArrayList<T, N>::size() const {
+    return size_;
+}
+
+/**
+ *   Retorna o tamanho máximo da lista (FixedArrayList).
+ */
+template<typename T, std::size_t N>
+constexpr std::size_t FixedArrayList<T, N>::max_size() {
+    return N;
+}
+
+/**
+ *   Retorna o dado da posição index, verificando os limites (FixedArrayList).
+ */
+template<typename T, std::size_t N>
+constexpr T& FixedArrayList<T, N>::at(std::size_t index) {
+    if (index >= size_)
+        throw std::out_of_range("Erro! Posição inexistente.");
+    return contents[index];
+}
+
+/**
+ *   Retorna o dado da posição index, verificando os limites (FixedArrayList)
+ * - versão const.
+ */
+template<typename T, std::size_t N>
+constexpr const T& FixedArrayList<T, N>::at(std::size_t index) const {
+    if (index >= size_)
+        throw std::out_of_range("Erro! Posição inexistente.");
+    return contents[index];
+}
+
+/**
+ *   Retorna o dado da posição index (FixedArrayList).
+ */
+template<typename T, std::size_t N>
+constexpr T& FixedArrayList<T, N>::operator[](std::size_t index) {
+    return at(index);
+}
+
+/**
+ *   Retorna o dado da posição index (FixedArrayList) - versão const.
+ */
+template<typename T, std::size_t N>
+constexpr const T& FixedArrayList<T, N>::operator[](std::size_t index) const {
+    return at(index);
+}
+
+/**
+ *   Retorna o vetor de dados (FixedArrayList).
+ */
+template<typename T, std::size_t N>
+constexpr T* FixedArrayList<T, N>::data() {
+    return contents;
+}
+
+/**
+ *   Retorna o vetor de dados (FixedArrayList) - versão const.
+ */
+template<typename T, std::size_t N>
+constexpr const T* FixedArrayList<T, N>::data() const {
+    return contents;
+}
+
+/**
+ *   Retorna os bytes que a lista ocupa no heap (FixedArrayList): nenhum, o
+ * vetor fica dentro do próprio objeto.
+ */
+template<typename T, std::size_t N>
+constexpr std::size_t FixedArrayList<T, N>::bytes_allocated() {
+    return 0;
+}
+
+/**
+ *   Retorna quantos dados cabem na lista (FixedArrayList).
+ */
+template<typename T, std::size_t N>
+constexpr std::size_t FixedArrayList<T, N>::capacity() {
+    return N;
+}
+
+/**
+ *   Retorna o detalhamento da memória do vetor embutido (FixedArrayList);
+ * bytes_allocated fica 0, já que nada vem do heap.
+ */
+template<typename T, std::size_t N>
+constexpr MemoryUsage FixedArrayList<T, N>::memory_usage() const {
+    MemoryUsage usage;
+    usage.elements = size();
+    usage.capacity = N;
+    usage.element_bytes = size() * sizeof(T);
+    usage.unused_bytes = (N - size()) * sizeof(T);
+    return usage;
+}
+
+}  // namespace structures
+
+#endif
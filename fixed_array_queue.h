@@ -0,0 +1,196 @@
+// Copyright 2017 Letícia do Nascimento
+
+#ifndef STRUCTURES_FIXED_ARRAY_QUEUE_H
+#define STRUCTURES_FIXED_ARRAY_QUEUE_H
+
+#include <cstdint>
+#include <stdexcept>  // C++ exception
+
+#include "./memory_usage.h"
+
+namespace structures {
+
+/**
+ * @brief      Fila (FIFO) circular com capacidade fixa em tempo de
+ *             compilação. Os dados ficam num vetor dentro do próprio objeto,
+ *             sem uso do heap; o índice circular é um resto por N constante
+ *             (uma máscara quando N é potência de 2), e nenhuma operação
+ *             desloca o vetor. Pode ser usada em expressões constexpr (C++14)
+ *             quando T é um tipo literal.
+ *
+ * @tparam     T     Parâmetro genérico de Template
+ * @tparam     N     Capacidade da fila
+ */
+template<typename T, std::size_t N>
+class FixedArrayQueue {
+ public:
+    constexpr FixedArrayQueue() = default;
+
+    constexpr void clear();  // limpa
+
+    constexpr void enqueue(const T& data);  // enfila
+    constexpr T dequeue();  // desenfila
+    constexpr T& front();  // primeiro
+    constexpr const T& front() const;
+    constexpr T& back();  // último
+    constexpr const T& back() const;
+
+    constexpr bool empty() const;  // fila vazia
+    constexpr bool full() const;  // fila cheia
+    constexpr std::size_t size() const;  // tamanho
+    static constexpr std::size_t max_size();  // tamanho máximo
+    static constexpr std::size_t bytes_allocated();  // bytes no heap (0)
+    static constexpr std::size_t capacity();  // dados que cabem
+    constexpr MemoryUsage memory_usage() const;  // detalhamento da memória
+
+ private:
+    static_assert(N > 0, "Capacidade precisa ser positiva.");
+
+    static constexpr std::size_t wrap(std::size_t index) {
+        return index % N;
+    }
+
+    T contents[N]{};
+    std::size_t begin_{0};  // posição do primeiro
+    std::size_t size_{0};
+};
+
+/**
+ *   Faz uma limpeza da fila (FixedArrayQueue).
+ */
+template<typename T, std::size_t N>
+constexpr void FixedArrayQueue<T, N>::clear() {
+    begin_ = 0;
+    size_ = 0;
+}
+
+/**
+ *   Insere data no fim da fila (FixedArrayQueue).
+ */
+template<typename T, std::size_t N>
+constexpr void FixedArrayQueue<T, N>::enqueue(const T& data) {
+    if (full())
+        throw std::out_of_range("Fila atualmente cheia.");
+    contents[wrap(begin_ + size_)] = data;
+    size_++;
+}
+
+/**
+ *   Retira e retorna o início da fila (FixedArrayQueue).
+ */
+template<typename T, std::size_t N>
+constexpr T FixedArrayQueue<T, N>::dequeue() {
+    if (empty())
+        throw std::out_of_range("Fila atualmente vazia.");
+    T data = contents[begin_];
+    begin_ = wrap(begin_ + 1);
+    size_--;
+    return data;
+}
+
+/**
+ *   Retorna o início da fila (FixedArrayQueue).
+ */
+template<typename T, std::size_t N>
+constexpr T& FixedArrayQueue<T, N>::front() {
+    if (empty())
+        throw std::out_of_range("Fila vazia.");
+    return contents[begin_];
+}
+
+/**
+ *   Retorna o início da fila (FixedArrayQueue) - versão const.
+ */
+template<typename T, std::size_t N>
+constexpr const T& FixedArrayQueue<T, N>::front() const {
+    if (empty())
+        throw std::out_of_range("Fila vazia.");
+    return contents[begin_];
+}
+
+/**
+ *   Retorna o fim da fila (FixedArrayQueue).
+ */
+template<typename T, std::size_t N>
+constexpr T& FixedArrayQueue<T, N>::back() {
+    if (empty())
+        throw std::out_of_range("Fila vazia.");
+    return contents[wrap(begin_ + size_ - 1)];
+}
+
+/**
+ *   Retorna o fim da fila (FixedArrayQueue) - versão const.
+ */
+template<typename T, std::size_t N>
+constexpr const T& FixedArrayQueue<T, N>::back() const {
+    if (empty())
+        throw std::out_of_range("Fila vazia.");
+    return contents[wrap(begin_ + size_ - 1)];
+}
+
+/**
+ *   Verifica se a fila (FixedArrayQueue) está vazia.
+ */
+template<typename T, std::size_t N>
+constexpr bool FixedArrayQueue<T, N>::empty() const {
+    return size_ == 0;
+}
+
+/**
+ *   Verifica se a fila (FixedArrayQueue) está cheia.
+ */
+template<typename T, std::size_t N>
+constexpr bool FixedArrayQueue<T, N>::full() const {
+    return size_ == N;
+}
+
+/**
+ *   Retorna o tamanho da fila (FixedArrayQueue).
+ */
+template<typename T, std::size_t N>
+constexpr std::size_t FixedArrayQueue<T, N>::size() const {
+    return size_;
+}
+
+/**
+ *   Retorna o tamanho máximo da fila (FixedArrayQueue).
+ */
+template<typename T, std::size_t N>
+constexpr std::size_t FixedArrayQueue<T, N>::max_size() {
+    return N;
+}
+
+/**
+ *   Retorna os bytes que a fila ocupa no heap (FixedArrayQueue): nenhum, o
+ * vetor fica dentro do próprio objeto.
+ */
+template<typename T, std::size_t N>
+constexpr std::size_t FixedArrayQueue<T, N>::bytes_allocated() {
+    return 0;
+}
+
+/**
+ *   Retorna quantos dados cabem na fila (FixedArrayQueue).
+ */
+template<typename T, std::size_t N>
+constexpr std::size_t FixedArrayQueue<T, N>::capacity() {
+    return N;
+}
+
+/**
+ *   Retorna o detalhamento da memória do vetor embutido (FixedArrayQueue);
+ * bytes_allocated fica 0, já que nada vem do heap.
+ */
+template<typename T, std::size_t N>
+constexpr MemoryUsage FixedArrayQueue<T, N>::memory_usage() const {
+    MemoryUsage usage;
+    usage.elements = size();
+    usage.capacity = N;
+    usage.element_bytes = size() * sizeof(T);
+    usage.unused_bytes = (N - size()) * sizeof(T);
+    return usage;
+}
+
+}  // namespace structures
+
+#endif
@@ -0,0 +1,163 @@
+// Copyright 2017 Letícia do Nascimento
+
+#ifndef STRUCTURES_FIXED_ARRAY_STACK_H
+#define STRUCTURES_FIXED_ARRAY_STACK_H
+
+#include <cstdint>
+#include <stdexcept>  // C++ exception
+
+#include "./memory_usage.h"
+
+namespace structures {
+
+/**
+ * @brief      Pilha (LIFO) com capacidade fixa em tempo de compilação. Os
+ *             dados ficam num vetor dentro do próprio objeto, sem uso do heap,
+ *             e os limites são constantes que o compilador pode propagar.
+ *             Pode ser usada em expressões constexpr (C++14) quando T é um
+ *             tipo literal.
+ *
+ * @tparam     T     Parâmetro genérico de Template
+ * @tparam     N     Capacidade da pilha
+ */
+template<typename T, std::size_t N>
+class FixedArrayStack {
+ public:
+    constexpr FixedArrayStack() = default;
+
+    constexpr void clear();  // limpa
+
+    constexpr void push(const T& data);  // empilha
+    constexpr T pop();  // desempilha
+    constexpr T& top();  // topo
+    constexpr const T& top() const;
+
+    constexpr bool empty() const;  // pilha vazia
+    constexpr bool full() const;  // pilha cheia
+    constexpr std::size_t size() const;  // tamanho
+    static constexpr std::size_t max_size();  // tamanho máximo
+    static constexpr std::size_t bytes_allocated();  // bytes no heap (0)
+    static constexpr std::size_t capacity();  // dados que cabem
+    constexpr MemoryUsage memory_usage() const;  // detalhamento da memória
+
+ private:
+    static_assert(N > 0, "Capacidade precisa ser positiva.");
+
+    T contents[N]{};
+    std::size_t size_{0};
+};
+
+/**
+ *   Faz uma limpeza da pilha (FixedArrayStack).
+ */
+template<typename T, std::size_t N>
+constexpr void FixedArrayStack<T, N>::clear() {
+    size_ = 0;
+}
+
+/**
+ *   Empilha data (FixedArrayStack).
+ */
+template<typename T, std::size_t N>
+constexpr void FixedArrayStack<T, N>::push(const T& data) {
+    if (full())
+        throw std::out_of_range("Pilha atualmente cheia.");
+    contents[size_++] = data;
+}
+
+/**
+ *   Desempilha e retorna o topo (FixedArrayStack).
+ */
+template<typename T, std::size_t N>
+constexpr T FixedArrayStack<T, N>::pop() {
+    if (empty())
+        throw std::out_of_range("Pilha atualmente vazia.");
+    return contents[--size_];
+}
+
+/**
+ *   Retorna o topo da pilha (FixedArrayStack).
+ */
+template<typename T, std::size_t N>
+constexpr T& FixedArrayStack<T, N>::top() {
+    if (empty())
+        throw std::out_of_range("Pilha vazia.");
+    return contents[size_ - 1];
+}
+
+/**
+ *   Retorna o topo da pilha (FixedArrayStack) - versão const.
+ */
+template<typename T, std::size_t N>
+constexpr const T& FixedArrayStack<T, N>::top() const {
+    if (empty())
+        throw std::out_of_range("Pilha vazia.");
+    return contents[size_ - 1];
+}
+
+/**
+ *   Verifica se a pilha (FixedArrayStack) está vazia.
+ */
+template<typename T, std::size_t N>
+constexpr bool FixedArrayStack<T, N>::empty() const {
+    return size_ == 0;
+}
+
+/**
+ *   Verifica se a pilha (FixedArrayStack) está cheia.
+ */
+template<typename T, std::size_t N>
+constexpr bool FixedArrayStack<T, N>::full() const {
+    return size_ == N;
+}
+
+/**
+ *   Retorna o tamanho da pilha (FixedArrayStack).
+ */
+template<typename T, std::size_t N>
+constexpr std::size_t FixedArrayStack<T, N>::size() const {
+    return size_;
+}
+
+/**
+ *   Retorna o tamanho máximo da pilha (FixedArrayStack).
+ */
+template<typename T, std::size_t N>
+constexpr std::size_t FixedArrayStack<T, N>::max_size() {
+    return N;
+}
+
+/**
+ *   Retorna os bytes que a pilha ocupa no heap (FixedArrayStack): nenhum, o
+ * vetor fica dentro do próprio objeto.
+ */
+template<typename T, std::size_t N>
+constexpr std::size_t FixedArrayStack<T, N>::bytes_allocated() {
+    return 0;
+}
+
+/**
+ *   Retorna quantos dados cabem na pilha (FixedArrayStack).
+ */
+template<typename T, std::size_t N>
+constexpr std::size_t FixedArrayStack<T, N>::capacity() {
+    return N;
+}
+
+/**
+ *   Retorna o detalhamento da memória do vetor embutido (FixedArrayStack);
+ * bytes_allocated fica 0, já que nada vem do heap.
+ */
+template<typename T, std::size_t N>
+constexpr MemoryUsage FixedArrayStack<T, N>::memory_usage() const {
+    MemoryUsage usage;
+    usage.elements = size();
+    usage.capacity = N;
+    usage.element_bytes = size() * sizeof(T);
+    usage.unused_bytes = (N - size()) * sizeof(T);
+    return usage;
+}
+
+}  // namespace structures
+
+#endif
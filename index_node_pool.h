@@ -0,0 +1,263 @@
+// Copyright 2017 Letícia do Nascimento
+
+#ifndef STRUCTURES_INDEX_NODE_POOL_H
+#define STRUCTURES_INDEX_NODE_POOL_H
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>  // C++ exception
+
+#include "./memory_usage.h"
+
+namespace structures {
+
+//  índice de um nodo no pool; NIL_INDEX faz o papel de nullptr
+using NodeIndex = std::uint32_t;
+
+const NodeIndex NIL_INDEX = UINT32_MAX;
+
+/**
+ * @brief      Vetor contíguo de nodos endereçados por índices de 32 bits,
+ *             usado pelas listas compactas. Nodos liberados formam uma lista
+ *             de livres pelo próprio campo next e são reutilizados antes de o
+ *             vetor crescer. Como os elos são índices e não ponteiros, o pool
+ *             pode ser copiado, realocado ou gravado byte a byte sem
+ *             invalidar a estrutura.
+ *
+ * @tparam     Node  Tipo do nodo; precisa de um membro NodeIndex next
+ */
+template<typename Node>
+class IndexNodePool {
+ public:
+    IndexNodePool();
+    explicit IndexNodePool(std::size_t capacity);
+    IndexNodePool(const IndexNodePool& other);
+    ~IndexNodePool();
+
+    IndexNodePool& operator=(const IndexNodePool& other);
+
+    NodeIndex allocate();  // índice de um nodo livre
+    void release(NodeIndex index);  // devolve um nodo ao pool
+    void clear();  // devolve todos os nodos
+
+    void reserve(std::size_t capacity);  // garante espaço para capacity nodos
+    void swap(IndexNodePool& other);  // troca o conteúdo com other
+
+    Node& operator[](NodeIndex index);  // nodo de um índice
+    const Node& operator[](NodeIndex index) const;
+
+    std::size_t size() const;  // nodos em uso
+    std::size_t capacity() const;  // nodos alocados
+    std::size_t bytes_allocated() const;  // bytes do vetor de nodos
+    MemoryUsage memory_usage() const;  // detalhamento da memória
+    Node* data();  // vetor de nodos
+    const Node* data() const;
+
+ private:
+    static const std::size_t DEFAULT_CAPACITY = 8;
+    static const std::size_t MAX_CAPACITY = NIL_INDEX;
+
+    Node* nodes_;
+    std::size_t capacity_;
+    std::size_t used_;  // nodos já entregues alguma vez (início da parte nova)
+    std::size_t size_;
+    NodeIndex free_;  // primeiro nodo da lista de livres
+};
+
+/**
+ *   Construtor padrão da classe IndexNodePool.
+ */
+template<typename Node>
+IndexNodePool<Node>::IndexNodePool() :
+    IndexNodePool(DEFAULT_CAPACITY)
+{}
+
+/**
+ *   Construtor da classe IndexNodePool com capacidade inicial.
+ */
+template<typename Node>
+IndexNodePool<Node>::IndexNodePool(std::size_t capacity) :
+    nodes_{nullptr},
+    capacity_{0},
+    used_{0},
+    size_{0},
+    free_{NIL_INDEX}
+{
+    reserve(capacity > 0 ? capacity : 1);
+}
+
+/**
+ *   Construtor de cópia da classe IndexNodePool: os índices continuam
+ * válidos na cópia.
+ */
+template<typename Node>
+IndexNodePool<Node>::IndexNodePool(const IndexNodePool& other) :
+    nodes_{new Node[other.capacity_]},
+    capacity_{other.capacity_},
+    used_{other.used_},
+    size_{other.size_},
+    free_{other.free_}
+{
+    std::copy(other.nodes_, other.nodes_ + used_, nodes_);
+}
+
+/**
+ *   Destrutor da classe IndexNodePool.
+ */
+template<typename Node>
+IndexNodePool<Node>::~IndexNodePool() {
+    delete [] nodes_;
+}
+
+/**
+ *   Atribuição de cópia da classe IndexNodePool.
+ */
+template<typename Node>
+IndexNodePool<Node>& IndexNodePool<Node>::operator=(const IndexNodePool& other) {
+    if (this != &other) {
+        IndexNodePool copy(other);
+        swap(copy);
+    }
+    return *this;
+}
+
+/**
+ *   Retorna o índice de um nodo livre (IndexNodePool), reutilizando os
+ * liberados antes de crescer o vetor.
+ */
+template<typename Node>
+NodeIndex IndexNodePool<Node>::allocate() {
+    NodeIndex index;
+    if (free_ != NIL_INDEX) {
+        index = free_;
+        free_ = nodes_[index].next;
+    } else {
+        if (used_ == capacity_)
+            reserve(capacity_ * 2);
+        index = static_cast<NodeIndex>(used_++);
+    }
+    size_++;
+    return index;
+}
+
+/**
+ *   Devolve o nodo de index à lista de livres (IndexNodePool).
+ */
+template<typename Node>
+void IndexNodePool<Node>::release(NodeIndex index) {
+    nodes_[index].next = free_;
+    free_ = index;
+    size_--;
+}
+
+/**
+ *   Devolve todos os nodos ao pool (IndexNodePool), mantendo o vetor.
+ */
+template<typename Node>
+void IndexNodePool<Node>::clear() {
+    used_ = 0;
+    size_ = 0;
+    free_ = NIL_INDEX;
+}
+
+/**
+ *   Garante espaço para capacity nodos (IndexNodePool); ao crescer, os nodos
+ * são movidos para o novo vetor e os índices continuam valendo.
+ */
+template<typename Node>
+void IndexNodePool<Node>::reserve(std::size_t capacity) {
+    if (capacity <= capacity_)
+        return;
+    if (capacity > MAX_CAPACITY) {
+        if (capacity_ == MAX_CAPACITY)
+            throw std::out_of_range("Pool de nodos cheio.");
+        capacity = MAX_CAPACITY;
+    }
+
+    Node* nodes = new Node[capacity];
+    std::move(nodes_, nodes_ + used_, nodes);
+    delete [] nodes_;
+    nodes_ = nodes;
+    capacity_ = capacity;
+}
+
+/**
+ *   Troca o conteúdo com other, sem copiar nodos (IndexNodePool).
+ */
+template<typename Node>
+void IndexNodePool<Node>::swap(IndexNodePool& other) {
+    std::swap(nodes_, other.nodes_);
+    std::swap(capacity_, other.capacity_);
+    std::swap(used_, other.used_);
+    std::swap(size_, other.size_);
+    std::swap(free_, other.free_);
+}
+
+/**
+ *   Retorna o nodo de index (IndexNodePool).
+ */
+template<typename Node>
+Node& IndexNodePool<Node>::operator[](NodeIndex index) {
+    return nodes_[index];
+}
+
+/**
+ *   Retorna o nodo de index (IndexNodePool) - versão const.
+ */
+template<typename Node>
+const Node& IndexNodePool<Node>::operator[](NodeIndex index) const {
+    return nodes_[index];
+}
+
+/**
+ *   Retorna a quantidade de nodos em uso (IndexNodePool).
+ */
+template<typename Node>
+std::size_t IndexNodePool<Node>::size() const {
+    return size_;
+}
+
+/**
+ *   Retorna a quantidade de nodos alocados (IndexNodePool).
+ */
+template<typename Node>
+std::size_t IndexNodePool<Node>::capacity() const {
+    return capacity_;
+}
+
+/**
+ *   Retorna os bytes do vetor de nodos (IndexNodePool).
+ */
+template<typename Node>
+std::size_t IndexNodePool<Node>::bytes_allocated() const {
+    return capacity_ * sizeof(Node);
+}
+
+/**
+ *   Retorna o detalhamento da memória ocupada (IndexNodePool); os nodos
+ * livres contam como espaço vazio.
+ */
+template<typename Node>
+MemoryUsage IndexNodePool<Node>::memory_usage() const {
+    return detail::array_usage<Node>(size_, capacity_, bytes_allocated());
+}
+
+/**
+ *   Retorna o vetor de nodos (IndexNodePool).
+ */
+template<typename Node>
+Node* IndexNodePool<Node>::data() {
+    return nodes_;
+}
+
+/**
+ *   Retorna o vetor de nodos (IndexNodePool) - versão const.
+ */
+template<typename Node>
+const Node* IndexNodePool<Node>::data() const {
+    return nodes_;
+}
+
+}  // namespace structures
+
+#endif
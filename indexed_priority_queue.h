@@ -0,0 +1,378 @@
+// Copyright 2017 Letícia do Nascimento
+
+#ifndef STRUCTURES_INDEXED_PRIORITY_QUEUE_H
+#define STRUCTURES_INDEXED_PRIORITY_QUEUE_H
+
+#include <cstdint>
+#include <functional>  // std::less
+#include <stdexcept>  // C++ exception
+
+#include "./array_list.cpp"
+#include "./memory_usage.h"
+#include "./operation_stats.h"
+
+namespace structures {
+
+/**
+ * @brief      Fila de Prioridade indexada: heap d-ário de identificadores
+ *             0..max_size-1, cada um com uma chave. Guarda a posição de cada
+ *             identificador no heap, então a chave de um elemento já inserido
+ *             pode ser alterada (decrease_key) ou ele pode ser removido em
+ *             O(log_d n). O topo é o identificador cuja chave vem primeiro
+ *             segundo Compare (a menor, com std::less).
+ *
+ * @tparam     Key      Tipo da chave de prioridade
+ * @tparam     Arity    Quantidade de filhos por nodo (d)
+ * @tparam     Compare  Ordem de prioridade das chaves
+ * @tparam     Stats    Política de estatísticas; conta o heap, as chaves e as
+ *                      posições, alocados de uma vez no construtor
+ */
+template<typename Key, std::size_t Arity = 4,
+         typename Compare = std::less<Key>, typename Stats = NoStats>
+class IndexedPriorityQueue : private Stats {
+ public:
+    explicit IndexedPriorityQueue(std::size_t max_size);
+    ~IndexedPriorityQueue();
+
+    IndexedPriorityQueue(const IndexedPriorityQueue&) = delete;
+    IndexedPriorityQueue& operator=(const IndexedPriorityQueue&) = delete;
+
+    void clear();  // limpa
+
+    void push(std::size_t id, const Key& key);  // insere id com a chave
+    std::size_t pop();  // retira o id do topo
+    std::size_t top() const;  // id de maior prioridade
+    const Key& top_key() const;  // chave do topo
+
+    void decrease_key(std::size_t id, const Key& key);  // aumenta a prioridade
+    void change_key(std::size_t id, const Key& key);  // muda em qualquer sentido
+    void remove(std::size_t id);  // retira um id qualquer
+
+    bool contains(std::size_t id) const;  // id está na fila
+    const Key& key(std::size_t id) const;  // chave de um id
+
+    bool empty() const;  // fila vazia
+    std::size_t size() const;  // tamanho
+    std::size_t max_size() const;  // tamanho máximo (e limite dos ids)
+
+    StatsSnapshot stats() const;  // contadores de estatísticas
+    void reset_stats();  // zera os contadores
+    std::size_t bytes_allocated() const;  // bytes no heap
+    std::size_t capacity() const;  // dados que cabem sem alocar
+    MemoryUsage memory_usage() const;  // detalhamento da memória
+    // repassa alocações a um observador (só com ObservedStats)
+    void observe(AllocationObserver* observer, const char* site);
+
+ private:
+    static_assert(Arity >= 2, "Heap precisa de pelo menos 2 filhos por nodo.");
+
+    static const std::size_t ABSENT = static_cast<std::size_t>(-1);
+
+    void check(std::size_t id) const {
+        if (id >= max_size_)
+            throw std::out_of_range("Identificador inválido!");
+    }
+
+    void place(std::size_t index, std::size_t id) {
+        heap_[index] = id;
+        position_[id] = index;
+    }
+
+    void sift_up(std::size_t index);  // sobe o id até sua posição
+    void sift_down(std::size_t index);  // desce o id até sua posição
+
+    ArrayList<std::size_t> heap_;  // ids, na ordem do heap
+    Key* keys_;  // chave de cada id
+    std::size_t* position_;  // índice de cada id no heap, ou ABSENT
+    std::size_t max_size_;
+    Compare compare_;
+};
+
+/**
+ *   Construtor da classe IndexedPriorityQueue: ids válidos são
+ * 0..max_size-1.
+ */
+template<typename Key, std::size_t Arity, typename Compare, typename Stats>
+IndexedPriorityQueue<Key, Arity, Compare, Stats>::IndexedPriorityQueue(
+        std::size_t max_size) :
+    heap_(max_size)
+{
+    keys_ = new Key[max_size];
+    position_ = new std::size_t[max_size];
+    max_size_ = max_size;
+    for (std::size_t i = 0; i < max_size_; i++)
+        position_[i] = ABSENT;
+    Stats::allocated(heap_.bytes_allocated());
+    Stats::allocated(max_size_ * sizeof(Key));
+    Stats::allocated(max_size_ * sizeof(std::size_t));
+}
+
+/**
+ *   Destrutor da classe IndexedPriorityQueue.
+ */
+template<typename Key, std::size_t Arity, typename Compare, typename Stats>
+IndexedPriorityQueue<Key, Arity, Compare, Stats>::~IndexedPriorityQueue() {
+    Stats::released(heap_.bytes_allocated());
+    Stats::released(max_size_ * sizeof(Key));
+    Stats::released(max_size_ * sizeof(std::size_t));
+    delete [] keys_;
+    delete [] position_;
+}
+
+/**
+ *   Faz uma limpeza da fila (IndexedPriorityQueue).
+ */
+template<typename Key, std::size_t Arity, typename Compare, typename Stats>
+void IndexedPriorityQueue<Key, Arity, Compare, Stats>::clear() {
+    for (std::size_t i = 0; i < heap_.size(); i++)
+        position_[heap_[i]] = ABSENT;
+    heap_.clear();
+}
+
+/**
+ *   Sobe o id de index enquanto sua chave tem prioridade sobre a do pai
+ * (IndexedPriorityQueue).
+ */
+template<typename Key, std::size_t Arity, typename Compare, typename Stats>
+void IndexedPriorityQueue<Key, Arity, Compare, Stats>::sift_up(
+        std::size_t index) {
+    std::size_t id = heap_[index];
+    while (index > 0) {
+        std::size_t parent = (index - 1) / Arity;
+        if (!compare_(keys_[id], keys_[heap_[parent]]))
+            break;
+        place(index, heap_[parent]);
+        index = parent;
+    }
+    place(index, id);
+}
+
+/**
+ *   Desce o id de index enquanto algum filho tem prioridade sobre ele
+ * (IndexedPriorityQueue).
+ */
+template<typename Key, std::size_t Arity, typename Compare, typename Stats>
+void IndexedPriorityQueue<Key, Arity, Compare, Stats>::sift_down(
+        std::size_t index) {
+    std::size_t size = heap_.size();
+    std::size_t id = heap_[index];
+    while (true) {
+        std::size_t first = index * Arity + 1;
+        if (first >= size)
+            break;
+        std::size_t last = first + Arity < size ? first + Arity : size;
+        std::size_t best = first;
+        for (std::size_t child = first + 1; child < last; child++) {
+            if (compare_(keys_[heap_[child]], keys_[heap_[best]]))
+                best = child;
+        }
+        if (!compare_(keys_[heap_[best]], keys_[id]))
+            break;
+        place(index, heap_[best]);
+        index = best;
+    }
+    place(index, id);
+}
+
+/**
+ *   Insere um id com sua chave (IndexedPriorityQueue).
+ */
+template<typename Key, std::size_t Arity, typename Compare, typename Stats>
+void IndexedPriorityQueue<Key, Arity, Compare, Stats>::push(std::size_t id,
+                                                     const Key& key) {
+    check(id);
+    if (contains(id))
+        throw std::invalid_argument("Identificador já está na fila.");
+
+    keys_[id] = key;
+    heap_.push_back(id);
+    sift_up(heap_.size() - 1);
+}
+
+/**
+ *   Retira e retorna o id de maior prioridade (IndexedPriorityQueue).
+ */
+template<typename Key, std::size_t Arity, typename Compare, typename Stats>
+std::size_t IndexedPriorityQueue<Key, Arity, Compare, Stats>::pop() {
+    std::size_t id = top();
+    remove(id);
+    return id;
+}
+
+/**
+ *   Retorna o id de maior prioridade (IndexedPriorityQueue).
+ */
+template<typename Key, std::size_t Arity, typename Compare, typename Stats>
+std::size_t IndexedPriorityQueue<Key, Arity, Compare, Stats>::top() const {
+    if (empty())
+        throw std::out_of_range("Fila de prioridade vazia.");
+    return heap_[0];
+}
+
+/**
+ *   Retorna a chave do id de maior prioridade (IndexedPriorityQueue).
+ */
+template<typename Key, std::size_t Arity, typename Compare, typename Stats>
+const Key& IndexedPriorityQueue<Key, Arity, Compare, Stats>::top_key() const {
+    return keys_[top()];
+}
+
+/**
+ *   Dá ao id uma chave de prioridade maior ou igual à atual
+ * (IndexedPriorityQueue); o id só pode subir no heap.
+ */
+template<typename Key, std::size_t Arity, typename Compare, typename Stats>
+void IndexedPriorityQueue<Key, Arity, Compare, Stats>::decrease_key(
+        std::size_t id, const Key& key) {
+    if (!contains(id))
+        throw std::out_of_range("Identificador não está na fila.");
+    if (compare_(keys_[id], key))
+        throw std::invalid_argument("Nova chave tem prioridade menor.");
+
+    keys_[id] = key;
+    sift_up(position_[id]);
+}
+
+/**
+ *   Muda a chave de um id em qualquer sentido (IndexedPriorityQueue).
+ */
+template<typename Key, std::size_t Arity, typename Compare, typename Stats>
+void IndexedPriorityQueue<Key, Arity, Compare, Stats>::change_key(
+        std::size_t id, const Key& key) {
+    if (!contains(id))
+        throw std::out_of_range("Identificador não está na fila.");
+
+    keys_[id] = key;
+    sift_up(position_[id]);
+    sift_down(position_[id]);
+}
+
+/**
+ *   Retira um id qualquer da fila (IndexedPriorityQueue).
+ */
+template<typename Key, std::size_t Arity, typename Compare, typename Stats>
+void IndexedPriorityQueue<Key, Arity, Compare, Stats>::remove(std::size_t id) {
+    if (!contains(id))
+        throw std::out_of_range("Identificador não está na fila.");
+
+    std::size_t index = position_[id];
+    std::size_t last = heap_.pop_back();
+    position_[id] = ABSENT;
+    if (last == id)
+        return;
+
+    place(index, last);
+    sift_up(index);
+    sift_down(position_[last]);
+}
+
+/**
+ *   Verifica se o id está na fila (IndexedPriorityQueue).
+ */
+template<typename Key, std::size_t Arity, typename Compare, typename Stats>
+bool IndexedPriorityQueue<Key, Arity, Compare, Stats>::contains(
+        std::size_t id) const {
+    check(id);
+    return position_[id] != ABSENT;
+}
+
+/**
+ *   Retorna a chave de um id que está na fila (IndexedPriorityQueue).
+ */
+template<typename Key, std::size_t Arity, typename Compare, typename Stats>
+const Key& IndexedPriorityQueue<Key, Arity, Compare, Stats>::key(
+        std::size_t id) const {
+    if (!contains(id))
+        throw std::out_of_range("Identificador não está na fila.");
+    return keys_[id];
+}
+
+/**
+ *   Verifica se a fila (IndexedPriorityQueue) está vazia.
+ */
+template<typename Key, std::size_t Arity, typename Compare, typename Stats>
+bool IndexedPriorityQueue<Key, Arity, Compare, Stats>::empty() const {
+    return heap_.empty();
+}
+
+/**
+ *   Retorna o tamanho da fila (IndexedPriorityQueue).
+ */
+template<typename Key, std::size_t Arity, typename Compare, typename Stats>
+std::size_t IndexedPriorityQueue<Key, Arity, Compare, Stats>::size() const {
+    return heap_.size();
+}
+
+/**
+ *   Retorna o tamanho máximo da fila (IndexedPriorityQueue).
+ */
+template<typename Key, std::size_t Arity, typename Compare, typename Stats>
+std::size_t IndexedPriorityQueue<Key, Arity, Compare, Stats>::max_size() const {
+    return max_size_;
+}
+
+/**
+ *   Retorna os contadores da política de estatísticas (IndexedPriorityQueue).
+ */
+template<typename Key, std::size_t Arity, typename Compare,
+         typename Stats>
+StatsSnapshot IndexedPriorityQueue<Key, Arity, Compare, Stats>::stats() const {
+    return Stats::snapshot();
+}
+
+/**
+ *   Zera os contadores da política de estatísticas (IndexedPriorityQueue).
+ */
+template<typename Key, std::size_t Arity, typename Compare,
+         typename Stats>
+void IndexedPriorityQueue<Key, Arity, Compare, Stats>::reset_stats() {
+    Stats::reset();
+}
+
+/**
+ *   Retorna os bytes no heap: o vetor de ids, as chaves e as posições
+ * (IndexedPriorityQueue).
+ */
+template<typename Key, std::size_t Arity, typename Compare,
+         typename Stats>
+std::size_t
+IndexedPriorityQueue<Key, Arity, Compare, Stats>::bytes_allocated() const {
+    return heap_.bytes_allocated() +
+           max_size_ * (sizeof(Key) + sizeof(std::size_t));
+}
+
+/**
+ *   Retorna quantos ids cabem na fila (IndexedPriorityQueue).
+ */
+template<typename Key, std::size_t Arity, typename Compare,
+         typename Stats>
+std::size_t IndexedPriorityQueue<Key, Arity, Compare, Stats>::capacity() const {
+    return max_size_;
+}
+
+/**
+ *   Retorna o detalhamento da memória ocupada (IndexedPriorityQueue); a
+ * chave é o dado, e o vetor de ids e o de posições contam como elos.
+ */
+template<typename Key, std::size_t Arity, typename Compare,
+         typename Stats>
+MemoryUsage
+IndexedPriorityQueue<Key, Arity, Compare, Stats>::memory_usage() const {
+    return detail::block_usage<Key>(heap_.size(), max_size_, 0,
+                                    bytes_allocated());
+}
+
+/**
+ *   Repassa as alocações ao observador com o rótulo site
+ * (IndexedPriorityQueue); exige a política ObservedStats.
+ */
+template<typename Key, std::size_t Arity, typename Compare,
+         typename Stats>
+void IndexedPriorityQueue<Key, Arity, Compare, Stats>::observe(
+        AllocationObserver* observer, const char* site) {
+    Stats::observe(observer, site);
+}
+
+}  // namespace structures
+
+#endif
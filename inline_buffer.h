@@ -0,0 +1,45 @@
+//  Copyright 2017 Letícia do Nascimento
+
+#ifndef STRUCTURES_INLINE_BUFFER_H
+#define STRUCTURES_INLINE_BUFFER_H
+
+#include <cstdint>  // std::size_t
+
+namespace structures {
+
+    /**
+     * @brief      Buffer de capacidade fixa guardado dentro do próprio objeto,
+     *             usado pelos containers de vetor para evitar a alocação no
+     *             heap enquanto eles têm poucos elementos.
+     *
+     * @tparam     T     Parâmetro genérico de Template
+     * @tparam     N     Quantidade de elementos guardados no objeto
+     */
+    template<typename T, std::size_t N>
+    class InlineBuffer {
+        public:
+            T* data() { return contents; }
+
+            const T* data() const { return contents; }
+
+            static constexpr std::size_t capacity() { return N; }
+
+        private:
+            T contents[N];
+    };
+
+    //  sem buffer interno: o container sempre usa o heap
+
+    template<typename T>
+    class InlineBuffer<T, 0> {
+        public:
+            T* data() { return nullptr; }
+
+            const T* data() const { return nullptr; }
+
+            static constexpr std::size_t capacity() { return 0; }
+    };
+
+}  // namespace structures
+
+#endif
@@ -0,0 +1,320 @@
+// Copyright 2017 Letícia do Nascimento
+
+#ifndef STRUCTURES_INTRUSIVE_DOUBLY_LINKED_LIST_H
+#define STRUCTURES_INTRUSIVE_DOUBLY_LINKED_LIST_H
+
+#include <cstdint>
+#include <stdexcept>  // C++ exception
+
+#include "./intrusive_hook.h"
+
+namespace structures {
+
+/**
+ * @brief      Implementação de uma Lista Duplamente Encadeada intrusiva. Os
+ *             ponteiros prev/next (DoublyListHook) ficam no objeto do
+ *             usuário: inserir não aloca nem copia, e um objeto pode ser
+ *             desligado em O(1) a partir do seu próprio gancho.
+ *
+ * @tparam     T         Tipo dos objetos encadeados
+ * @tparam     Accessor  Forma de acesso ao gancho (BaseHook ou MemberHook)
+ */
+template<typename T, typename Accessor = BaseHook<T, DoublyListHook<T>>>
+class IntrusiveDoublyLinkedList {
+ public:
+    IntrusiveDoublyLinkedList();
+    ~IntrusiveDoublyLinkedList();
+    void clear();
+
+    void push_back(T& data);  // liga no fim
+    void push_front(T& data);  // liga no início
+    void insert(T& data, std::size_t index);  // liga na posição
+    void insert_sorted(T& data);  // liga em ordem
+
+    T& pop(std::size_t index);  // desliga da posição
+    T& pop_back();  // desliga do fim
+    T& pop_front();  // desliga do início
+    void remove(T& data);  // desliga o objeto em O(1)
+
+    bool empty() const;  // lista vazia
+    bool contains(const T& data) const;  // contém
+
+    T& at(std::size_t index);  // acesso a um elemento (checando limites)
+    T& front();  // primeiro objeto
+    T& back();  // último objeto
+
+    std::size_t find(const T& data) const;  // posição de um objeto
+    std::size_t size() const;  // tamanho
+
+ private:
+    static T* prev(T* node) { return Accessor::get(*node).prev(); }
+    static void prev(T* node, T* prev) { Accessor::get(*node).prev(prev); }
+    static T* next(T* node) { return Accessor::get(*node).next(); }
+    static void next(T* node, T* next) { Accessor::get(*node).next(next); }
+
+    // nodo na posição, partindo da ponta mais próxima
+    T* node_at(std::size_t index) {
+        T* current;
+        if (index < size_ / 2) {
+            current = head;
+            for (std::size_t i = 0; i < index; i++)
+                current = next(current);
+        } else {
+            current = tail;
+            for (std::size_t i = size_ - 1; i > index; i--)
+                current = prev(current);
+        }
+        return current;
+    }
+
+    T* head{nullptr};
+    T* tail{nullptr};
+    std::size_t size_{0u};
+};
+
+/**
+ *   Construtor padrão da classe IntrusiveDoublyLinkedList.
+ */
+template<typename T, typename Accessor>
+IntrusiveDoublyLinkedList<T, Accessor>::IntrusiveDoublyLinkedList() {
+    head = nullptr;
+    tail = nullptr;
+    size_ = 0;
+}
+
+/**
+ *   Destrutor padrão da classe IntrusiveDoublyLinkedList. Apenas desliga os
+ * objetos, que continuam pertencendo ao usuário.
+ */
+template<typename T, typename Accessor>
+IntrusiveDoublyLinkedList<T, Accessor>::~IntrusiveDoublyLinkedList() {
+    clear();
+}
+
+/**
+ *   Desliga todos os objetos da lista (IntrusiveDoublyLinkedList).
+ */
+template<typename T, typename Accessor>
+void IntrusiveDoublyLinkedList<T, Accessor>::clear() {
+    while (!empty()) {
+        pop_front();
+    }
+}
+
+/**
+ *   Verifica se a lista (IntrusiveDoublyLinkedList) está vazia.
+ */
+template<typename T, typename Accessor>
+bool IntrusiveDoublyLinkedList<T, Accessor>::empty() const {
+    return size_ == 0;
+}
+
+/**
+ *   Verifica e retorna o tamanho da lista (IntrusiveDoublyLinkedList).
+ */
+template<typename T, typename Accessor>
+std::size_t IntrusiveDoublyLinkedList<T, Accessor>::size() const {
+    return size_;
+}
+
+/**
+ *   Liga um objeto no fim da lista (IntrusiveDoublyLinkedList), em O(1).
+ */
+template<typename T, typename Accessor>
+void IntrusiveDoublyLinkedList<T, Accessor>::push_back(T& data) {
+    prev(&data, tail);
+    next(&data, nullptr);
+    if (tail != nullptr)
+        next(tail, &data);
+    else
+        head = &data;
+    tail = &data;
+    size_++;
+}
+
+/**
+ *   Liga um objeto no começo da lista (IntrusiveDoublyLinkedList), em O(1).
+ */
+template<typename T, typename Accessor>
+void IntrusiveDoublyLinkedList<T, Accessor>::push_front(T& data) {
+    prev(&data, nullptr);
+    next(&data, head);
+    if (head != nullptr)
+        prev(head, &data);
+    else
+        tail = &data;
+    head = &data;
+    size_++;
+}
+
+/**
+ *   Liga um objeto no índice específico da lista (IntrusiveDoublyLinkedList).
+ */
+template<typename T, typename Accessor>
+void IntrusiveDoublyLinkedList<T, Accessor>::insert(T& data,
+                                                    std::size_t index) {
+    if (index > size_)
+        throw std::out_of_range("Índice inválido");
+    if (index == 0)
+        return push_front(data);
+    if (index == size_)
+        return push_back(data);
+
+    T* current = node_at(index);
+    T* previous = prev(current);
+    prev(&data, previous);
+    next(&data, current);
+    next(previous, &data);
+    prev(current, &data);
+    size_++;
+}
+
+/**
+ *   Liga um objeto na ordem definida pela lista (IntrusiveDoublyLinkedList).
+ */
+template<typename T, typename Accessor>
+void IntrusiveDoublyLinkedList<T, Accessor>::insert_sorted(T& data) {
+    T* current = head;
+    while (current != nullptr && data > *current)
+        current = next(current);
+
+    if (current == nullptr)
+        return push_back(data);
+    if (current == head)
+        return push_front(data);
+
+    T* previous = prev(current);
+    prev(&data, previous);
+    next(&data, current);
+    next(previous, &data);
+    prev(current, &data);
+    size_++;
+}
+
+/**
+ *   Retorna o objeto numa posição específica da lista
+ * (IntrusiveDoublyLinkedList).
+ */
+template<typename T, typename Accessor>
+T& IntrusiveDoublyLinkedList<T, Accessor>::at(std::size_t index) {
+    if (index >= size_)
+        throw std::out_of_range("Índice inválido!");
+    return *node_at(index);
+}
+
+/**
+ *   Retorna o primeiro objeto da lista (IntrusiveDoublyLinkedList).
+ */
+template<typename T, typename Accessor>
+T& IntrusiveDoublyLinkedList<T, Accessor>::front() {
+    if (empty())
+        throw std::out_of_range("Lista vazia!");
+    return *head;
+}
+
+/**
+ *   Retorna o último objeto da lista (IntrusiveDoublyLinkedList).
+ */
+template<typename T, typename Accessor>
+T& IntrusiveDoublyLinkedList<T, Accessor>::back() {
+    if (empty())
+        throw std::out_of_range("Lista vazia!");
+    return *tail;
+}
+
+/**
+ *   Desliga o objeto de uma posição da lista (IntrusiveDoublyLinkedList).
+ */
+template<typename T, typename Accessor>
+T& IntrusiveDoublyLinkedList<T, Accessor>::pop(std::size_t index) {
+    if (empty())
+        throw std::out_of_range("Lista vazia!");
+    if (index >= size_)
+        throw std::out_of_range("Índice inválido!");
+
+    T* current = node_at(index);
+    remove(*current);
+    return *current;
+}
+
+/**
+ *   Desliga o último objeto da lista (IntrusiveDoublyLinkedList).
+ */
+template<typename T, typename Accessor>
+T& IntrusiveDoublyLinkedList<T, Accessor>::pop_back() {
+    if (empty())
+        throw std::out_of_range("Lista vazia!");
+    T* last = tail;
+    remove(*last);
+    return *last;
+}
+
+/**
+ *   Desliga o primeiro objeto da lista (IntrusiveDoublyLinkedList).
+ */
+template<typename T, typename Accessor>
+T& IntrusiveDoublyLinkedList<T, Accessor>::pop_front() {
+    if (empty())
+        throw std::out_of_range("Lista vazia!");
+    T* first = head;
+    remove(*first);
+    return *first;
+}
+
+/**
+ *   Desliga um objeto da lista (IntrusiveDoublyLinkedList) em O(1), usando
+ * apenas o seu gancho. Lança std::out_of_range se o objeto está desligado ou,
+ * nas pontas, ligado a outra lista.
+ */
+template<typename T, typename Accessor>
+void IntrusiveDoublyLinkedList<T, Accessor>::remove(T& data) {
+    T* previous = prev(&data);
+    T* following = next(&data);
+    if ((previous == nullptr && head != &data) ||
+        (following == nullptr && tail != &data) ||
+        (previous != nullptr && next(previous) != &data) ||
+        (following != nullptr && prev(following) != &data))
+        throw std::out_of_range("Objeto não está ligado a esta lista!");
+
+    if (previous != nullptr)
+        next(previous, following);
+    else
+        head = following;
+
+    if (following != nullptr)
+        prev(following, previous);
+    else
+        tail = previous;
+
+    prev(&data, nullptr);
+    next(&data, nullptr);
+    size_--;
+}
+
+/**
+ *   Verifica se o objeto está ligado a esta lista
+ * (IntrusiveDoublyLinkedList).
+ */
+template<typename T, typename Accessor>
+bool IntrusiveDoublyLinkedList<T, Accessor>::contains(const T& data) const {
+    return find(data) != size_;
+}
+
+/**
+ *   Retorna a posição do objeto na lista (IntrusiveDoublyLinkedList),
+ * comparando por identidade. Retorna size() quando não encontrado.
+ */
+template<typename T, typename Accessor>
+std::size_t IntrusiveDoublyLinkedList<T, Accessor>::find(const T& data) const {
+    const T* current = head;
+    for (std::size_t i = 0; i < size_; i++) {
+        if (current == &data)
+            return i;
+        current = Accessor::get(*current).next();
+    }
+    return size_;
+}
+
+}  // namespace structures
+
+#endif
@@ -0,0 +1,134 @@
+// Copyright 2017 Letícia do Nascimento
+
+#ifndef STRUCTURES_INTRUSIVE_HOOK_H
+#define STRUCTURES_INTRUSIVE_HOOK_H
+
+namespace structures {
+
+/**
+ * @brief      Gancho (hook) de encadeamento simples para estruturas
+ *             intrusivas. Deve ser embutido no tipo do usuário, seja como
+ *             classe base ou como membro.
+ *
+ * @tparam     T     Tipo do objeto que contém o gancho
+ */
+template<typename T>
+class ListHook {
+ public:
+    ListHook() = default;
+    //  a cópia nasce desligada: os elos são da estrutura, não do objeto
+    ListHook(const ListHook&) { }
+    ListHook& operator=(const ListHook&) { return *this; }
+
+    T* next() { return next_; }  // getter: próximo
+    const T* next() const { return next_; }  // getter-constante: próximo
+    void next(T* node) { next_ = node; }  // setter: próximo
+
+ private:
+    T* next_{nullptr};
+};
+
+/**
+ * @brief      Gancho (hook) de encadeamento duplo para estruturas
+ *             intrusivas. Permite desligar o objeto em O(1).
+ *
+ * @tparam     T     Tipo do objeto que contém o gancho
+ */
+template<typename T>
+class DoublyListHook {
+ public:
+    DoublyListHook() = default;
+    //  a cópia nasce desligada: os elos são da estrutura, não do objeto
+    DoublyListHook(const DoublyListHook&) { }
+    DoublyListHook& operator=(const DoublyListHook&) { return *this; }
+
+    T* prev() { return prev_; }  // getter: anterior
+    const T* prev() const { return prev_; }  // getter-constante: anterior
+    void prev(T* node) { prev_ = node; }  // setter: anterior
+
+    T* next() { return next_; }  // getter: próximo
+    const T* next() const { return next_; }  // getter-constante: próximo
+    void next(T* node) { next_ = node; }  // setter: próximo
+
+ private:
+    T* prev_{nullptr};
+    T* next_{nullptr};
+};
+
+/**
+ * @brief      Gancho (hook) para anéis intrusivos com sentinela, como o de
+ *             uma CircularList duplamente encadeada: o sentinela aponta para
+ *             si mesmo quando o anel está vazio, então ligar e desligar são
+ *             O(1) e não tratam pontas. Um gancho fora de qualquer anel tem
+ *             os ponteiros nulos.
+ */
+class RingHook {
+ public:
+    RingHook() = default;
+    //  a cópia nasce desligada: os elos são do anel, não do objeto
+    RingHook(const RingHook&) { }
+    RingHook& operator=(const RingHook&) { return *this; }
+
+    RingHook* prev() { return prev_; }  // getter: anterior
+    RingHook* next() { return next_; }  // getter: próximo
+
+    bool linked() const { return next_ != nullptr; }  // está num anel?
+
+    //  transforma o gancho no sentinela de um anel vazio
+    void make_sentinel() { prev_ = next_ = this; }
+    //  sentinela sem outros ganchos no anel?
+    bool alone() const { return next_ == this; }
+
+    //  liga este gancho antes de position (no fim, se position é o sentinela)
+    void link_before(RingHook* position) {
+        prev_ = position->prev_;
+        next_ = position;
+        prev_->next_ = this;
+        position->prev_ = this;
+    }
+
+    //  desliga este gancho do anel
+    void unlink() {
+        prev_->next_ = next_;
+        next_->prev_ = prev_;
+        prev_ = next_ = nullptr;
+    }
+
+    //  passa todos os ganchos do anel de source (sentinela) para este
+    //  sentinela, que deve estar vazio; source fica vazio
+    void take_ring(RingHook* source) {
+        if (source->alone())
+            return make_sentinel();
+        prev_ = source->prev_;
+        next_ = source->next_;
+        prev_->next_ = this;
+        next_->prev_ = this;
+        source->make_sentinel();
+    }
+
+ private:
+    RingHook* prev_{nullptr};
+    RingHook* next_{nullptr};
+};
+
+/**
+ * @brief      Acesso ao gancho quando o tipo do usuário herda de Hook.
+ */
+template<typename T, typename Hook>
+struct BaseHook {
+    static Hook& get(T& data) { return data; }
+    static const Hook& get(const T& data) { return data; }
+};
+
+/**
+ * @brief      Acesso ao gancho quando ele é um membro do tipo do usuário.
+ */
+template<typename T, typename Hook, Hook T::*Member>
+struct MemberHook {
+    static Hook& get(T& data) { return data.*Member; }
+    static const Hook& get(const T& data) { return data.*Member; }
+};
+
+}  // namespace structures
+
+#endif
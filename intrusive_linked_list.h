@@ -0,0 +1,258 @@
+// Copyright 2017 Letícia do Nascimento
+
+#ifndef STRUCTURES_INTRUSIVE_LINKED_LIST_H
+#define STRUCTURES_INTRUSIVE_LINKED_LIST_H
+
+#include <cstdint>
+#include <stdexcept>  // C++ exception
+
+#include "./intrusive_hook.h"
+
+namespace structures {
+
+/**
+ * @brief      Implementação de uma Lista Encadeada intrusiva. O encadeamento
+ *             (ListHook) fica embutido no próprio objeto do usuário, então
+ *             inserir não aloca nem copia o dado. A lista não é dona dos
+ *             objetos: eles devem viver mais que a lista ou ser removidos
+ *             antes de destruídos.
+ *
+ * @tparam     T         Tipo dos objetos encadeados
+ * @tparam     Accessor  Forma de acesso ao gancho (BaseHook ou MemberHook)
+ */
+template<typename T, typename Accessor = BaseHook<T, ListHook<T>>>
+class IntrusiveLinkedList {
+ public:
+    IntrusiveLinkedList();
+    ~IntrusiveLinkedList();
+    void clear();
+    void push_back(T& data);
+    void push_front(T& data);
+    void insert(T& data, std::size_t index);
+    void insert_sorted(T& data);
+    T& at(std::size_t index);
+    T& pop(std::size_t index);
+    T& pop_back();
+    T& pop_front();
+    void remove(T& data);
+    bool empty() const;
+    bool contains(const T& data) const;
+    std::size_t find(const T& data) const;
+    std::size_t size() const;
+
+ private:
+    static T* next(T* node) { return Accessor::get(*node).next(); }
+    static void next(T* node, T* next) { Accessor::get(*node).next(next); }
+
+    T* head{nullptr};
+    T* tail{nullptr};
+    std::size_t size_{0u};
+};
+
+/**
+ *   Construtor padrão da classe IntrusiveLinkedList.
+ */
+template<typename T, typename Accessor>
+IntrusiveLinkedList<T, Accessor>::IntrusiveLinkedList() {
+    head = nullptr;
+    tail = nullptr;
+    size_ = 0;
+}
+
+/**
+ *   Destrutor padrão da classe IntrusiveLinkedList. Apenas desliga os
+ * objetos, que continuam pertencendo ao usuário.
+ */
+template<typename T, typename Accessor>
+IntrusiveLinkedList<T, Accessor>::~IntrusiveLinkedList() {
+    clear();
+}
+
+/**
+ *   Desliga todos os objetos da lista (IntrusiveLinkedList).
+ */
+template<typename T, typename Accessor>
+void IntrusiveLinkedList<T, Accessor>::clear() {
+    while (!empty()) {
+        pop_front();
+    }
+}
+
+/**
+ *   Verifica se a lista (IntrusiveLinkedList) está vazia.
+ */
+template<typename T, typename Accessor>
+bool IntrusiveLinkedList<T, Accessor>::empty() const {
+    return size_ == 0;
+}
+
+/**
+ *   Verifica e retorna o tamanho da lista (IntrusiveLinkedList).
+ */
+template<typename T, typename Accessor>
+std::size_t IntrusiveLinkedList<T, Accessor>::size() const {
+    return size_;
+}
+
+/**
+ *   Liga um objeto no fim da lista (IntrusiveLinkedList), em O(1).
+ */
+template<typename T, typename Accessor>
+void IntrusiveLinkedList<T, Accessor>::push_back(T& data) {
+    if (empty())
+        return push_front(data);
+
+    next(&data, nullptr);
+    next(tail, &data);
+    tail = &data;
+    size_++;
+}
+
+/**
+ *   Liga um objeto no começo da lista (IntrusiveLinkedList).
+ */
+template<typename T, typename Accessor>
+void IntrusiveLinkedList<T, Accessor>::push_front(T& data) {
+    next(&data, head);
+    head = &data;
+    if (tail == nullptr)
+        tail = &data;
+    size_++;
+}
+
+/**
+ *   Liga um objeto no índice específico da lista (IntrusiveLinkedList).
+ */
+template<typename T, typename Accessor>
+void IntrusiveLinkedList<T, Accessor>::insert(T& data, std::size_t index) {
+    if (index > size_)
+        throw std::out_of_range("Índice inválido");
+    if (index == 0)
+        return push_front(data);
+    if (index == size_)
+        return push_back(data);
+
+    T* anterior = head;
+    for (std::size_t i = 0; i < index - 1; i++)
+        anterior = next(anterior);
+    next(&data, next(anterior));
+    next(anterior, &data);
+    size_++;
+}
+
+/**
+ *   Liga um objeto na ordem definida pela lista (IntrusiveLinkedList).
+ */
+template<typename T, typename Accessor>
+void IntrusiveLinkedList<T, Accessor>::insert_sorted(T& data) {
+    std::size_t i = 0;
+    T* current = head;
+    while (i < size_ && data > *current) {
+        current = next(current);
+        i++;
+    }
+    insert(data, i);
+}
+
+/**
+ *   Retorna o objeto numa posição específica da lista (IntrusiveLinkedList).
+ */
+template<typename T, typename Accessor>
+T& IntrusiveLinkedList<T, Accessor>::at(std::size_t index) {
+    if (index >= size_)
+        throw std::out_of_range("Índice inválido!");
+
+    T* current = head;
+    for (std::size_t i = 0; i < index; i++)
+        current = next(current);
+    return *current;
+}
+
+/**
+ *   Desliga o objeto de uma posição da lista (IntrusiveLinkedList).
+ */
+template<typename T, typename Accessor>
+T& IntrusiveLinkedList<T, Accessor>::pop(std::size_t index) {
+    if (empty())
+        throw std::out_of_range("Lista vazia!");
+    if (index >= size_)
+        throw std::out_of_range("Índice inválido!");
+    if (index == 0)
+        return pop_front();
+
+    T* anterior = head;
+    for (std::size_t i = 0; i < index - 1; i++)
+        anterior = next(anterior);
+    T* atual = next(anterior);
+    next(anterior, next(atual));
+    if (atual == tail)
+        tail = anterior;
+    next(atual, nullptr);
+    size_--;
+    return *atual;
+}
+
+/**
+ *   Desliga o último objeto da lista (IntrusiveLinkedList).
+ */
+template<typename T, typename Accessor>
+T& IntrusiveLinkedList<T, Accessor>::pop_back() {
+    if (empty())
+        throw std::out_of_range("Lista vazia!");
+    return pop(size_ - 1);
+}
+
+/**
+ *   Desliga o primeiro objeto da lista (IntrusiveLinkedList).
+ */
+template<typename T, typename Accessor>
+T& IntrusiveLinkedList<T, Accessor>::pop_front() {
+    if (empty())
+        throw std::out_of_range("Lista vazia!");
+
+    T* anterior = head;
+    head = next(anterior);
+    if (head == nullptr)
+        tail = nullptr;
+    next(anterior, nullptr);
+    size_--;
+    return *anterior;
+}
+
+/**
+ *   Desliga um objeto específico da lista (IntrusiveLinkedList). Por ser
+ * simplesmente encadeada, precisa percorrer até o anterior.
+ */
+template<typename T, typename Accessor>
+void IntrusiveLinkedList<T, Accessor>::remove(T& data) {
+    std::size_t index = find(data);
+    if (index != size_)
+        pop(index);
+}
+
+/**
+ *   Verifica se o objeto está ligado a esta lista (IntrusiveLinkedList).
+ */
+template<typename T, typename Accessor>
+bool IntrusiveLinkedList<T, Accessor>::contains(const T& data) const {
+    return find(data) != size_;
+}
+
+/**
+ *   Retorna a posição do objeto na lista (IntrusiveLinkedList), comparando
+ * por identidade. Retorna size() quando o objeto não está na lista.
+ */
+template<typename T, typename Accessor>
+std::size_t IntrusiveLinkedList<T, Accessor>::find(const T& data) const {
+    const T* current = head;
+    for (std::size_t i = 0; i < size_; i++) {
+        if (current == &data)
+            return i;
+        current = Accessor::get(*current).next();
+    }
+    return size_;
+}
+
+}  // namespace structures
+
+#endif
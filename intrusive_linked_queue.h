@@ -0,0 +1,148 @@
+// Copyright 2017 Letícia do Nascimento
+
+#ifndef STRUCTURES_INTRUSIVE_LINKED_QUEUE_H
+#define STRUCTURES_INTRUSIVE_LINKED_QUEUE_H
+
+#include <cstdint>
+#include <stdexcept>  // C++ exception
+
+#include "./intrusive_hook.h"
+
+namespace structures {
+
+    /**
+     * @brief      Implementação de uma Fila encadeada intrusiva (FIFO). O
+     *             ponteiro next (ListHook) fica no objeto do usuário, então
+     *             enfileirar não aloca nem copia o dado.
+     *
+     * @tparam     T         Tipo dos objetos enfileirados
+     * @tparam     Accessor  Forma de acesso ao gancho (BaseHook ou MemberHook)
+     */
+
+template<typename T, typename Accessor = BaseHook<T, ListHook<T>>>
+class IntrusiveLinkedQueue {
+ public:
+    IntrusiveLinkedQueue();
+
+    ~IntrusiveLinkedQueue();
+
+    void clear();  // limpar
+
+    void enqueue(T& data);  // enfileirar
+
+    T& dequeue();  // desenfileirar
+
+    T& front() const;  // primeiro objeto
+
+    T& back() const;  // último objeto
+
+    bool empty() const;  // fila vazia
+
+    std::size_t size() const;  // tamanho
+
+ private:
+    static T* next(T* node) { return Accessor::get(*node).next(); }
+    static void next(T* node, T* next) { Accessor::get(*node).next(next); }
+
+    T* head;  // objeto-cabeça
+    T* tail;  // objeto-fim
+    std::size_t size_;  // tamanho
+};
+
+/**
+ *   Construtor padrão da classe IntrusiveLinkedQueue.
+ */
+template<typename T, typename Accessor>
+IntrusiveLinkedQueue<T, Accessor>::IntrusiveLinkedQueue() {
+    head = nullptr;
+    tail = nullptr;
+    size_ = 0;
+}
+
+/**
+ *   Destrutor padrão da classe IntrusiveLinkedQueue.
+ */
+template<typename T, typename Accessor>
+IntrusiveLinkedQueue<T, Accessor>::~IntrusiveLinkedQueue() {
+    clear();
+}
+
+/**
+ *   Desliga todos os objetos da fila (IntrusiveLinkedQueue).
+ */
+template<typename T, typename Accessor>
+void IntrusiveLinkedQueue<T, Accessor>::clear() {
+    while (!empty()) {
+        dequeue();
+    }
+}
+
+/**
+ *   Verifica se a fila (IntrusiveLinkedQueue) está vazia.
+ */
+template<typename T, typename Accessor>
+bool IntrusiveLinkedQueue<T, Accessor>::empty() const {
+    return size_ == 0;
+}
+
+/**
+ *   Verifica e retorna o tamanho da fila (IntrusiveLinkedQueue).
+ */
+template<typename T, typename Accessor>
+std::size_t IntrusiveLinkedQueue<T, Accessor>::size() const {
+    return size_;
+}
+
+/**
+ *   Liga um objeto no fim da fila (IntrusiveLinkedQueue).
+ */
+template<typename T, typename Accessor>
+void IntrusiveLinkedQueue<T, Accessor>::enqueue(T& data) {
+    next(&data, nullptr);
+    if (size_ == 0)
+        head = &data;
+    else
+        next(tail, &data);
+    tail = &data;
+    size_++;
+}
+
+/**
+ *   Desliga e retorna o primeiro objeto da fila (IntrusiveLinkedQueue).
+ */
+template<typename T, typename Accessor>
+T& IntrusiveLinkedQueue<T, Accessor>::dequeue() {
+    if (empty())
+        throw std::out_of_range("Fila vazia!");
+    if (size_ == 1)
+        tail = nullptr;
+    T* left_ = head;
+    head = next(left_);
+    next(left_, nullptr);
+    size_--;
+    return *left_;
+}
+
+/**
+ *   Retorna o primeiro objeto da fila (IntrusiveLinkedQueue).
+ */
+template<typename T, typename Accessor>
+T& IntrusiveLinkedQueue<T, Accessor>::front() const {
+    if (empty())
+        throw std::out_of_range("Fila vazia.");
+    return *head;
+}
+
+/**
+ *   Retorna o último objeto da fila (IntrusiveLinkedQueue).
+ */
+template<typename T, typename Accessor>
+T& IntrusiveLinkedQueue<T, Accessor>::back() const {
+    if (empty())
+        throw std::out_of_range("Fila vazia.");
+    return *tail;
+}
+
+}  // namespace structures
+
+#endif
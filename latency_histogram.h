@@ -0,0 +1,221 @@
+// Copyright 2017 Letícia do Nascimento
+
+#ifndef STRUCTURES_LATENCY_HISTOGRAM_H
+#define STRUCTURES_LATENCY_HISTOGRAM_H
+
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+
+namespace structures {
+
+/**
+ * @brief      Histograma log-linear de valores inteiros (latências em
+ *             nanossegundos, por exemplo), no estilo do HdrHistogram. Cada
+ *             potência de 2 é dividida em 2^SubBits faixas iguais, então o
+ *             erro relativo de um percentil é no máximo 2^-SubBits. Registrar
+ *             é um incremento atômico relaxado, sem travas nem alocação; as
+ *             consultas podem correr junto com os registros e veem um estado
+ *             aproximado.
+ *
+ * @tparam     SubBits  Bits de precisão dentro de cada potência de 2
+ */
+template<unsigned SubBits = 5>
+class LatencyHistogram {
+ public:
+    LatencyHistogram();
+
+    LatencyHistogram(const LatencyHistogram&) = delete;
+    LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+    void record(std::uint64_t value);  // registra um valor
+    void reset();  // zera o histograma
+
+    std::uint64_t count() const;  // valores registrados
+    std::uint64_t min() const;  // menor valor (0 se vazio)
+    std::uint64_t max() const;  // maior valor
+    double mean() const;  // média exata
+    std::uint64_t percentile(double percent) const;  // ex.: 99.9
+
+    template<typename Function>
+    void for_each_bucket(Function function) const;  // (menor, maior, contagem)
+
+ private:
+    static_assert(SubBits >= 1 && SubBits <= 16, "SubBits fora do intervalo.");
+
+    static const std::uint64_t SUB_COUNT = std::uint64_t(1) << SubBits;
+    static const std::size_t BUCKETS = (64 - SubBits + 1) * SUB_COUNT;
+
+    static std::size_t index_of(std::uint64_t value);
+    static std::uint64_t lowest(std::size_t index);  // menor valor da faixa
+    static std::uint64_t highest(std::size_t index);  // maior valor da faixa
+
+    std::atomic<std::uint64_t> counts_[BUCKETS];
+    std::atomic<std::uint64_t> count_;
+    std::atomic<std::uint64_t> sum_;
+    std::atomic<std::uint64_t> min_;
+    std::atomic<std::uint64_t> max_;
+};
+
+/**
+ *   Construtor da classe LatencyHistogram: histograma vazio.
+ */
+template<unsigned SubBits>
+LatencyHistogram<SubBits>::LatencyHistogram() {
+    reset();
+}
+
+/**
+ *   Retorna a faixa de value (LatencyHistogram). Valores menores que
+ * 2^SubBits têm uma faixa cada; acima disso, a faixa é dada pelo expoente e
+ * pelos SubBits seguintes ao bit mais alto.
+ */
+template<unsigned SubBits>
+std::size_t LatencyHistogram<SubBits>::index_of(std::uint64_t value) {
+    if (value < SUB_COUNT)
+        return static_cast<std::size_t>(value);
+    unsigned exponent = 63 - __builtin_clzll(value);
+    unsigned shift = exponent - SubBits;
+    return static_cast<std::size_t>((shift + 1) * SUB_COUNT +
+                                    ((value >> shift) - SUB_COUNT));
+}
+
+/**
+ *   Retorna o menor valor da faixa index (LatencyHistogram).
+ */
+template<unsigned SubBits>
+std::uint64_t LatencyHistogram<SubBits>::lowest(std::size_t index) {
+    if (index < SUB_COUNT)
+        return index;
+    std::uint64_t shift = index / SUB_COUNT - 1;
+    return (SUB_COUNT + index % SUB_COUNT) << shift;
+}
+
+/**
+ *   Retorna o maior valor da faixa index (LatencyHistogram).
+ */
+template<unsigned SubBits>
+std::uint64_t LatencyHistogram<SubBits>::highest(std::size_t index) {
+    if (index < SUB_COUNT)
+        return index;
+    std::uint64_t shift = index / SUB_COUNT - 1;
+    return lowest(index) + ((std::uint64_t(1) << shift) - 1);
+}
+
+/**
+ *   Registra value (LatencyHistogram).
+ */
+template<unsigned SubBits>
+void LatencyHistogram<SubBits>::record(std::uint64_t value) {
+    counts_[index_of(value)].fetch_add(1, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+    sum_.fetch_add(value, std::memory_order_relaxed);
+
+    std::uint64_t current = min_.load(std::memory_order_relaxed);
+    while (value < current &&
+           !min_.compare_exchange_weak(current, value,
+                                       std::memory_order_relaxed)) { }
+    current = max_.load(std::memory_order_relaxed);
+    while (value > current &&
+           !max_.compare_exchange_weak(current, value,
+                                       std::memory_order_relaxed)) { }
+}
+
+/**
+ *   Zera o histograma (LatencyHistogram). Registros concorrentes podem ser
+ * perdidos ou ficar pela metade.
+ */
+template<unsigned SubBits>
+void LatencyHistogram<SubBits>::reset() {
+    for (std::size_t i = 0; i < BUCKETS; i++)
+        counts_[i].store(0, std::memory_order_relaxed);
+    count_.store(0, std::memory_order_relaxed);
+    sum_.store(0, std::memory_order_relaxed);
+    min_.store(UINT64_MAX, std::memory_order_relaxed);
+    max_.store(0, std::memory_order_relaxed);
+}
+
+/**
+ *   Retorna quantos valores foram registrados (LatencyHistogram).
+ */
+template<unsigned SubBits>
+std::uint64_t LatencyHistogram<SubBits>::count() const {
+    return count_.load(std::memory_order_relaxed);
+}
+
+/**
+ *   Retorna o menor valor registrado, ou 0 se não há registros
+ * (LatencyHistogram).
+ */
+template<unsigned SubBits>
+std::uint64_t LatencyHistogram<SubBits>::min() const {
+    return count() > 0 ? min_.load(std::memory_order_relaxed) : 0;
+}
+
+/**
+ *   Retorna o maior valor registrado (LatencyHistogram).
+ */
+template<unsigned SubBits>
+std::uint64_t LatencyHistogram<SubBits>::max() const {
+    return max_.load(std::memory_order_relaxed);
+}
+
+/**
+ *   Retorna a média dos valores registrados (LatencyHistogram).
+ */
+template<unsigned SubBits>
+double LatencyHistogram<SubBits>::mean() const {
+    std::uint64_t count = this->count();
+    if (count == 0)
+        return 0.0;
+    return static_cast<double>(sum_.load(std::memory_order_relaxed)) / count;
+}
+
+/**
+ *   Retorna o valor abaixo do qual (ou igual) estão percent por cento dos
+ * registros (LatencyHistogram), arredondado para o maior valor da faixa e
+ * limitado ao máximo registrado.
+ */
+template<unsigned SubBits>
+std::uint64_t LatencyHistogram<SubBits>::percentile(double percent) const {
+    std::uint64_t count = this->count();
+    if (count == 0)
+        return 0;
+    if (percent < 0.0)
+        percent = 0.0;
+    if (percent > 100.0)
+        percent = 100.0;
+
+    std::uint64_t rank =
+        static_cast<std::uint64_t>(std::ceil(percent / 100.0 * count));
+    if (rank == 0)
+        rank = 1;
+    std::uint64_t seen = 0;
+    for (std::size_t i = 0; i < BUCKETS; i++) {
+        seen += counts_[i].load(std::memory_order_relaxed);
+        if (seen >= rank) {
+            std::uint64_t value = highest(i);
+            return value < max() ? value : max();
+        }
+    }
+    return max();
+}
+
+/**
+ *   Chama function(menor, maior, contagem) para cada faixa não vazia, em
+ * ordem crescente (LatencyHistogram). É a forma barata de exportar o
+ * histograma: só as faixas usadas são visitadas pelo chamador.
+ */
+template<unsigned SubBits>
+template<typename Function>
+void LatencyHistogram<SubBits>::for_each_bucket(Function function) const {
+    for (std::size_t i = 0; i < BUCKETS; i++) {
+        std::uint64_t count = counts_[i].load(std::memory_order_relaxed);
+        if (count > 0)
+            function(lowest(i), highest(i), count);
+    }
+}
+
+}  // namespace structures
+
+#endif
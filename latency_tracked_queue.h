@@ -0,0 +1,141 @@
+// Copyright 2017 Letícia do Nascimento
+
+#ifndef STRUCTURES_LATENCY_TRACKED_QUEUE_H
+#define STRUCTURES_LATENCY_TRACKED_QUEUE_H
+
+#include <chrono>
+#include <cstdint>
+#include <utility>  // std::forward
+
+#include "./latency_histogram.h"
+#include "./linked_queue.h"
+
+namespace structures {
+
+/**
+ * @brief      Dado guardado por uma LatencyTrackedQueue, com o instante em
+ *             que entrou na fila.
+ */
+template<typename T>
+struct Timestamped {
+    T data;
+    std::uint64_t enqueued{0u};  // nanossegundos no relógio da fila
+};
+
+/**
+ * @brief      Fila que mede quanto tempo cada dado esperou: enqueue marca o
+ *             instante de entrada e dequeue registra a espera, em
+ *             nanossegundos, num LatencyHistogram. Opcional: envolve uma
+ *             LinkedQueue ou ArrayQueue de Timestamped<T>, e quem não precisa
+ *             da medição continua usando a fila simples.
+ *
+ * @tparam     T      Parâmetro genérico de Template
+ * @tparam     Queue  Fila de Timestamped<T> (LinkedQueue ou ArrayQueue)
+ * @tparam     Clock  Relógio monotônico usado nas marcas de tempo
+ */
+template<typename T,
+         typename Queue = LinkedQueue<Timestamped<T>>,
+         typename Clock = std::chrono::steady_clock>
+class LatencyTrackedQueue {
+ public:
+    template<typename... Args>
+    explicit LatencyTrackedQueue(Args&&... args);  // argumentos da fila
+
+    void enqueue(const T& data);  // enfila, marcando o instante
+    T dequeue();  // desenfila, registrando a espera
+    void clear();  // limpa, sem registrar esperas
+
+    bool empty() const;  // fila vazia
+    std::size_t size() const;  // tamanho da fila
+
+    const LatencyHistogram<>& latency() const;  // esperas registradas
+    void reset_latency();  // zera o histograma
+
+ private:
+    static std::uint64_t now() {
+        return static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                Clock::now().time_since_epoch()).count());
+    }
+
+    Queue queue_;
+    LatencyHistogram<> latency_;
+};
+
+/**
+ *   Construtor da classe LatencyTrackedQueue; args são repassados à fila.
+ */
+template<typename T, typename Queue, typename Clock>
+template<typename... Args>
+LatencyTrackedQueue<T, Queue, Clock>::LatencyTrackedQueue(Args&&... args) :
+    queue_(std::forward<Args>(args)...)
+{}
+
+/**
+ *   Insere data no fim da fila com o instante atual (LatencyTrackedQueue).
+ */
+template<typename T, typename Queue, typename Clock>
+void LatencyTrackedQueue<T, Queue, Clock>::enqueue(const T& data) {
+    Timestamped<T> entry;
+    entry.data = data;
+    entry.enqueued = now();
+    queue_.enqueue(entry);
+}
+
+/**
+ *   Retira o início da fila e registra quanto ele esperou
+ * (LatencyTrackedQueue).
+ */
+template<typename T, typename Queue, typename Clock>
+T LatencyTrackedQueue<T, Queue, Clock>::dequeue() {
+    Timestamped<T> entry = queue_.dequeue();
+    std::uint64_t waited = now() - entry.enqueued;
+    latency_.record(waited);
+    return entry.data;
+}
+
+/**
+ *   Faz uma limpeza da fila (LatencyTrackedQueue); os dados descartados não
+ * entram no histograma.
+ */
+template<typename T, typename Queue, typename Clock>
+void LatencyTrackedQueue<T, Queue, Clock>::clear() {
+    queue_.clear();
+}
+
+/**
+ *   Verifica se a fila (LatencyTrackedQueue) está vazia.
+ */
+template<typename T, typename Queue, typename Clock>
+bool LatencyTrackedQueue<T, Queue, Clock>::empty() const {
+    return queue_.empty();
+}
+
+/**
+ *   Retorna o tamanho da fila (LatencyTrackedQueue).
+ */
+template<typename T, typename Queue, typename Clock>
+std::size_t LatencyTrackedQueue<T, Queue, Clock>::size() const {
+    return queue_.size();
+}
+
+/**
+ *   Retorna o histograma das esperas, em nanossegundos (LatencyTrackedQueue).
+ */
+template<typename T, typename Queue, typename Clock>
+const LatencyHistogram<>&
+LatencyTrackedQueue<T, Queue, Clock>::latency() const {
+    return latency_;
+}
+
+/**
+ *   Zera o histograma das esperas (LatencyTrackedQueue).
+ */
+template<typename T, typename Queue, typename Clock>
+void LatencyTrackedQueue<T, Queue, Clock>::reset_latency() {
+    latency_.reset();
+}
+
+}  // namespace structures
+
+#endif
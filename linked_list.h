@@ -6,6 +6,10 @@
 #include <cstdint>
 #include <stdexcept>  // C++ exception
 
+#include "./memory_usage.h"
+#include "./operation_stats.h"
+#include "./prefetch.h"
+
 namespace structures {
 
 /**
@@ -13,10 +17,11 @@ namespace structures {
  *			   Organização de dados linear e dinâmica, composta por células que
  *             apontam para o próximo elemento da lista.
  *
- * @tparam     T     Parâmetro genérico de Template
+ * @tparam     T      Parâmetro genérico de Template
+ * @tparam     Stats  Política de estatísticas (NoStats ou OperationStats)
  */
-template<typename T>
-class LinkedList {
+template<typename T, typename Stats = NoStats>
+class LinkedList : private Stats {
  public:
     LinkedList();
     ~LinkedList();
@@ -34,6 +39,13 @@ class LinkedList {
     bool contains(const T& data) const;
     std::size_t find(const T& data) const;
     std::size_t size() const;
+    StatsSnapshot stats() const;  // contadores da política de estatísticas
+    void reset_stats();  // zera os contadores
+    std::size_t bytes_allocated() const;  // bytes no heap
+    std::size_t capacity() const;  // dados que cabem sem alocar
+    MemoryUsage memory_usage() const;  // detalhamento da memória
+    // repassa alocações a um observador (só com ObservedStats)
+    void observe(AllocationObserver* observer, const char* site);
 
  private:
     class Node {
@@ -67,8 +79,8 @@ class LinkedList {
 /**
  *   Construtor padrão da classe LinkedList.
  */
-template <typename T>
-LinkedList<T>::LinkedList() {
+template<typename T, typename Stats>
+LinkedList<T, Stats>::LinkedList() {
     head = nullptr;
     size_ = 0;
 }
@@ -76,16 +88,16 @@ LinkedList<T>::LinkedList() {
 /**
  *   Destrutor padrão da classe LinkedList.
  */
-template<typename T>
-LinkedList<T>::~LinkedList() {
+template<typename T, typename Stats>
+LinkedList<T, Stats>::~LinkedList() {
     clear();
 }
 
 /**
  *   Faz uma limpeza da lista encadeada LinkedList.
  */
-template<typename T>
-void LinkedList<T>::clear() {
+template<typename T, typename Stats>
+void LinkedList<T, Stats>::clear() {
     while (!empty()) {
         pop_front();
     }
@@ -94,66 +106,71 @@ void LinkedList<T>::clear() {
 /**
  *   Verifica se a lista encadeada (LinkedList) está vazia.
  */
-template<typename T>
-bool LinkedList<T>::empty() const {
+template<typename T, typename Stats>
+bool LinkedList<T, Stats>::empty() const {
     return size_ == 0;
 }
 
 /**
  *   Verifica e retorna o tamanho da lista encadeada (LinkedList).
  */
-template<typename T>
-std::size_t LinkedList<T>::size() const {
+template<typename T, typename Stats>
+std::size_t LinkedList<T, Stats>::size() const {
     return size_;
 }
 
 /**
  *   Inserir novo elemento do fim da lista encadeada (LinkedList).
  */
-template<typename T>
-void LinkedList<T>::push_back(const T& data) {
+template<typename T, typename Stats>
+void LinkedList<T, Stats>::push_back(const T& data) {
     insert(data, size_);
 }
 
 /**
  *   Inserir novo elemento no índice específico da lista encadeada (LinkedList).
  */
-template<typename T>
-void LinkedList<T>::insert(const T& data, std::size_t index) {
-    Node* novo = new Node(data);
-    Node* atual = head;
-    if (index < 0 || index > size_)
+template<typename T, typename Stats>
+void LinkedList<T, Stats>::insert(const T& data, std::size_t index) {
+    if (index > size_)
         throw std::out_of_range("Índice inválido");
     if (index == 0)
         return push_front(data);
-    if (novo == nullptr)
-        throw std::out_of_range("Lista cheia.");
-    for (int i = 0; i < index - 1; i++)
+    Node* novo = new Node(data);
+    Node* atual = head;
+    Stats::operation();
+    Stats::allocated(sizeof(Node));
+    for (std::size_t i = 0; i < index - 1; i++)
       atual = atual->next();
+    Stats::traversed(index - 1);
     novo->next(atual->next());
     atual->next(novo);
     size_++;
+    Stats::resized(size_);
 }
 
 /**
  * Inserir novo elemento no começo da lista encadeada (LinkedList).
  */
-template<typename T>
-void LinkedList<T>::push_front(const T& data) {
+template<typename T, typename Stats>
+void LinkedList<T, Stats>::push_front(const T& data) {
     Node* first_node = new Node(data);
     if (first_node == nullptr)
         throw std::out_of_range("Lista está cheia.");
 
+    Stats::operation();
+    Stats::allocated(sizeof(Node));
     first_node->next(head);
     head = first_node;
     size_++;
+    Stats::resized(size_);
 }
 
 /**
  *   Insere novo elemento na ordem definida pela lista encadeada (LinkedList).
  */
-template<typename T>
-void LinkedList<T>::insert_sorted(const T& data) {
+template<typename T, typename Stats>
+void LinkedList<T, Stats>::insert_sorted(const T& data) {
     if (empty()) {
         push_front(data);
     } else {
@@ -161,7 +178,10 @@ void LinkedList<T>::insert_sorted(const T& data) {
         Node* current = head;
         for (i = 0; i < size_ && data > current->data(); i++) {
           current = current->next();
+          if (current != nullptr)
+              STRUCTURES_PREFETCH(current->next());
         }
+        Stats::traversed(i);
         insert(data, i);
     }
 }
@@ -169,17 +189,19 @@ void LinkedList<T>::insert_sorted(const T& data) {
 /**
  *   Retorna um elemento da lista encadeada que está em uma posição específica (LinkedList).
  */
-template<typename T>
-T& LinkedList<T>::at(std::size_t index) {
+template<typename T, typename Stats>
+T& LinkedList<T, Stats>::at(std::size_t index) {
     if (index > size_ - 1)
         throw std::out_of_range("Índice inválido!");
 
+    Stats::operation();
     Node* current = head;
     if (index == 0)
         return current->data();
 
-    for (int i = 0; i < index; i++)
+    for (std::size_t i = 0; i < index; i++)
       current = current->next();
+    Stats::traversed(index);
 
     return current->data();
 }
@@ -187,8 +209,8 @@ T& LinkedList<T>::at(std::size_t index) {
 /**
  *   Remove um elemento da lista encadeada (LinkedList).
  */
-template<typename T>
-T LinkedList<T>::pop(std::size_t index) {
+template<typename T, typename Stats>
+T LinkedList<T, Stats>::pop(std::size_t index) {
     if (empty())
         throw std::out_of_range("Lista vazia!");
 
@@ -198,15 +220,18 @@ T LinkedList<T>::pop(std::size_t index) {
     if (index == 0)
         return pop_front();
 
+    Stats::operation();
     std::size_t i = 0;
     Node* anterior = head;
     for (i = 0; i < index - 1; i++) {
       anterior = anterior->next();
     }
+    Stats::traversed(index - 1);
     Node* atual = anterior->next();
     T retorno = atual->data();
     anterior->next(atual->next());
     size_--;
+    Stats::released(sizeof(Node));
     delete atual;
     return retorno;
 }
@@ -214,22 +239,24 @@ T LinkedList<T>::pop(std::size_t index) {
 /**
  *   Remove o último elemento da lista encadeada (LinkedList).
  */
-template<typename T>
-T LinkedList<T>::pop_back() {
+template<typename T, typename Stats>
+T LinkedList<T, Stats>::pop_back() {
     return pop(size_ - 1);
 }
 
 /**
  *   Remove o primeiro elemento da lista encadeada (LinkedList).
  */
-template<typename T>
-T LinkedList<T>::pop_front() {
+template<typename T, typename Stats>
+T LinkedList<T, Stats>::pop_front() {
     if (empty()) {
         throw std::out_of_range("Lista está vazia!");
     }
+    Stats::operation();
     Node* anterior = head;
     T out_ = anterior->data();
     head = anterior->next();
+    Stats::released(sizeof(Node));
     delete anterior;
     size_--;
     return out_;
@@ -238,8 +265,8 @@ T LinkedList<T>::pop_front() {
 /**
  *   Remove um item específico da lista encadeada (LinkedList).
  */
-template<typename T>
-void LinkedList<T>::remove(const T& data) {
+template<typename T, typename Stats>
+void LinkedList<T, Stats>::remove(const T& data) {
     std::size_t test = find(data);
     if (test != size_)
         pop(test);
@@ -248,8 +275,8 @@ void LinkedList<T>::remove(const T& data) {
 /**
  *   Verifica se a lista encadeada (LinkedList) possui um elemento específico de acordo com o elemento fornecido.
  */ 
-template<typename T>
-bool LinkedList<T>::contains(const T& data) const {
+template<typename T, typename Stats>
+bool LinkedList<T, Stats>::contains(const T& data) const {
     if (find(data) != size_)
         return true;
     return false;
@@ -259,13 +286,14 @@ bool LinkedList<T>::contains(const T& data) const {
 /**
  *   Retorna o índice de um elemento éspecífico na lista encadeada (LinkedList).
  */
-template<typename T>
-std::size_t LinkedList<T>::find(const T& data) const {
+template<typename T, typename Stats>
+std::size_t LinkedList<T, Stats>::find(const T& data) const {
     std::size_t i;
     std::size_t index = size_;
     Node* current = head;
 
     for (i = 0; i < size_; i++) {
+        STRUCTURES_PREFETCH(current->next());
         if (current->data() == data) {
             index = i;
             break;
@@ -273,7 +301,61 @@ std::size_t LinkedList<T>::find(const T& data) const {
         if (i != size_)
             current = current->next();
     }
+    Stats::operation();
+    Stats::traversed(i < size_ ? i + 1 : size_);
     return index;
 }
+
+/**
+ *   Retorna os contadores da política de estatísticas (LinkedList).
+ */
+template<typename T, typename Stats>
+StatsSnapshot LinkedList<T, Stats>::stats() const {
+    return Stats::snapshot();
+}
+
+/**
+ *   Zera os contadores da política de estatísticas (LinkedList).
+ */
+template<typename T, typename Stats>
+void LinkedList<T, Stats>::reset_stats() {
+    Stats::reset();
+}
+
+/**
+ *   Retorna os bytes que a lista ocupa no heap (LinkedList).
+ */
+template<typename T, typename Stats>
+std::size_t LinkedList<T, Stats>::bytes_allocated() const {
+    return size_ * sizeof(Node);
+}
+
+/**
+ *   Retorna quantos dados cabem sem nova alocação (LinkedList): cada
+ * dado novo aloca um nodo.
+ */
+template<typename T, typename Stats>
+std::size_t LinkedList<T, Stats>::capacity() const {
+    return size_;
+}
+
+/**
+ *   Retorna o detalhamento da memória ocupada (LinkedList).
+ */
+template<typename T, typename Stats>
+MemoryUsage LinkedList<T, Stats>::memory_usage() const {
+    return detail::node_usage<T, Node>(size_, size_);
+}
+
+/**
+ *   Repassa as alocações ao observador com o rótulo site (LinkedList);
+ * exige a política ObservedStats.
+ */
+template<typename T, typename Stats>
+void LinkedList<T, Stats>::observe(AllocationObserver* observer,
+                                   const char* site) {
+    Stats::observe(observer, site);
+}
+
 }  // namespace structures
 #endif
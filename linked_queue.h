@@ -1,7 +1,14 @@
 // Copyright 2017 Letícia do Nascimento
 
+#ifndef STRUCTURES_LINKED_QUEUE_H
+#define STRUCTURES_LINKED_QUEUE_H
+
+#include <cstdint>
 #include <stdexcept>  // C++ exception
 
+#include "./memory_usage.h"
+#include "./operation_stats.h"
+
 namespace structures {
 
     /**
@@ -9,11 +16,12 @@ namespace structures {
      *             (First In First Out ou FIFO) - Organização dos elementos onde
      *             o primeiro a ser inserido é o primeiro a ser retirado.
      *
-     * @tparam     T     Parâmetro genérico de Template
+     * @tparam     T      Parâmetro genérico de Template
+     * @tparam     Stats  Política de estatísticas (NoStats ou OperationStats)
      */
 
-template<typename T>
-class LinkedQueue {
+template<typename T, typename Stats = NoStats>
+class LinkedQueue : private Stats {
  public:
     LinkedQueue();
 
@@ -23,8 +31,14 @@ class LinkedQueue {
 
     void enqueue(const T& data);  // enfilerar
 
+    template<typename InputIt>
+    void enqueue_bulk(InputIt first, InputIt last);  // enfilerar em lote
+
     T dequeue();  // desenfilerar
 
+    template<typename OutputIt>
+    std::size_t dequeue_bulk(OutputIt out, std::size_t max);  // em lote
+
     T& front() const;  // primeiro dado
 
     T& back() const;  // último dado
@@ -33,6 +47,15 @@ class LinkedQueue {
 
     std::size_t size() const;  // tamanho
 
+    StatsSnapshot stats() const;  // contadores de estatísticas
+
+    void reset_stats();  // zera os contadores
+    std::size_t bytes_allocated() const;  // bytes no heap
+    std::size_t capacity() const;  // dados que cabem sem alocar
+    MemoryUsage memory_usage() const;  // detalhamento da memória
+    // repassa alocações a um observador (só com ObservedStats)
+    void observe(AllocationObserver* observer, const char* site);
+
  private:
     class Node {
      public:
@@ -59,8 +82,8 @@ class LinkedQueue {
 /**
  *   Construtor padrão da classe LinkedQueue.
  */
-template <typename T>
-LinkedQueue<T>::LinkedQueue() {
+template<typename T, typename Stats>
+LinkedQueue<T, Stats>::LinkedQueue() {
     head = nullptr;
     tail = nullptr;
     size_ = 0;
@@ -69,13 +92,14 @@ LinkedQueue<T>::LinkedQueue() {
 /**
  *   Destrutor padrão da classe LinkedQueue.
  */
-template<typename T>
-LinkedQueue<T>::~LinkedQueue() {
+template<typename T, typename Stats>
+LinkedQueue<T, Stats>::~LinkedQueue() {
     Node *current, *previous;
     current = head;
     while (current != nullptr) {
         previous = current;
         current = current->next();
+        Stats::released(sizeof(Node));
         delete previous;
     }
 }
@@ -83,13 +107,14 @@ LinkedQueue<T>::~LinkedQueue() {
 /**
  *   Faz uma limpeza da fila encadeada LinkedQueue.
  */
-template<typename T>
-void LinkedQueue<T>::clear() {
+template<typename T, typename Stats>
+void LinkedQueue<T, Stats>::clear() {
     Node *current, *previous;
     current = head;
     while (current != nullptr) {
         previous = current;
         current = current->next();
+        Stats::released(sizeof(Node));
         delete previous;
     }
     size_ = 0;
@@ -100,25 +125,27 @@ void LinkedQueue<T>::clear() {
 /**
  *   Verifica se a fila encadeada (LinkedQueue) está vazia.
  */
-template<typename T>
-bool LinkedQueue<T>::empty() const {
+template<typename T, typename Stats>
+bool LinkedQueue<T, Stats>::empty() const {
     return size_ == 0;
 }
 
 /**
  *   Verifica e retorna o tamanho da fila encadeada (LinkedQueue).
  */
-template<typename T>
-std::size_t LinkedQueue<T>::size() const {
+template<typename T, typename Stats>
+std::size_t LinkedQueue<T, Stats>::size() const {
     return size_;
 }
 
 /**
  * Inserir novo elemento na fila (LinkedQueue).
  */
-template<typename T>
-void LinkedQueue<T>::enqueue(const T& data) {
+template<typename T, typename Stats>
+void LinkedQueue<T, Stats>::enqueue(const T& data) {
     Node* new_node = new Node(data, nullptr);
+    Stats::operation();
+    Stats::allocated(sizeof(Node));
     if (size_ == 0) {
         head = new_node;
     } else {
@@ -126,30 +153,102 @@ void LinkedQueue<T>::enqueue(const T& data) {
     }
     tail = new_node;
     size_++;
+    Stats::resized(size_);
+}
+
+/**
+ *   Insere os elementos de [first, last) na fila (LinkedQueue). Os nodos são
+ * encadeados entre si antes e ligados à fila de uma vez; se alguma alocação
+ * falhar, a fila não é alterada.
+ */
+template<typename T, typename Stats>
+template<typename InputIt>
+void LinkedQueue<T, Stats>::enqueue_bulk(InputIt first, InputIt last) {
+    Node* chain_head = nullptr;
+    Node* chain_tail = nullptr;
+    std::size_t count = 0;
+    try {
+        for (; first != last; ++first) {
+            Node* new_node = new Node(*first, nullptr);
+            Stats::allocated(sizeof(Node));
+            if (chain_head == nullptr)
+                chain_head = new_node;
+            else
+                chain_tail->next(new_node);
+            chain_tail = new_node;
+            count++;
+        }
+    } catch (...) {
+        while (chain_head != nullptr) {
+            Node* next = chain_head->next();
+            Stats::released(sizeof(Node));
+            delete chain_head;
+            chain_head = next;
+        }
+        throw;
+    }
+
+    if (count == 0)
+        return;
+    Stats::operation();
+    if (size_ == 0)
+        head = chain_head;
+    else
+        tail->next(chain_head);
+    tail = chain_tail;
+    size_ += count;
+    Stats::resized(size_);
 }
 
 /**
  *   Remove um elemento da fila encadeada (LinkedQueue).
  */
-template<typename T>
-T LinkedQueue<T>::dequeue() {
+template<typename T, typename Stats>
+T LinkedQueue<T, Stats>::dequeue() {
     if (empty())
         throw std::out_of_range("Fila vazia!");
+    Stats::operation();
     if (size_ == 1)
         tail = nullptr;
     Node* left_ = head;
     T return_ = left_->data();
     head = left_->next();
+    Stats::released(sizeof(Node));
     delete left_;
     size_--;
     return return_;
 }
 
+/**
+ *   Remove até max elementos da fila encadeada (LinkedQueue), escrevendo-os
+ * em out na ordem de saída. Retorna quantos elementos foram removidos.
+ */
+template<typename T, typename Stats>
+template<typename OutputIt>
+std::size_t LinkedQueue<T, Stats>::dequeue_bulk(OutputIt out, std::size_t max) {
+    Stats::operation();
+    std::size_t count = max < size_ ? max : size_;
+    for (std::size_t i = 0; i < count; i++) {
+        // escreve antes de desligar: se a escrita lançar, a fila continua
+        // íntegra com o nodo ainda no início
+        Node* left_ = head;
+        *out = left_->data();
+        head = left_->next();
+        size_--;
+        if (size_ == 0)
+            tail = nullptr;
+        Stats::released(sizeof(Node));
+        delete left_;
+        ++out;
+    }
+    return count;
+}
+
 /**
  *   Retorna o primeiro elemento da fila encadeada (LinkedQueue).
  */
-template<typename T>
-T& LinkedQueue<T>::front() const {
+template<typename T, typename Stats>
+T& LinkedQueue<T, Stats>::front() const {
     if (empty())
         throw std::out_of_range("Fila vazia.");
     return head->data();
@@ -158,11 +257,64 @@ T& LinkedQueue<T>::front() const {
 /**
  *   Retorna o último elemento da fila encadeada (LinkedQueue).
  */
-template<typename T>
-T& LinkedQueue<T>::back() const {
+template<typename T, typename Stats>
+T& LinkedQueue<T, Stats>::back() const {
     if (empty())
         throw std::out_of_range("Fila vazia.");
     return tail->data();
 }
+
+/**
+ *   Retorna os contadores da política de estatísticas (LinkedQueue).
+ */
+template<typename T, typename Stats>
+StatsSnapshot LinkedQueue<T, Stats>::stats() const {
+    return Stats::snapshot();
+}
+
+/**
+ *   Zera os contadores da política de estatísticas (LinkedQueue).
+ */
+template<typename T, typename Stats>
+void LinkedQueue<T, Stats>::reset_stats() {
+    Stats::reset();
+}
+
+/**
+ *   Retorna os bytes que a fila ocupa no heap (LinkedQueue).
+ */
+template<typename T, typename Stats>
+std::size_t LinkedQueue<T, Stats>::bytes_allocated() const {
+    return size_ * sizeof(Node);
+}
+
+/**
+ *   Retorna quantos dados cabem sem nova alocação (LinkedQueue): cada
+ * dado novo aloca um nodo.
+ */
+template<typename T, typename Stats>
+std::size_t LinkedQueue<T, Stats>::capacity() const {
+    return size_;
+}
+
+/**
+ *   Retorna o detalhamento da memória ocupada (LinkedQueue).
+ */
+template<typename T, typename Stats>
+MemoryUsage LinkedQueue<T, Stats>::memory_usage() const {
+    return detail::node_usage<T, Node>(size_, size_);
+}
+
+/**
+ *   Repassa as alocações ao observador com o rótulo site (LinkedQueue);
+ * exige a política ObservedStats.
+ */
+template<typename T, typename Stats>
+void LinkedQueue<T, Stats>::observe(AllocationObserver* observer,
+                                    const char* site) {
+    Stats::observe(observer, site);
+}
+
 }  // namespace structures
 
+#endif
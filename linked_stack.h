@@ -1,7 +1,14 @@
 // Copyright 2017 Letícia do Nascimento
 
+#ifndef STRUCTURES_LINKED_STACK_H
+#define STRUCTURES_LINKED_STACK_H
+
+#include <cstdint>
 #include <stdexcept>  // C++ exception
 
+#include "./memory_usage.h"
+#include "./operation_stats.h"
+
 namespace structures {
 
     /**
@@ -9,11 +16,12 @@ namespace structures {
      *             (Last In First Out ou LIFO) - Organização dos elementos onde
      *             o último a ser inserido é o primeiro a ser retirado.
      *
-     * @tparam     T     Parâmetro genérico de Template
+     * @tparam     T      Parâmetro genérico de Template
+     * @tparam     Stats  Política de estatísticas (NoStats ou OperationStats)
      */
 
-template<typename T>
-class LinkedStack {
+template<typename T, typename Stats = NoStats>
+class LinkedStack : private Stats {
  public:
     LinkedStack();
 
@@ -23,14 +31,29 @@ class LinkedStack {
 
     void push(const T& data);  // empilha
 
+    template<typename InputIt>
+    void push_bulk(InputIt first, InputIt last);  // empilha em lote
+
     T pop();  // desempilha
 
+    template<typename OutputIt>
+    std::size_t pop_bulk(OutputIt out, std::size_t max);  // desempilha em lote
+
     T& top() const;  // dado no topo
 
     bool empty() const;  // pilha vazia
 
     std::size_t size() const;  // tamanho da pilha
 
+    StatsSnapshot stats() const;  // contadores de estatísticas
+
+    void reset_stats();  // zera os contadores
+    std::size_t bytes_allocated() const;  // bytes no heap
+    std::size_t capacity() const;  // dados que cabem sem alocar
+    MemoryUsage memory_usage() const;  // detalhamento da memória
+    // repassa alocações a um observador (só com ObservedStats)
+    void observe(AllocationObserver* observer, const char* site);
+
  private:
     class Node {
      public:
@@ -56,8 +79,8 @@ class LinkedStack {
 /**
  *   Construtor padrão da classe LinkedStack.
  */
-template <typename T>
-LinkedStack<T>::LinkedStack() {
+template<typename T, typename Stats>
+LinkedStack<T, Stats>::LinkedStack() {
     top_ = nullptr;
     size_ = 0;
 }
@@ -65,16 +88,16 @@ LinkedStack<T>::LinkedStack() {
 /**
  *   Destrutor padrão da classe LinkedStack.
  */
-template<typename T>
-LinkedStack<T>::~LinkedStack() {
+template<typename T, typename Stats>
+LinkedStack<T, Stats>::~LinkedStack() {
     clear();
 }
 
 /**
  *   Faz uma limpeza da pilha encadeada LinkedStack.
  */
-template<typename T>
-void LinkedStack<T>::clear() {
+template<typename T, typename Stats>
+void LinkedStack<T, Stats>::clear() {
     while (!empty()) {
         pop();
     }
@@ -83,55 +106,176 @@ void LinkedStack<T>::clear() {
 /**
  *   Verifica se a pilha encadeada (LinkedStack) está vazia.
  */
-template<typename T>
-bool LinkedStack<T>::empty() const {
+template<typename T, typename Stats>
+bool LinkedStack<T, Stats>::empty() const {
     return top_ == nullptr;
 }
 
 /**
  *   Verifica e retorna o tamanho da pilha encadeada (LinkedStack).
  */
-template<typename T>
-std::size_t LinkedStack<T>::size() const {
+template<typename T, typename Stats>
+std::size_t LinkedStack<T, Stats>::size() const {
     return size_;
 }
 
 /**
  * Inserir novo elemento no fim da pilha (LinkedStack).
  */
-template<typename T>
-void LinkedStack<T>::push(const T& data) {
+template<typename T, typename Stats>
+void LinkedStack<T, Stats>::push(const T& data) {
     Node* first_node = new Node(data);
     if (first_node == nullptr)
         throw std::out_of_range("Pilha está cheia.");
 
+    Stats::operation();
+    Stats::allocated(sizeof(Node));
     first_node->next(top_);
     top_ = first_node;
     size_++;
+    Stats::resized(size_);
+}
+
+/**
+ *   Empilha os elementos de [first, last) na pilha (LinkedStack); o último
+ * elemento do intervalo fica no topo. Os nodos são encadeados entre si antes
+ * e ligados à pilha de uma vez; se alguma alocação falhar, a pilha não é
+ * alterada.
+ */
+template<typename T, typename Stats>
+template<typename InputIt>
+void LinkedStack<T, Stats>::push_bulk(InputIt first, InputIt last) {
+    Node* chain_top = nullptr;
+    Node* chain_bottom = nullptr;
+    std::size_t count = 0;
+    try {
+        for (; first != last; ++first) {
+            chain_top = new Node(*first, chain_top);
+            Stats::allocated(sizeof(Node));
+            if (chain_bottom == nullptr)
+                chain_bottom = chain_top;
+            count++;
+        }
+    } catch (...) {
+        while (chain_top != nullptr) {
+            Node* next = chain_top->next();
+            Stats::released(sizeof(Node));
+            delete chain_top;
+            chain_top = next;
+        }
+        throw;
+    }
+
+    if (count == 0)
+        return;
+    Stats::operation();
+    chain_bottom->next(top_);
+    top_ = chain_top;
+    size_ += count;
+    Stats::resized(size_);
 }
 
 /**
  *   Remove um elemento da pilha encadeada (LinkedStack).
  */
-template<typename T>
-T LinkedStack<T>::pop() {
+template<typename T, typename Stats>
+T LinkedStack<T, Stats>::pop() {
     if (empty())
         throw std::out_of_range("Pilha vazia!");
+    Stats::operation();
     Node* left_ = top_;
     T return_ = left_->data();
     top_ = top_->next();
     size_--;
+    Stats::released(sizeof(Node));
     delete left_;
     return return_;
 }
 
+/**
+ *   Desempilha até max elementos da pilha encadeada (LinkedStack),
+ * escrevendo-os em out a partir do topo. Retorna quantos foram retirados.
+ */
+template<typename T, typename Stats>
+template<typename OutputIt>
+std::size_t LinkedStack<T, Stats>::pop_bulk(OutputIt out, std::size_t max) {
+    Stats::operation();
+    std::size_t count = max < size_ ? max : size_;
+    for (std::size_t i = 0; i < count; i++) {
+        // escreve antes de desligar: se a escrita lançar, a pilha continua
+        // íntegra com o nodo ainda no topo
+        Node* left_ = top_;
+        *out = left_->data();
+        top_ = left_->next();
+        size_--;
+        Stats::released(sizeof(Node));
+        delete left_;
+        ++out;
+    }
+    return count;
+}
+
 /**
  *   Retorna o último elemento inserido na pilha encadeada (LinkedStack).
  */
-template<typename T>
-T& LinkedStack<T>::top() const {
+template<typename T, typename Stats>
+T& LinkedStack<T, Stats>::top() const {
     if (empty())
         throw std::out_of_range("Pilha vazia.");
     return top_->data();
 }
+
+/**
+ *   Retorna os contadores da política de estatísticas (LinkedStack).
+ */
+template<typename T, typename Stats>
+StatsSnapshot LinkedStack<T, Stats>::stats() const {
+    return Stats::snapshot();
+}
+
+/**
+ *   Zera os contadores da política de estatísticas (LinkedStack).
+ */
+template<typename T, typename Stats>
+void LinkedStack<T, Stats>::reset_stats() {
+    Stats::reset();
+}
+
+/**
+ *   Retorna os bytes que a pilha ocupa no heap (LinkedStack).
+ */
+template<typename T, typename Stats>
+std::size_t LinkedStack<T, Stats>::bytes_allocated() const {
+    return size_ * sizeof(Node);
+}
+
+/**
+ *   Retorna quantos dados cabem sem nova alocação (LinkedStack): cada
+ * dado novo aloca um nodo.
+ */
+template<typename T, typename Stats>
+std::size_t LinkedStack<T, Stats>::capacity() const {
+    return size_;
+}
+
+/**
+ *   Retorna o detalhamento da memória ocupada (LinkedStack).
+ */
+template<typename T, typename Stats>
+MemoryUsage LinkedStack<T, Stats>::memory_usage() const {
+    return detail::node_usage<T, Node>(size_, size_);
+}
+
+/**
+ *   Repassa as alocações ao observador com o rótulo site (LinkedStack);
+ * exige a política ObservedStats.
+ */
+template<typename T, typename Stats>
+void LinkedStack<T, Stats>::observe(AllocationObserver* observer,
+                                    const char* site) {
+    Stats::observe(observer, site);
+}
+
 }  // namespace structures
+
+#endif
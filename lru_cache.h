@@ -0,0 +1,291 @@
+// Copyright 2017 Letícia do Nascimento
+
+#ifndef STRUCTURES_LRU_CACHE_H
+#define STRUCTURES_LRU_CACHE_H
+
+#include <cstdint>
+#include <functional>  // std::hash
+#include <stdexcept>  // C++ exception
+#include <unordered_map>
+
+#include "./intrusive_doubly_linked_list.h"
+
+namespace structures {
+
+/**
+ * @brief      Contadores de uma LruCache.
+ */
+struct CacheStats {
+    std::size_t hits{0u};  // get que encontrou a chave
+    std::size_t misses{0u};  // get que não encontrou
+    std::size_t insertions{0u};  // put de chave nova
+    std::size_t evictions{0u};  // entradas descartadas por falta de espaço
+
+    double hit_ratio() const {
+        std::size_t lookups = hits + misses;
+        return lookups == 0 ? 0.0 : static_cast<double>(hits) / lookups;
+    }
+};
+
+/**
+ * @brief      Peso padrão das entradas: cada uma pesa 1, então a capacidade
+ *             é um número de entradas. Para limitar por bytes, use um
+ *             Weigher que retorne o tamanho da entrada.
+ */
+struct UnitWeigher {
+    template<typename Key, typename Value>
+    std::size_t operator()(const Key&, const Value&) const { return 1u; }
+};
+
+/**
+ * @brief      Cache LRU (descarta a entrada usada há mais tempo). Um
+ *             std::unordered_map guarda as entradas, que carregam um
+ *             DoublyListHook e ficam ligadas numa IntrusiveDoublyLinkedList
+ *             da mais recente para a mais antiga. Assim get, put, erase e o
+ *             descarte são O(1): o mapa acha a entrada e o gancho a desliga
+ *             da lista sem percorrê-la. Não é segura para várias threads.
+ *
+ * @tparam     Key      Tipo das chaves
+ * @tparam     Value    Tipo dos valores
+ * @tparam     Weigher  Peso de uma entrada: Weigher()(chave, valor)
+ * @tparam     Hash     Função de hash das chaves
+ */
+template<typename Key, typename Value, typename Weigher = UnitWeigher,
+         typename Hash = std::hash<Key>>
+class LruCache {
+ public:
+    explicit LruCache(std::size_t capacity, Weigher weigher = Weigher());
+
+    LruCache(const LruCache&) = delete;
+    LruCache& operator=(const LruCache&) = delete;
+
+    Value* get(const Key& key);  // valor da chave, ou nullptr; marca o uso
+    const Value* peek(const Key& key) const;  // valor, sem marcar o uso
+    bool put(const Key& key, const Value& value);  // insere ou atualiza
+    bool erase(const Key& key);  // remove a chave
+    void clear();  // remove todas as entradas
+
+    bool contains(const Key& key) const;  // chave presente, sem marcar o uso
+    bool empty() const;  // cache vazia
+    std::size_t size() const;  // entradas
+    std::size_t weight() const;  // soma dos pesos das entradas
+    std::size_t capacity() const;  // peso máximo
+    void capacity(std::size_t capacity);  // muda o peso máximo
+
+    CacheStats stats() const;  // contadores
+    void reset_stats();  // zera os contadores
+
+ private:
+    struct Entry : DoublyListHook<Entry> {
+        explicit Entry(const Value& value) : value(value) { }
+
+        const Key* key{nullptr};  // chave no mapa
+        Value value;
+        std::size_t weight{0u};
+    };
+
+    void evict(std::size_t limit);  // descarta até o peso caber em limit
+    void unlink(Entry& entry);  // tira da lista e do peso
+
+    std::unordered_map<Key, Entry, Hash> entries_;
+    IntrusiveDoublyLinkedList<Entry> recency_;  // mais recente na frente
+    Weigher weigher_;
+    std::size_t capacity_;
+    std::size_t weight_{0u};
+    CacheStats stats_;
+};
+
+/**
+ *   Construtor da classe LruCache: capacity é o peso máximo (entradas, com
+ * o UnitWeigher).
+ */
+template<typename Key, typename Value, typename Weigher, typename Hash>
+LruCache<Key, Value, Weigher, Hash>::LruCache(std::size_t capacity,
+                                              Weigher weigher) :
+    weigher_(weigher),
+    capacity_(capacity)
+{
+    if (capacity == 0)
+        throw std::out_of_range("Capacidade inválida!");
+}
+
+/**
+ *   Retorna o valor da chave e a marca como a mais recente, ou nullptr se
+ * ela não está na cache (LruCache). O ponteiro vale até a próxima mudança
+ * na cache.
+ */
+template<typename Key, typename Value, typename Weigher, typename Hash>
+Value* LruCache<Key, Value, Weigher, Hash>::get(const Key& key) {
+    auto it = entries_.find(key);
+    if (it == entries_.end()) {
+        stats_.misses++;
+        return nullptr;
+    }
+    stats_.hits++;
+    Entry& entry = it->second;
+    recency_.remove(entry);
+    recency_.push_front(entry);
+    return &entry.value;
+}
+
+/**
+ *   Retorna o valor da chave sem mudar a ordem de uso nem os contadores, ou
+ * nullptr (LruCache).
+ */
+template<typename Key, typename Value, typename Weigher, typename Hash>
+const Value* LruCache<Key, Value, Weigher, Hash>::peek(const Key& key) const {
+    auto it = entries_.find(key);
+    return it != entries_.end() ? &it->second.value : nullptr;
+}
+
+/**
+ *   Insere a chave, ou atualiza o seu valor, como a mais recente e descarta
+ * as entradas mais antigas até o peso caber na capacidade (LruCache).
+ * Retorna false, sem guardar nada, se a entrada sozinha pesa mais que a
+ * capacidade; um valor antigo da chave é removido nesse caso.
+ */
+template<typename Key, typename Value, typename Weigher, typename Hash>
+bool LruCache<Key, Value, Weigher, Hash>::put(const Key& key,
+                                              const Value& value) {
+    std::size_t weight = weigher_(key, value);
+    if (weight > capacity_) {
+        erase(key);
+        return false;
+    }
+
+    auto it = entries_.find(key);
+    if (it != entries_.end()) {
+        Entry& entry = it->second;
+        entry.value = value;  // se lançar, a entrada continua ligada
+        unlink(entry);
+        entry.weight = weight;
+    } else {
+        it = entries_.emplace(key, Entry(value)).first;
+        it->second.key = &it->first;
+        it->second.weight = weight;
+        stats_.insertions++;
+    }
+
+    evict(capacity_ - weight);
+    recency_.push_front(it->second);
+    weight_ += weight;
+    return true;
+}
+
+/**
+ *   Remove a chave da cache (LruCache); retorna false se ela não estava lá.
+ */
+template<typename Key, typename Value, typename Weigher, typename Hash>
+bool LruCache<Key, Value, Weigher, Hash>::erase(const Key& key) {
+    auto it = entries_.find(key);
+    if (it == entries_.end())
+        return false;
+    unlink(it->second);
+    entries_.erase(it);
+    return true;
+}
+
+/**
+ *   Remove todas as entradas (LruCache); os contadores são mantidos.
+ */
+template<typename Key, typename Value, typename Weigher, typename Hash>
+void LruCache<Key, Value, Weigher, Hash>::clear() {
+    recency_.clear();
+    entries_.clear();
+    weight_ = 0;
+}
+
+/**
+ *   Verifica se a chave está na cache, sem marcar o uso (LruCache).
+ */
+template<typename Key, typename Value, typename Weigher, typename Hash>
+bool LruCache<Key, Value, Weigher, Hash>::contains(const Key& key) const {
+    return entries_.find(key) != entries_.end();
+}
+
+/**
+ *   Verifica se a cache (LruCache) está vazia.
+ */
+template<typename Key, typename Value, typename Weigher, typename Hash>
+bool LruCache<Key, Value, Weigher, Hash>::empty() const {
+    return entries_.empty();
+}
+
+/**
+ *   Retorna o número de entradas (LruCache).
+ */
+template<typename Key, typename Value, typename Weigher, typename Hash>
+std::size_t LruCache<Key, Value, Weigher, Hash>::size() const {
+    return entries_.size();
+}
+
+/**
+ *   Retorna a soma dos pesos das entradas (LruCache).
+ */
+template<typename Key, typename Value, typename Weigher, typename Hash>
+std::size_t LruCache<Key, Value, Weigher, Hash>::weight() const {
+    return weight_;
+}
+
+/**
+ *   Retorna o peso máximo (LruCache).
+ */
+template<typename Key, typename Value, typename Weigher, typename Hash>
+std::size_t LruCache<Key, Value, Weigher, Hash>::capacity() const {
+    return capacity_;
+}
+
+/**
+ *   Muda o peso máximo, descartando as entradas mais antigas se preciso
+ * (LruCache).
+ */
+template<typename Key, typename Value, typename Weigher, typename Hash>
+void LruCache<Key, Value, Weigher, Hash>::capacity(std::size_t capacity) {
+    if (capacity == 0)
+        throw std::out_of_range("Capacidade inválida!");
+    capacity_ = capacity;
+    evict(capacity_);
+}
+
+/**
+ *   Retorna os contadores (LruCache).
+ */
+template<typename Key, typename Value, typename Weigher, typename Hash>
+CacheStats LruCache<Key, Value, Weigher, Hash>::stats() const {
+    return stats_;
+}
+
+/**
+ *   Zera os contadores (LruCache).
+ */
+template<typename Key, typename Value, typename Weigher, typename Hash>
+void LruCache<Key, Value, Weigher, Hash>::reset_stats() {
+    stats_ = CacheStats();
+}
+
+/**
+ *   Descarta as entradas menos recentes até o peso não passar de limit
+ * (LruCache).
+ */
+template<typename Key, typename Value, typename Weigher, typename Hash>
+void LruCache<Key, Value, Weigher, Hash>::evict(std::size_t limit) {
+    while (weight_ > limit) {
+        Entry& victim = recency_.back();
+        unlink(victim);
+        entries_.erase(entries_.find(*victim.key));
+        stats_.evictions++;
+    }
+}
+
+/**
+ *   Desliga a entrada da lista de uso e tira o seu peso do total (LruCache).
+ */
+template<typename Key, typename Value, typename Weigher, typename Hash>
+void LruCache<Key, Value, Weigher, Hash>::unlink(Entry& entry) {
+    recency_.remove(entry);
+    weight_ -= entry.weight;
+}
+
+}  // namespace structures
+
+#endif
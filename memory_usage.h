@@ -0,0 +1,149 @@
+// Copyright 2017 Letícia do Nascimento
+
+#ifndef STRUCTURES_MEMORY_USAGE_H
+#define STRUCTURES_MEMORY_USAGE_H
+
+#include <cstdint>
+
+#include "./operation_stats.h"
+
+//  rótulo "arquivo:linha" do ponto onde for usado, para ObservedStats
+#define STRUCTURES_STRINGIFY_(x) #x
+#define STRUCTURES_STRINGIFY(x) STRUCTURES_STRINGIFY_(x)
+#define STRUCTURES_ALLOCATION_SITE __FILE__ ":" STRUCTURES_STRINGIFY(__LINE__)
+
+namespace structures {
+
+/**
+ * @brief      Memória ocupada por uma estrutura (memory_usage()). Os bytes
+ *             são os pedidos ao heap, sem o cabeçalho que o malloc acrescenta
+ *             a cada bloco e sem o próprio objeto da estrutura.
+ */
+struct MemoryUsage {
+    std::size_t elements{0u};  // dados guardados
+    std::size_t capacity{0u};  // dados que cabem sem nova alocação
+    std::size_t nodes{0u};  // nodos alocados (0 nos vetores)
+    std::size_t element_bytes{0u};  // elements * sizeof(T)
+    std::size_t link_bytes{0u};  // elos, sentinelas e alinhamento dos nodos
+    std::size_t unused_bytes{0u};  // espaço reservado e vazio
+    std::size_t bytes_allocated{0u};  // total no heap
+};
+
+/**
+ * @brief      Recebe cada alocação e liberação de uma estrutura que usa a
+ *             política ObservedStats, com o rótulo do ponto onde ela foi
+ *             criada. Um mesmo observador pode ser compartilhado por várias
+ *             estruturas (e threads, se a implementação permitir).
+ *             attached/detached avisam que bytes já alocados passaram a ser
+ *             (ou deixaram de ser) observados sob site, sem nova alocação
+ *             nem liberação; por padrão são ignorados.
+ */
+class AllocationObserver {
+ public:
+    virtual ~AllocationObserver() = default;
+
+    virtual void allocated(const char* site, std::size_t bytes) = 0;
+    virtual void released(const char* site, std::size_t bytes) = 0;
+
+    virtual void attached(const char*, std::size_t) { }
+    virtual void detached(const char*, std::size_t) { }
+};
+
+/**
+ * @brief      Política de estatísticas que, além dos contadores da
+ *             OperationStats, repassa alocações e liberações a um
+ *             AllocationObserver. A estrutura passa a aceitar
+ *             observe(observer, site).
+ */
+class ObservedStats : public OperationStats {
+ public:
+    void allocated(std::size_t bytes) const {
+        OperationStats::allocated(bytes);
+        if (observer_ != nullptr)
+            observer_->allocated(site_, bytes);
+    }
+
+    void released(std::size_t bytes) const {
+        OperationStats::released(bytes);
+        if (observer_ != nullptr)
+            observer_->released(site_, bytes);
+    }
+
+    //  troca o observador; a memória já alocada passa do antigo para o novo
+    //  sem contar como alocação ou liberação
+    void observe(AllocationObserver* observer, const char* site) {
+        std::size_t in_use = snapshot().bytes_in_use;
+        if (observer_ != nullptr && in_use > 0)
+            observer_->detached(site_, in_use);
+        observer_ = observer;
+        site_ = site;
+        if (observer_ != nullptr && in_use > 0)
+            observer_->attached(site_, in_use);
+    }
+
+ private:
+    AllocationObserver* observer_{nullptr};
+    const char* site_{""};
+};
+
+namespace detail {
+
+//  memory_usage() de uma estrutura sobre vetor
+template<typename T>
+MemoryUsage array_usage(std::size_t size, std::size_t capacity,
+                        std::size_t heap_bytes) {
+    MemoryUsage usage;
+    usage.elements = size;
+    usage.capacity = capacity;
+    usage.element_bytes = size * sizeof(T);
+    usage.unused_bytes = (capacity - size) * sizeof(T);
+    usage.bytes_allocated = heap_bytes;
+    return usage;
+}
+
+//  memory_usage() de uma estrutura encadeada com nodes nodos do tipo Node
+template<typename T, typename Node>
+MemoryUsage node_usage(std::size_t size, std::size_t nodes) {
+    MemoryUsage usage;
+    usage.elements = size;
+    usage.capacity = size;
+    usage.nodes = nodes;
+    usage.element_bytes = size * sizeof(T);
+    usage.bytes_allocated = nodes * sizeof(Node);
+    usage.link_bytes = usage.bytes_allocated - usage.element_bytes;
+    return usage;
+}
+
+//  memory_usage() de uma estrutura com os nodos num vetor de capacity nodos
+//  (IndexNodePool); os nodos livres contam como espaço vazio
+template<typename T, typename Node>
+MemoryUsage pool_usage(std::size_t size, std::size_t capacity) {
+    MemoryUsage usage = node_usage<T, Node>(size, size);
+    usage.capacity = capacity;
+    usage.unused_bytes = (capacity - size) * sizeof(Node);
+    usage.bytes_allocated += usage.unused_bytes;
+    return usage;
+}
+
+//  memory_usage() de uma estrutura em blocos (ou nodos) que guardam, no
+//  total, capacity dados e ocupam heap_bytes; o que não é dado nem espaço
+//  vazio conta como elos
+template<typename T>
+MemoryUsage block_usage(std::size_t size, std::size_t capacity,
+                        std::size_t blocks, std::size_t heap_bytes) {
+    MemoryUsage usage;
+    usage.elements = size;
+    usage.capacity = capacity;
+    usage.nodes = blocks;
+    usage.element_bytes = size * sizeof(T);
+    usage.unused_bytes = (capacity - size) * sizeof(T);
+    usage.bytes_allocated = heap_bytes;
+    usage.link_bytes = heap_bytes - usage.element_bytes - usage.unused_bytes;
+    return usage;
+}
+
+}  // namespace detail
+
+}  // namespace structures
+
+#endif
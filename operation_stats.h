@@ -0,0 +1,83 @@
+// Copyright 2017 Letícia do Nascimento
+
+#ifndef STRUCTURES_OPERATION_STATS_H
+#define STRUCTURES_OPERATION_STATS_H
+
+#include <cstdint>
+
+namespace structures {
+
+/**
+ * @brief      Fotografia dos contadores de uma estrutura, para exportação.
+ */
+struct StatsSnapshot {
+    std::size_t operations{0u};  // operações primitivas executadas
+    std::size_t nodes_traversed{0u};  // nodos percorridos em buscas/acessos
+    std::size_t element_shifts{0u};  // elementos deslocados no vetor
+    std::size_t allocations{0u};  // chamadas de new
+    std::size_t high_water{0u};  // maior tamanho já atingido
+    std::size_t bytes_allocated{0u};  // bytes pedidos ao heap, no total
+    std::size_t bytes_in_use{0u};  // bytes pedidos e ainda não liberados
+};
+
+/**
+ * @brief      Política de estatísticas desligada (padrão das estruturas).
+ *             Todas as chamadas são vazias e somem na compilação; como as
+ *             estruturas herdam da política, ela também não ocupa memória.
+ */
+class NoStats {
+ public:
+    void operation() const { }
+    void traversed(std::size_t) const { }
+    void shifted(std::size_t) const { }
+    void allocated(std::size_t) const { }
+    void released(std::size_t) const { }
+    void resized(std::size_t) const { }
+
+    StatsSnapshot snapshot() const { return StatsSnapshot(); }
+    void reset() { }
+};
+
+/**
+ * @brief      Política de estatísticas que conta operações, nodos
+ *             percorridos, deslocamentos, alocações (em chamadas e em bytes)
+ *             e o tamanho máximo.
+ *             Os contadores não são atômicos: seguem a mesma regra de
+ *             concorrência da estrutura que os contém.
+ */
+class OperationStats {
+ public:
+    void operation() const { counters_.operations++; }
+    void traversed(std::size_t nodes) const {
+        counters_.nodes_traversed += nodes;
+    }
+    void shifted(std::size_t elements) const {
+        counters_.element_shifts += elements;
+    }
+    void allocated(std::size_t bytes) const {
+        counters_.allocations++;
+        counters_.bytes_allocated += bytes;
+        counters_.bytes_in_use += bytes;
+    }
+    void released(std::size_t bytes) const {
+        counters_.bytes_in_use -= bytes;
+    }
+    void resized(std::size_t size) const {
+        if (size > counters_.high_water)
+            counters_.high_water = size;
+    }
+
+    StatsSnapshot snapshot() const { return counters_; }
+    void reset() {  // bytes_in_use é um nível, não um contador: é mantido
+        std::size_t in_use = counters_.bytes_in_use;
+        counters_ = StatsSnapshot();
+        counters_.bytes_in_use = in_use;
+    }
+
+ private:
+    mutable StatsSnapshot counters_;
+};
+
+}  // namespace structures
+
+#endif
@@ -0,0 +1,577 @@
+// Copyright 2017 Letícia do Nascimento
+
+#ifndef STRUCTURES_OPERATION_TRACE_H
+#define STRUCTURES_OPERATION_TRACE_H
+
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <utility>  // std::forward
+
+namespace structures {
+
+/**
+ * @brief      Operações registradas num trace. Pilhas e filas usam as mesmas
+ *             operações das listas: push e enqueue são PUSH_BACK, o pop da
+ *             pilha é POP_BACK e dequeue é POP_FRONT.
+ */
+enum class TraceOperation : std::uint8_t {
+    PUSH_BACK,
+    PUSH_FRONT,
+    INSERT,  // dado e índice
+    INSERT_SORTED,
+    POP_BACK,
+    POP_FRONT,
+    POP,  // índice
+    REMOVE,
+    FIND,
+    CONTAINS,
+    AT,  // índice
+    CLEAR,
+    COUNT  // quantidade de operações, não é uma operação
+};
+
+/**
+ * @brief      Uma operação do trace, com o dado e o índice que ela usa.
+ */
+struct TraceRecord {
+    TraceOperation operation{TraceOperation::CLEAR};
+    std::int64_t data{0};
+    std::uint64_t index{0u};
+};
+
+namespace detail {
+
+const char TRACE_MAGIC[4] = {'S', 'T', 'R', 'C'};
+const std::uint8_t TRACE_VERSION = 1;
+
+inline bool trace_has_data(TraceOperation operation) {
+    switch (operation) {
+        case TraceOperation::PUSH_BACK:
+        case TraceOperation::PUSH_FRONT:
+        case TraceOperation::INSERT:
+        case TraceOperation::INSERT_SORTED:
+        case TraceOperation::REMOVE:
+        case TraceOperation::FIND:
+        case TraceOperation::CONTAINS:
+            return true;
+        default:
+            return false;
+    }
+}
+
+inline bool trace_has_index(TraceOperation operation) {
+    return operation == TraceOperation::INSERT ||
+           operation == TraceOperation::POP ||
+           operation == TraceOperation::AT;
+}
+
+}  // namespace detail
+
+/**
+ * @brief      Grava operações num fluxo binário compacto: um cabeçalho de 5
+ *             bytes e, por operação, 1 byte de código seguido do dado (zigzag)
+ *             e do índice em varint, só quando a operação os usa. Um push de
+ *             um inteiro pequeno ocupa 2 bytes.
+ */
+class TraceWriter {
+ public:
+    explicit TraceWriter(std::ostream& output);
+
+    void write(const TraceRecord& record);  // grava uma operação
+    void write(TraceOperation operation, std::int64_t data = 0,
+               std::uint64_t index = 0);
+
+    std::uint64_t records() const;  // operações gravadas
+
+ private:
+    void write_varint(std::uint64_t value);
+
+    std::ostream& output_;
+    std::uint64_t records_{0u};
+};
+
+/**
+ * @brief      Lê o fluxo gravado por uma TraceWriter.
+ */
+class TraceReader {
+ public:
+    explicit TraceReader(std::istream& input);
+
+    bool read(TraceRecord& record);  // próxima operação; false no fim
+
+ private:
+    std::uint64_t read_varint();
+
+    std::istream& input_;
+};
+
+/**
+ * @brief      Envolve uma estrutura e grava num TraceWriter cada operação que
+ *             termina sem exceção, com a mesma interface da estrutura. Só os
+ *             métodos usados são instanciados, então serve para as listas,
+ *             pilhas e filas. Os dados são gravados como inteiros de 64 bits.
+ *
+ * @tparam     T          Tipo dos dados (inteiro)
+ * @tparam     Structure  Estrutura envolvida
+ */
+template<typename T, typename Structure>
+class Traced : public Structure {
+ public:
+    template<typename... Args>
+    explicit Traced(TraceWriter& writer, Args&&... args);
+
+    void push_back(const T& data);
+    void push_front(const T& data);
+    void insert(const T& data, std::size_t index);
+    void insert_sorted(const T& data);
+    T pop_back();
+    T pop_front();
+    T pop(std::size_t index);
+    T pop();  // pilha
+    void remove(const T& data);
+    std::size_t find(const T& data) const;
+    bool contains(const T& data) const;
+    T& at(std::size_t index);
+    void clear();
+
+    void push(const T& data);  // pilha
+    void enqueue(const T& data);  // fila
+    T dequeue();  // fila
+
+ private:
+    void record(TraceOperation operation, const T& data = T(),
+                std::size_t index = 0) const {
+        writer_.write(operation, static_cast<std::int64_t>(data), index);
+    }
+
+    TraceWriter& writer_;
+};
+
+/**
+ *   Construtor da classe TraceWriter: grava o cabeçalho.
+ */
+inline TraceWriter::TraceWriter(std::ostream& output) :
+    output_(output)
+{
+    output_.write(detail::TRACE_MAGIC, sizeof(detail::TRACE_MAGIC));
+    output_.put(static_cast<char>(detail::TRACE_VERSION));
+}
+
+/**
+ *   Grava uma operação (TraceWriter).
+ */
+inline void TraceWriter::write(const TraceRecord& record) {
+    output_.put(static_cast<char>(record.operation));
+    if (detail::trace_has_data(record.operation)) {
+        std::uint64_t data = static_cast<std::uint64_t>(record.data);
+        write_varint((data << 1) ^ (record.data < 0 ? ~std::uint64_t(0) : 0));
+    }
+    if (detail::trace_has_index(record.operation))
+        write_varint(record.index);
+    records_++;
+}
+
+/**
+ *   Grava uma operação a partir dos seus campos (TraceWriter).
+ */
+inline void TraceWriter::write(TraceOperation operation, std::int64_t data,
+                               std::uint64_t index) {
+    TraceRecord record;
+    record.operation = operation;
+    record.data = data;
+    record.index = index;
+    write(record);
+}
+
+/**
+ *   Retorna quantas operações foram gravadas (TraceWriter).
+ */
+inline std::uint64_t TraceWriter::records() const {
+    return records_;
+}
+
+/**
+ *   Grava value em 7 bits por byte, o bit alto indicando continuação
+ * (TraceWriter).
+ */
+inline void TraceWriter::write_varint(std::uint64_t value) {
+    while (value >= 0x80) {
+        output_.put(static_cast<char>((value & 0x7f) | 0x80));
+        value >>= 7;
+    }
+    output_.put(static_cast<char>(value));
+}
+
+/**
+ *   Construtor da classe TraceReader: confere o cabeçalho.
+ */
+inline TraceReader::TraceReader(std::istream& input) :
+    input_(input)
+{
+    char header[sizeof(detail::TRACE_MAGIC) + 1];
+    if (!input_.read(header, sizeof(header)))
+        throw std::invalid_argument("Trace sem cabeçalho.");
+    for (std::size_t i = 0; i < sizeof(detail::TRACE_MAGIC); i++)
+        if (header[i] != detail::TRACE_MAGIC[i])
+            throw std::invalid_argument("Trace inválido.");
+    if (static_cast<std::uint8_t>(header[sizeof(detail::TRACE_MAGIC)]) !=
+        detail::TRACE_VERSION)
+        throw std::invalid_argument("Versão de trace desconhecida.");
+}
+
+/**
+ *   Lê a próxima operação em record (TraceReader); retorna false no fim do
+ * fluxo.
+ */
+inline bool TraceReader::read(TraceRecord& record) {
+    int code = input_.get();
+    if (code == std::istream::traits_type::eof())
+        return false;
+    if (code >= static_cast<int>(TraceOperation::COUNT))
+        throw std::invalid_argument("Operação de trace inválida.");
+
+    record.operation = static_cast<TraceOperation>(code);
+    record.data = 0;
+    record.index = 0;
+    if (detail::trace_has_data(record.operation)) {
+        std::uint64_t data = read_varint();
+        record.data = static_cast<std::int64_t>(data >> 1) ^
+                      -static_cast<std::int64_t>(data & 1);
+    }
+    if (detail::trace_has_index(record.operation))
+        record.index = read_varint();
+    return true;
+}
+
+/**
+ *   Lê um varint gravado por write_varint (TraceReader).
+ */
+inline std::uint64_t TraceReader::read_varint() {
+    std::uint64_t value = 0;
+    for (unsigned shift = 0; shift < 64; shift += 7) {
+        int byte = input_.get();
+        if (byte == std::istream::traits_type::eof())
+            throw std::invalid_argument("Trace truncado.");
+        value |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0)
+            return value;
+    }
+    throw std::invalid_argument("Trace inválido.");
+}
+
+/**
+ *   Construtor da classe Traced; args são repassados à estrutura.
+ */
+template<typename T, typename Structure>
+template<typename... Args>
+Traced<T, Structure>::Traced(TraceWriter& writer, Args&&... args) :
+    Structure(std::forward<Args>(args)...),
+    writer_(writer)
+{}
+
+/**
+ *   Insere no fim e grava PUSH_BACK (Traced).
+ */
+template<typename T, typename Structure>
+void Traced<T, Structure>::push_back(const T& data) {
+    Structure::push_back(data);
+    record(TraceOperation::PUSH_BACK, data);
+}
+
+/**
+ *   Insere no início e grava PUSH_FRONT (Traced).
+ */
+template<typename T, typename Structure>
+void Traced<T, Structure>::push_front(const T& data) {
+    Structure::push_front(data);
+    record(TraceOperation::PUSH_FRONT, data);
+}
+
+/**
+ *   Insere na posição index e grava INSERT (Traced).
+ */
+template<typename T, typename Structure>
+void Traced<T, Structure>::insert(const T& data, std::size_t index) {
+    Structure::insert(data, index);
+    record(TraceOperation::INSERT, data, index);
+}
+
+/**
+ *   Insere em ordem e grava INSERT_SORTED (Traced).
+ */
+template<typename T, typename Structure>
+void Traced<T, Structure>::insert_sorted(const T& data) {
+    Structure::insert_sorted(data);
+    record(TraceOperation::INSERT_SORTED, data);
+}
+
+/**
+ *   Retira do fim e grava POP_BACK (Traced).
+ */
+template<typename T, typename Structure>
+T Traced<T, Structure>::pop_back() {
+    T data = Structure::pop_back();
+    record(TraceOperation::POP_BACK);
+    return data;
+}
+
+/**
+ *   Retira do início e grava POP_FRONT (Traced).
+ */
+template<typename T, typename Structure>
+T Traced<T, Structure>::pop_front() {
+    T data = Structure::pop_front();
+    record(TraceOperation::POP_FRONT);
+    return data;
+}
+
+/**
+ *   Retira da posição index e grava POP (Traced).
+ */
+template<typename T, typename Structure>
+T Traced<T, Structure>::pop(std::size_t index) {
+    T data = Structure::pop(index);
+    record(TraceOperation::POP, T(), index);
+    return data;
+}
+
+/**
+ *   Desempilha e grava POP_BACK (Traced).
+ */
+template<typename T, typename Structure>
+T Traced<T, Structure>::pop() {
+    T data = Structure::pop();
+    record(TraceOperation::POP_BACK);
+    return data;
+}
+
+/**
+ *   Remove o dado e grava REMOVE (Traced).
+ */
+template<typename T, typename Structure>
+void Traced<T, Structure>::remove(const T& data) {
+    Structure::remove(data);
+    record(TraceOperation::REMOVE, data);
+}
+
+/**
+ *   Procura o dado e grava FIND (Traced).
+ */
+template<typename T, typename Structure>
+std::size_t Traced<T, Structure>::find(const T& data) const {
+    std::size_t index = Structure::find(data);
+    record(TraceOperation::FIND, data);
+    return index;
+}
+
+/**
+ *   Verifica se contém o dado e grava CONTAINS (Traced).
+ */
+template<typename T, typename Structure>
+bool Traced<T, Structure>::contains(const T& data) const {
+    bool found = Structure::contains(data);
+    record(TraceOperation::CONTAINS, data);
+    return found;
+}
+
+/**
+ *   Acessa a posição index e grava AT (Traced).
+ */
+template<typename T, typename Structure>
+T& Traced<T, Structure>::at(std::size_t index) {
+    T& data = Structure::at(index);
+    record(TraceOperation::AT, T(), index);
+    return data;
+}
+
+/**
+ *   Limpa a estrutura e grava CLEAR (Traced).
+ */
+template<typename T, typename Structure>
+void Traced<T, Structure>::clear() {
+    Structure::clear();
+    record(TraceOperation::CLEAR);
+}
+
+/**
+ *   Empilha e grava PUSH_BACK (Traced).
+ */
+template<typename T, typename Structure>
+void Traced<T, Structure>::push(const T& data) {
+    Structure::push(data);
+    record(TraceOperation::PUSH_BACK, data);
+}
+
+/**
+ *   Enfila e grava PUSH_BACK (Traced).
+ */
+template<typename T, typename Structure>
+void Traced<T, Structure>::enqueue(const T& data) {
+    Structure::enqueue(data);
+    record(TraceOperation::PUSH_BACK, data);
+}
+
+/**
+ *   Desenfila e grava POP_FRONT (Traced).
+ */
+template<typename T, typename Structure>
+T Traced<T, Structure>::dequeue() {
+    T data = Structure::dequeue();
+    record(TraceOperation::POP_FRONT);
+    return data;
+}
+
+namespace detail {
+
+//  prioridades para escolher o método da estrutura: Rank<1> antes de Rank<0>
+template<unsigned N> struct Rank : Rank<N - 1> { };
+template<> struct Rank<0> { };
+
+template<typename T, typename S>
+auto replay_push_back(S& s, const T& data, Rank<2>)
+    -> decltype(s.push_back(data), bool()) { s.push_back(data); return true; }
+template<typename T, typename S>
+auto replay_push_back(S& s, const T& data, Rank<1>)
+    -> decltype(s.push(data), bool()) { s.push(data); return true; }
+template<typename T, typename S>
+auto replay_push_back(S& s, const T& data, Rank<0>)
+    -> decltype(s.enqueue(data), bool()) { s.enqueue(data); return true; }
+template<typename T, typename S>
+bool replay_push_back(S&, const T&, ...) { return false; }
+
+template<typename T, typename S>
+auto replay_pop_back(S& s, std::int64_t& sum, Rank<1>)
+    -> decltype(s.pop_back(), bool()) { sum += s.pop_back(); return true; }
+template<typename T, typename S>
+auto replay_pop_back(S& s, std::int64_t& sum, Rank<0>)
+    -> decltype(s.pop(), bool()) { sum += s.pop(); return true; }
+template<typename T, typename S>
+bool replay_pop_back(S&, std::int64_t&, ...) { return false; }
+
+template<typename T, typename S>
+auto replay_pop_front(S& s, std::int64_t& sum, Rank<1>)
+    -> decltype(s.pop_front(), bool()) { sum += s.pop_front(); return true; }
+template<typename T, typename S>
+auto replay_pop_front(S& s, std::int64_t& sum, Rank<0>)
+    -> decltype(s.dequeue(), bool()) { sum += s.dequeue(); return true; }
+template<typename T, typename S>
+bool replay_pop_front(S&, std::int64_t&, ...) { return false; }
+
+template<typename T, typename S>
+auto replay_push_front(S& s, const T& data, Rank<0>)
+    -> decltype(s.push_front(data), bool()) {
+    s.push_front(data);
+    return true;
+}
+template<typename T, typename S>
+bool replay_push_front(S&, const T&, ...) { return false; }
+
+template<typename T, typename S>
+auto replay_insert(S& s, const T& data, std::size_t index, Rank<0>)
+    -> decltype(s.insert(data, index), bool()) {
+    s.insert(data, index);
+    return true;
+}
+template<typename T, typename S>
+bool replay_insert(S&, const T&, std::size_t, ...) { return false; }
+
+template<typename T, typename S>
+auto replay_insert_sorted(S& s, const T& data, Rank<0>)
+    -> decltype(s.insert_sorted(data), bool()) {
+    s.insert_sorted(data);
+    return true;
+}
+template<typename T, typename S>
+bool replay_insert_sorted(S&, const T&, ...) { return false; }
+
+template<typename T, typename S>
+auto replay_pop(S& s, std::size_t index, std::int64_t& sum, Rank<0>)
+    -> decltype(s.pop(index), bool()) { sum += s.pop(index); return true; }
+template<typename T, typename S>
+bool replay_pop(S&, std::size_t, std::int64_t&, ...) { return false; }
+
+template<typename T, typename S>
+auto replay_remove(S& s, const T& data, Rank<0>)
+    -> decltype(s.remove(data), bool()) { s.remove(data); return true; }
+template<typename T, typename S>
+bool replay_remove(S&, const T&, ...) { return false; }
+
+template<typename T, typename S>
+auto replay_find(S& s, const T& data, std::int64_t& sum, Rank<0>)
+    -> decltype(s.find(data), bool()) {
+    sum += static_cast<std::int64_t>(s.find(data));
+    return true;
+}
+template<typename T, typename S>
+bool replay_find(S&, const T&, std::int64_t&, ...) { return false; }
+
+template<typename T, typename S>
+auto replay_contains(S& s, const T& data, std::int64_t& sum, Rank<0>)
+    -> decltype(s.contains(data), bool()) {
+    sum += s.contains(data) ? 1 : 0;
+    return true;
+}
+template<typename T, typename S>
+bool replay_contains(S&, const T&, std::int64_t&, ...) { return false; }
+
+template<typename T, typename S>
+auto replay_at(S& s, std::size_t index, std::int64_t& sum, Rank<0>)
+    -> decltype(s.at(index), bool()) { sum += s.at(index); return true; }
+template<typename T, typename S>
+bool replay_at(S&, std::size_t, std::int64_t&, ...) { return false; }
+
+}  // namespace detail
+
+/**
+ *   Aplica record à estrutura, escolhendo o método equivalente ao gravado
+ * (push ou enqueue para PUSH_BACK, por exemplo). Retorna false se a estrutura
+ * não tem a operação. Os resultados de retiradas e consultas são somados em
+ * checksum, para comparar estruturas que repetem o mesmo trace. Exceções da
+ * estrutura (como retirar de uma estrutura vazia) são propagadas.
+ *
+ * @tparam     T          Tipo dos dados da estrutura
+ */
+template<typename T, typename Structure>
+bool replay_operation(Structure& structure, const TraceRecord& record,
+                      std::int64_t& checksum) {
+    T data = static_cast<T>(record.data);
+    std::size_t index = static_cast<std::size_t>(record.index);
+    detail::Rank<2> rank;
+
+    switch (record.operation) {
+        case TraceOperation::PUSH_BACK:
+            return detail::replay_push_back<T>(structure, data, rank);
+        case TraceOperation::PUSH_FRONT:
+            return detail::replay_push_front<T>(structure, data, rank);
+        case TraceOperation::INSERT:
+            return detail::replay_insert<T>(structure, data, index, rank);
+        case TraceOperation::INSERT_SORTED:
+            return detail::replay_insert_sorted<T>(structure, data, rank);
+        case TraceOperation::POP_BACK:
+            return detail::replay_pop_back<T>(structure, checksum, rank);
+        case TraceOperation::POP_FRONT:
+            return detail::replay_pop_front<T>(structure, checksum, rank);
+        case TraceOperation::POP:
+            return detail::replay_pop<T>(structure, index, checksum, rank);
+        case TraceOperation::REMOVE:
+            return detail::replay_remove<T>(structure, data, rank);
+        case TraceOperation::FIND:
+            return detail::replay_find<T>(structure, data, checksum, rank);
+        case TraceOperation::CONTAINS:
+            return detail::replay_contains<T>(structure, data, checksum,
+                                              rank);
+        case TraceOperation::AT:
+            return detail::replay_at<T>(structure, index, checksum, rank);
+        case TraceOperation::CLEAR:
+            structure.clear();
+            return true;
+        default:
+            return false;
+    }
+}
+
+}  // namespace structures
+
+#endif
@@ -0,0 +1,245 @@
+// Copyright 2017 Letícia do Nascimento
+
+#ifndef STRUCTURES_PARALLEL_H
+#define STRUCTURES_PARALLEL_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>  // std::move
+#include <vector>
+
+namespace structures {
+
+/**
+ * @brief      Configuração das operações paralelas sobre ArrayList. Listas
+ *             com menos de threshold elementos são processadas na thread
+ *             atual, onde repartir o trabalho custaria mais que a própria
+ *             operação. threads define em quantas partes a lista é dividida;
+ *             elas rodam nas threads do ThreadPool::shared().
+ */
+struct ParallelOptions {
+    std::size_t threads{0u};  // 0: std::thread::hardware_concurrency()
+    std::size_t threshold{1u << 16};  // tamanho mínimo para paralelizar
+};
+
+namespace detail {
+
+//  quantidade de partes em que [0, size) será dividido
+inline std::size_t parallel_parts(std::size_t size,
+                                  const ParallelOptions& options) {
+    if (size < options.threshold || size < 2)
+        return 1;
+    std::size_t threads = options.threads;
+    if (threads == 0)
+        threads = std::thread::hardware_concurrency();
+    if (threads == 0)
+        threads = 1;
+    return threads < size ? threads : size;
+}
+
+//  início da parte index quando [0, size) é dividido em parts partes
+//  contíguas; as size % parts primeiras têm um elemento a mais
+inline std::size_t parallel_bound(std::size_t size, std::size_t parts,
+                                  std::size_t index) {
+    std::size_t extra = size % parts;
+    return index * (size / parts) + (index < extra ? index : extra);
+}
+
+/**
+ * @brief      Threads reaproveitadas pelas operações paralelas, para que cada
+ *             chamada não pague a criação e o join de threads novas. Quem
+ *             espera um lote (wait) também executa trabalhos da fila, então
+ *             uma operação paralela dentro de outra não trava o pool.
+ */
+class ThreadPool {
+ public:
+    //  trabalhos submetidos juntos; wait espera pending chegar a zero
+    struct Batch {
+        std::size_t pending{0u};
+        std::exception_ptr error;  // primeira exceção de um trabalho
+    };
+
+    explicit ThreadPool(std::size_t threads);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    void submit(Batch& batch, std::function<void()> job);  // enfileira
+    void wait(Batch& batch);  // executa e espera os trabalhos do lote
+
+    //  pool do processo, com hardware_concurrency() - 1 threads
+    static ThreadPool& shared();
+
+ private:
+    struct Job {
+        std::function<void()> run;
+        Batch* batch;
+    };
+
+    void execute(Job& job);  // roda job e dá baixa no lote
+    void work();  // laço de cada thread
+
+    std::mutex mutex_;
+    std::condition_variable work_;  // há trabalho ou o pool está parando
+    std::condition_variable done_;  // algum lote terminou
+    std::deque<Job> jobs_;
+    std::vector<std::thread> threads_;
+    bool stopping_{false};
+};
+
+/**
+ *   Construtor da classe ThreadPool: inicia threads threads. Se a criação
+ * de uma delas falhar, as já criadas são encerradas antes da exceção.
+ */
+inline ThreadPool::ThreadPool(std::size_t threads) {
+    try {
+        threads_.reserve(threads);
+        for (std::size_t i = 0; i < threads; i++)
+            threads_.emplace_back(&ThreadPool::work, this);
+    } catch (...) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        work_.notify_all();
+        for (auto& thread : threads_)
+            thread.join();
+        throw;
+    }
+}
+
+/**
+ *   Destrutor da classe ThreadPool: encerra as threads, que antes terminam
+ * os trabalhos da fila.
+ */
+inline ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    work_.notify_all();
+    for (auto& thread : threads_)
+        thread.join();
+}
+
+/**
+ *   Enfileira job como parte de batch (ThreadPool).
+ */
+inline void ThreadPool::submit(Batch& batch, std::function<void()> job) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        jobs_.push_back(Job{std::move(job), &batch});
+        batch.pending++;
+    }
+    work_.notify_one();
+}
+
+/**
+ *   Espera todos os trabalhos de batch terminarem, executando trabalhos da
+ * fila enquanto houver (ThreadPool). Não lança: a exceção de um trabalho
+ * fica em batch.error.
+ */
+inline void ThreadPool::wait(Batch& batch) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (batch.pending > 0) {
+        if (jobs_.empty()) {
+            done_.wait(lock);
+            continue;
+        }
+        Job job = std::move(jobs_.front());
+        jobs_.pop_front();
+        lock.unlock();
+        execute(job);
+        lock.lock();
+    }
+}
+
+/**
+ *   Executa job, guarda a sua exceção e dá baixa no lote (ThreadPool).
+ */
+inline void ThreadPool::execute(Job& job) {
+    std::exception_ptr error;
+    try {
+        job.run();
+    } catch (...) {
+        error = std::current_exception();
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (error && !job.batch->error)
+        job.batch->error = error;
+    if (--job.batch->pending == 0)
+        done_.notify_all();
+}
+
+/**
+ *   Laço de uma thread do pool (ThreadPool).
+ */
+inline void ThreadPool::work() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        work_.wait(lock, [this] { return stopping_ || !jobs_.empty(); });
+        if (jobs_.empty())
+            return;  // parando e sem trabalho
+        Job job = std::move(jobs_.front());
+        jobs_.pop_front();
+        lock.unlock();
+        execute(job);
+        lock.lock();
+    }
+}
+
+/**
+ *   Retorna o pool do processo, criado no primeiro uso (ThreadPool). A
+ * thread que chama a operação paralela faz uma das partes, por isso o pool
+ * tem uma thread a menos que o hardware.
+ */
+inline ThreadPool& ThreadPool::shared() {
+    static ThreadPool pool(std::thread::hardware_concurrency() > 1
+                           ? std::thread::hardware_concurrency() - 1 : 0);
+    return pool;
+}
+
+//  executa task(begin, end) em partes contíguas de [0, size): a última na
+//  thread atual e as outras no ThreadPool; a primeira exceção de uma parte
+//  é relançada depois que todas terminam
+template<typename Task>
+void parallel_ranges(std::size_t size, const ParallelOptions& options,
+                     Task task) {
+    std::size_t parts = parallel_parts(size, options);
+    if (parts == 1) {
+        task(std::size_t{0}, size);
+        return;
+    }
+
+    ThreadPool& pool = ThreadPool::shared();
+    ThreadPool::Batch batch;
+    std::size_t begin = 0;
+    try {
+        for (std::size_t i = 0; i < parts; i++) {
+            std::size_t end = parallel_bound(size, parts, i + 1);
+            if (i + 1 == parts)
+                task(begin, end);  // a última parte fica com a thread atual
+            else
+                pool.submit(batch, [&task, begin, end] { task(begin, end); });
+            begin = end;
+        }
+    } catch (...) {
+        pool.wait(batch);  // as partes usam task e a pilha desta chamada
+        throw;
+    }
+    pool.wait(batch);
+    if (batch.error)
+        std::rethrow_exception(batch.error);
+}
+
+}  // namespace detail
+
+}  // namespace structures
+
+#endif
@@ -0,0 +1,117 @@
+// Copyright 2017 Letícia do Nascimento
+
+#ifndef STRUCTURES_PARALLEL_ARRAY_LIST_H
+#define STRUCTURES_PARALLEL_ARRAY_LIST_H
+
+#include <atomic>
+#include <cstdint>
+
+#include "./array_list.cpp"
+#include "./parallel.h"
+
+namespace structures {
+
+/**
+ *   Retorna o menor índice cujo elemento satisfaz pred, ou size() se nenhum
+ * satisfaz. As partes que começam depois de um índice já encontrado param
+ * cedo. pred é chamado concorrentemente; se lançar, a primeira exceção é
+ * relançada aqui depois que todas as partes terminam.
+ */
+template<typename T, std::size_t Inline, typename Stats, typename Predicate>
+std::size_t parallel_find_if(const ArrayList<T, Inline, Stats>& list,
+                             Predicate pred,
+                             const ParallelOptions& options = {}) {
+    const T* contents = list.data();
+    std::atomic<std::size_t> found{list.size()};
+    detail::parallel_ranges(list.size(), options,
+        [&](std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; i++) {
+                if ((i & 1023u) == 0 &&
+                    found.load(std::memory_order_relaxed) < begin)
+                    return;
+                if (pred(contents[i])) {
+                    std::size_t current = found.load(std::memory_order_relaxed);
+                    while (i < current &&
+                           !found.compare_exchange_weak(current, i)) { }
+                    return;
+                }
+            }
+        });
+    return found.load();
+}
+
+/**
+ *   Versão paralela de ArrayList::find: menor índice igual a data, ou
+ * size() se não encontrado.
+ */
+template<typename T, std::size_t Inline, typename Stats>
+std::size_t parallel_find(const ArrayList<T, Inline, Stats>& list,
+                          const T& data,
+                          const ParallelOptions& options = {}) {
+    return parallel_find_if(list, [&data](const T& item) {
+        return item == data;
+    }, options);
+}
+
+/**
+ *   Versão paralela de ArrayList::contains.
+ */
+template<typename T, std::size_t Inline, typename Stats>
+bool parallel_contains(const ArrayList<T, Inline, Stats>& list, const T& data,
+                       const ParallelOptions& options = {}) {
+    return parallel_find(list, data, options) != list.size();
+}
+
+/**
+ *   Conta, em paralelo, quantos elementos satisfazem pred.
+ */
+template<typename T, std::size_t Inline, typename Stats, typename Predicate>
+std::size_t parallel_count_if(const ArrayList<T, Inline, Stats>& list,
+                              Predicate pred,
+                              const ParallelOptions& options = {}) {
+    const T* contents = list.data();
+    std::atomic<std::size_t> total{0u};
+    detail::parallel_ranges(list.size(), options,
+        [&](std::size_t begin, std::size_t end) {
+            std::size_t count = 0;
+            for (std::size_t i = begin; i < end; i++) {
+                if (pred(contents[i]))
+                    count++;
+            }
+            total.fetch_add(count, std::memory_order_relaxed);
+        });
+    return total.load();
+}
+
+/**
+ *   Aplica function(elemento) a todos os elementos, em paralelo e sem ordem
+ * definida entre as partes.
+ */
+template<typename T, std::size_t Inline, typename Stats, typename Function>
+void parallel_for_each(ArrayList<T, Inline, Stats>& list, Function function,
+                       const ParallelOptions& options = {}) {
+    T* contents = list.data();
+    detail::parallel_ranges(list.size(), options,
+        [&](std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; i++)
+                function(contents[i]);
+        });
+}
+
+/**
+ *   Substitui, em paralelo, cada elemento por function(elemento).
+ */
+template<typename T, std::size_t Inline, typename Stats, typename Function>
+void parallel_transform(ArrayList<T, Inline, Stats>& list, Function function,
+                        const ParallelOptions& options = {}) {
+    T* contents = list.data();
+    detail::parallel_ranges(list.size(), options,
+        [&](std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; i++)
+                contents[i] = function(contents[i]);
+        });
+}
+
+}  // namespace structures
+
+#endif
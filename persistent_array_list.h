@@ -0,0 +1,448 @@
+//  Copyright 2017 Letícia do Nascimento
+
+#ifndef STRUCTURES_PERSISTENT_ARRAY_LIST_H
+#define STRUCTURES_PERSISTENT_ARRAY_LIST_H
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdint>  // std::size_t
+#include <cstring>
+#include <stdexcept>  // C++ exceptions
+#include <system_error>
+#include <type_traits>
+
+#include "./array_snapshot.h"  // SnapshotHeader
+#include "./memory_usage.h"
+#include "./operation_stats.h"
+
+namespace structures {
+
+    /**
+     * @brief      Lista em vetor (mesma interface da ArrayList) cujo vetor
+     *             vive num arquivo mapeado em memória. As páginas são
+     *             carregadas sob demanda, então a lista pode ser maior que a
+     *             RAM, e o conteúdo sobrevive ao reinício do processo. O
+     *             arquivo cresce com ftruncate + mremap quando a lista enche;
+     *             sync() grava um checkpoint com msync.
+     *
+     * @tparam     T      Parâmetro genérico de Template (trivialmente copiável)
+     * @tparam     Stats  Política de estatísticas; conta o mapeamento como
+     *                    alocação
+     */
+
+    template<typename T, typename Stats = NoStats>
+    class PersistentArrayList : private Stats {
+    public:
+        explicit PersistentArrayList(const char* path);  // construtor
+        PersistentArrayList(const char* path, std::size_t capacity);  // construtor
+        ~PersistentArrayList();  // destrutor
+
+        PersistentArrayList(const PersistentArrayList&) = delete;
+        PersistentArrayList& operator=(const PersistentArrayList&) = delete;
+
+        void clear();  // limpa vetor
+        void push_back(const T& data);  // insere um dado por trás
+        void push_front(const T& data);  // insere um dado pela frente
+        void insert(const T& data, std::size_t index);  // insere elemento
+        void insert_sorted(const T& data);  // insere um dado em ordem
+        T pop(std::size_t index);  // retira um elemento em um indice e o retorna
+        T pop_back();  // retira o elemento por trás e o retorna
+        T pop_front();  // retira elemento pela frente e o retorna
+        void remove(const T& data);  // remove um elemento pre definido
+        bool empty() const;  // verifica se está vazio
+        bool contains(const T& data) const;  // verifica se o elemento está na lista
+        std::size_t find(const T& data) const;  // retorna endereço do elemento
+        std::size_t size() const;  // retorna tamanho atual
+        std::size_t capacity() const;  // espaço reservado no arquivo
+        void reserve(std::size_t capacity);  // aumenta o arquivo
+        void sync();  // checkpoint: grava as páginas alteradas no arquivo
+        T& at(std::size_t index);  // retorna o dado num determinado endereço
+        T& operator[](std::size_t index);
+        const T& at(std::size_t index) const;
+        const T& operator[](std::size_t index) const;
+
+        StatsSnapshot stats() const;  // contadores de estatísticas
+        void reset_stats();  // zera os contadores
+        std::size_t bytes_allocated() const;  // bytes mapeados
+        MemoryUsage memory_usage() const;  // detalhamento da memória
+        // repassa alocações a um observador (só com ObservedStats)
+        void observe(AllocationObserver* observer, const char* site);
+
+    private:
+        static_assert(std::is_trivially_copyable<T>::value,
+                      "PersistentArrayList exige T trivialmente copiável.");
+
+        std::size_t length(std::size_t capacity) const {
+            return sizeof(SnapshotHeader) + capacity * sizeof(T);
+        }
+
+        void map(std::size_t capacity);  // mapeia o arquivo aberto
+
+        int fd_;
+        void* base_;  // início do mapeamento (cabeçalho)
+        SnapshotHeader* header;  // tamanho e capacidade persistidos
+        T* contents;
+
+        static const auto DEFAULT_CAPACITY = 1024u;
+    };
+
+    namespace detail {
+
+    const char PERSISTENT_MAGIC[8] = {'I', 'N', 'E', '5', '4', '0', '8', 'P'};
+
+    }  // namespace detail
+
+}  // namespace structures
+
+#endif
+
+//  construtor da classe com capacidade padrão
+//  param path - arquivo da lista; é criado se não existir
+
+template <typename T, typename Stats>
+structures::PersistentArrayList<T, Stats>::PersistentArrayList(const char* path) :
+    PersistentArrayList(path, DEFAULT_CAPACITY)
+{}
+
+//  construtor da classe: abre a lista do arquivo ou cria uma nova vazia
+//  param path - arquivo da lista
+//  param capacity - capacidade inicial, caso o arquivo seja criado
+
+template <typename T, typename Stats>
+structures::PersistentArrayList<T, Stats>::PersistentArrayList(const char* path,
+                                                        std::size_t capacity) {
+    fd_ = ::open(path, O_RDWR | O_CREAT, 0644);
+    if (fd_ < 0)
+        throw std::system_error(errno, std::generic_category(),
+                                "Erro ao abrir lista persistente");
+
+    struct stat info;
+    if (::fstat(fd_, &info) < 0) {
+        int error = errno;
+        ::close(fd_);
+        throw std::system_error(error, std::generic_category(),
+                                "Erro ao abrir lista persistente");
+    }
+
+    std::size_t file_length = info.st_size;
+    if (file_length == 0) {
+        if (capacity == 0)
+            capacity = 1;
+        if (::ftruncate(fd_, length(capacity)) < 0) {
+            int error = errno;
+            ::close(fd_);
+            throw std::system_error(error, std::generic_category(),
+                                    "Erro ao criar lista persistente");
+        }
+        map(capacity);
+        std::memcpy(header->magic, detail::PERSISTENT_MAGIC,
+                    sizeof(header->magic));
+        header->version = detail::SNAPSHOT_VERSION;
+        header->element_size = sizeof(T);
+        header->size = 0;
+        header->max_size = capacity;
+        return;
+    }
+
+    SnapshotHeader stored;
+    if (file_length < sizeof(stored) ||
+        ::pread(fd_, &stored, sizeof(stored), 0) != sizeof(stored) ||
+        std::memcmp(stored.magic, detail::PERSISTENT_MAGIC,
+                    sizeof(stored.magic)) != 0 ||
+        stored.version != detail::SNAPSHOT_VERSION ||
+        stored.element_size != sizeof(T) ||
+        stored.max_size == 0 ||  // insert dobra a capacidade: 0 não cresce
+        stored.size > stored.max_size ||
+        stored.max_size > (file_length - sizeof(stored)) / sizeof(T)) {
+        ::close(fd_);
+        throw std::runtime_error("Lista persistente inválida ou incompatível.");
+    }
+    map(stored.max_size);
+}
+
+//  destrutor da classe: grava um checkpoint e desfaz o mapeamento
+
+template <typename T, typename Stats>
+structures::PersistentArrayList<T, Stats>::~PersistentArrayList() {
+    Stats::released(length(capacity()));
+    ::msync(base_, length(capacity()), MS_SYNC);
+    ::munmap(base_, length(capacity()));
+    ::close(fd_);
+}
+
+//  mapeia o arquivo aberto
+//  param capacity - capacidade (em elementos) coberta pelo mapeamento
+
+template <typename T, typename Stats>
+void structures::PersistentArrayList<T, Stats>::map(std::size_t capacity) {
+    base_ = ::mmap(nullptr, length(capacity), PROT_READ | PROT_WRITE,
+                   MAP_SHARED, fd_, 0);
+    if (base_ == MAP_FAILED) {
+        int error = errno;
+        ::close(fd_);
+        throw std::system_error(error, std::generic_category(),
+                                "Erro ao mapear lista persistente");
+    }
+    header = static_cast<SnapshotHeader*>(base_);
+    contents = reinterpret_cast<T*>(header + 1);
+    Stats::allocated(length(capacity));
+}
+
+//  aumenta o arquivo e o mapeamento; os dados podem mudar de endereço
+//  param capacity - nova capacidade em elementos
+
+template <typename T, typename Stats>
+void structures::PersistentArrayList<T, Stats>::reserve(std::size_t capacity) {
+    std::size_t old_length = length(this->capacity());
+    if (capacity <= this->capacity())
+        return;
+
+    if (::ftruncate(fd_, length(capacity)) < 0)
+        throw std::system_error(errno, std::generic_category(),
+                                "Erro ao aumentar lista persistente");
+
+    void* base = ::mremap(base_, old_length, length(capacity), MREMAP_MAYMOVE);
+    if (base == MAP_FAILED)
+        throw std::system_error(errno, std::generic_category(),
+                                "Erro ao remapear lista persistente");
+
+    base_ = base;
+    header = static_cast<SnapshotHeader*>(base_);
+    contents = reinterpret_cast<T*>(header + 1);
+    header->max_size = capacity;
+    Stats::allocated(length(capacity));
+    Stats::released(old_length);
+}
+
+//  grava as páginas alteradas no arquivo (checkpoint)
+
+template <typename T, typename Stats>
+void structures::PersistentArrayList<T, Stats>::sync() {
+    if (::msync(base_, length(capacity()), MS_SYNC) < 0)
+        throw std::system_error(errno, std::generic_category(),
+                                "Erro ao sincronizar lista persistente");
+}
+
+//  adiciona dados ao vetor, dobrando o arquivo quando está cheio
+//  param data - um generico que representa o dado a ser armazenado
+//  param index - um indice para ser inserido o dado
+
+template <typename T, typename Stats>
+void structures::PersistentArrayList<T, Stats>::insert(const T& data,
+                                                std::size_t index) {
+    if (index > size())
+        throw std::out_of_range("Erro! Posição inexistente.");
+
+    T value = data;  // data pode estar no vetor, que muda de endereço
+    if (size() == capacity())
+        reserve(2 * capacity());
+
+    std::size_t i = size();
+    while (i > index) {
+        contents[i] = contents[i - 1];
+        i--;
+    }
+    contents[index] = value;
+    header->size++;
+}
+
+//  retira dados do vetor por trás
+
+template <typename T, typename Stats>
+T structures::PersistentArrayList<T, Stats>::pop_back() {
+    if (empty())
+        throw std::out_of_range("Lista atualmente vazia.");
+    return pop(size() - 1);
+}
+
+//  retira dados do vetor pela frente
+
+template <typename T, typename Stats>
+T structures::PersistentArrayList<T, Stats>::pop_front() {
+    return pop(0);
+}
+
+//  retira dados do vetor com parametro
+//  param index - representa o endereço onde o dado será retirado
+
+template <typename T, typename Stats>
+T structures::PersistentArrayList<T, Stats>::pop(std::size_t index) {
+    if (empty()) {
+        throw std::out_of_range("Lista atualmente vazia.");
+    } else if (index >= size()) {
+        throw std::out_of_range("Erro! Posição inexistente.");
+    }
+
+    T retorno = contents[index];
+    for (std::size_t i = index; i < size() - 1; i++) {
+        contents[i] = contents[i + 1];
+    }
+    header->size--;
+    return retorno;
+}
+
+//  remove um elemento da lista
+//  param data - representa o elemento a ser removido
+
+template <typename T, typename Stats>
+void structures::PersistentArrayList<T, Stats>::remove(const T& data) {
+    if (!contains(data))
+        throw std::out_of_range("Elemento inexistente");
+    pop(find(data));
+}
+
+//  encontra um elemento na lista
+//  param data - representa o elemento a ser encontrado
+
+template <typename T, typename Stats>
+std::size_t structures::PersistentArrayList<T, Stats>::find(const T& data) const {
+    std::size_t i;
+    for (i = 0; i < size(); i++) {
+        if (contents[i] == data) {
+            break;
+        }
+    }
+    return i;
+}
+
+//  verifica se um elemento está na lista
+//  param data - representa o elemento a ser verificado
+
+template <typename T, typename Stats>
+bool structures::PersistentArrayList<T, Stats>::contains(const T& data) const {
+    return find(data) != size();
+}
+
+//  limpa a lista
+
+template <typename T, typename Stats>
+void structures::PersistentArrayList<T, Stats>::clear() {
+    header->size = 0;
+}
+
+//  retorna o tamanho da lista
+
+template <typename T, typename Stats>
+std::size_t structures::PersistentArrayList<T, Stats>::size() const {
+    return header->size;
+}
+
+//  retorna a capacidade reservada no arquivo
+
+template <typename T, typename Stats>
+std::size_t structures::PersistentArrayList<T, Stats>::capacity() const {
+    return header->max_size;
+}
+
+//  verifica se a lista está vazia
+
+template <typename T, typename Stats>
+bool structures::PersistentArrayList<T, Stats>::empty() const {
+    return size() == 0;
+}
+
+//  insere um elemento por trás
+
+template <typename T, typename Stats>
+void structures::PersistentArrayList<T, Stats>::push_back(const T& data) {
+    insert(data, size());
+}
+
+//  insere um elemento pela frente
+
+template <typename T, typename Stats>
+void structures::PersistentArrayList<T, Stats>::push_front(const T& data) {
+    insert(data, 0);
+}
+
+//  insere um elemento em ordem
+
+template <typename T, typename Stats>
+void structures::PersistentArrayList<T, Stats>::insert_sorted(const T& data) {
+    std::size_t i = 0;
+    while (i < size() && data > contents[i]) {
+        i++;
+    }
+    insert(data, i);
+}
+
+//  retorna o dado num determinado endereço
+
+template <typename T, typename Stats>
+T& structures::PersistentArrayList<T, Stats>::at(std::size_t index) {
+    if (index >= size())
+        throw std::out_of_range("Erro! Posição inexistente.");
+
+    return contents[index];
+}
+
+//  retorna o dado num determinado endereço
+
+template <typename T, typename Stats>
+T& structures::PersistentArrayList<T, Stats>::operator[](std::size_t index) {
+    return at(index);
+}
+
+//  retorna o dado num determinado endereço - versão const
+
+template <typename T, typename Stats>
+const T& structures::PersistentArrayList<T, Stats>::at(std::size_t index) const {
+    if (index >= size())
+        throw std::out_of_range("Erro! Posição inexistente.");
+
+    return contents[index];
+}
+
+//  retorna o dado num determinado endereço - versão const
+
+template <typename T, typename Stats>
+const T& structures::PersistentArrayList<T, Stats>::operator[](std::size_t index) const {
+    return at(index);
+}
+
+//  retorna os contadores da política de estatísticas
+
+template <typename T, typename Stats>
+structures::StatsSnapshot
+structures::PersistentArrayList<T, Stats>::stats() const {
+    return Stats::snapshot();
+}
+
+//  zera os contadores da política de estatísticas
+
+template <typename T, typename Stats>
+void structures::PersistentArrayList<T, Stats>::reset_stats() {
+    Stats::reset();
+}
+
+//  retorna os bytes mapeados do arquivo, cabeçalho incluído; as páginas só
+//  ocupam RAM quando são tocadas
+
+template <typename T, typename Stats>
+std::size_t structures::PersistentArrayList<T, Stats>::bytes_allocated() const {
+    return length(capacity());
+}
+
+//  retorna o detalhamento da memória mapeada; o cabeçalho conta como elos
+
+template <typename T, typename Stats>
+structures::MemoryUsage
+structures::PersistentArrayList<T, Stats>::memory_usage() const {
+    MemoryUsage usage = detail::array_usage<T>(size(), capacity(),
+                                               bytes_allocated());
+    usage.link_bytes = sizeof(SnapshotHeader);
+    return usage;
+}
+
+//  repassa as alocações ao observador com o rótulo site
+//  exige a política ObservedStats
+
+template <typename T, typename Stats>
+void structures::PersistentArrayList<T, Stats>::observe(
+        AllocationObserver* observer, const char* site) {
+    Stats::observe(observer, site);
+}
@@ -0,0 +1,256 @@
+// Copyright 2017 Letícia do Nascimento
+
+#ifndef STRUCTURES_PERSISTENT_STACK_H
+#define STRUCTURES_PERSISTENT_STACK_H
+
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>  // C++ exception
+
+#include "./memory_usage.h"
+
+namespace structures {
+
+/**
+ * @brief      Pilha (LIFO) persistente: cada versão é imutável, e push e pop
+ *             retornam uma nova versão em O(1) que compartilha os nodos
+ *             restantes com a anterior. Copiar uma pilha é só incrementar um
+ *             contador, então guardar versões para desfazer ou retroceder não
+ *             copia nodos. Os contadores de referência são atômicos: versões
+ *             diferentes podem ser usadas e destruídas em threads diferentes.
+ *
+ * @tparam     T     Parâmetro genérico de Template
+ */
+template<typename T>
+class PersistentStack {
+ public:
+    PersistentStack();
+    PersistentStack(const PersistentStack& other);
+    PersistentStack(PersistentStack&& other);
+    ~PersistentStack();
+
+    PersistentStack& operator=(const PersistentStack& other);
+    PersistentStack& operator=(PersistentStack&& other);
+
+    PersistentStack push(const T& data) const;  // versão com data no topo
+    PersistentStack pop() const;  // versão sem o topo
+
+    const T& top() const;  // dado no topo
+
+    bool empty() const;  // pilha vazia
+    std::size_t size() const;  // tamanho da pilha
+
+    // memória dos nodos desta versão, inclusive os compartilhados
+    std::size_t bytes_allocated() const;  // bytes no heap
+    std::size_t capacity() const;  // dados que cabem sem alocar
+    MemoryUsage memory_usage() const;  // detalhamento da memória
+
+ private:
+    class Node {
+     public:
+        Node(const T& data, Node* next) :
+            data_{data},
+            next_{next},
+            size_{next ? next->size() + 1 : 1},
+            references_{1}
+        {}
+
+        const T& data() const { return data_; }  // getter-constante: info
+
+        Node* next() const { return next_; }  // getter: próximo
+
+        std::size_t size() const { return size_; }  // tamanho até a base
+
+        void acquire() {  // mais uma versão aponta para este nodo
+            references_.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        bool release() {  // true quando era a última referência
+            return references_.fetch_sub(1, std::memory_order_acq_rel) == 1;
+        }
+
+     private:
+        T data_;
+        Node* next_;  // referência própria para o próximo
+        std::size_t size_;
+        std::atomic<std::size_t> references_;
+    };
+
+    explicit PersistentStack(Node* top) : top_{top} { }
+
+    static void acquire(Node* node);
+    static void release(Node* node);
+
+    Node* top_;  // nodo-topo, compartilhado entre versões
+};
+
+/**
+ *   Construtor padrão da classe PersistentStack: pilha vazia.
+ */
+template<typename T>
+PersistentStack<T>::PersistentStack() :
+    top_{nullptr}
+{}
+
+/**
+ *   Construtor de cópia da classe PersistentStack, em O(1): as duas versões
+ * compartilham os nodos.
+ */
+template<typename T>
+PersistentStack<T>::PersistentStack(const PersistentStack& other) :
+    top_{other.top_}
+{
+    acquire(top_);
+}
+
+/**
+ *   Construtor de movimento da classe PersistentStack.
+ */
+template<typename T>
+PersistentStack<T>::PersistentStack(PersistentStack&& other) :
+    top_{other.top_}
+{
+    other.top_ = nullptr;
+}
+
+/**
+ *   Destrutor da classe PersistentStack.
+ */
+template<typename T>
+PersistentStack<T>::~PersistentStack() {
+    release(top_);
+}
+
+/**
+ *   Atribuição de cópia da classe PersistentStack, em O(1).
+ */
+template<typename T>
+PersistentStack<T>& PersistentStack<T>::operator=(
+        const PersistentStack& other) {
+    acquire(other.top_);
+    release(top_);
+    top_ = other.top_;
+    return *this;
+}
+
+/**
+ *   Atribuição de movimento da classe PersistentStack.
+ */
+template<typename T>
+PersistentStack<T>& PersistentStack<T>::operator=(PersistentStack&& other) {
+    if (this != &other) {
+        release(top_);
+        top_ = other.top_;
+        other.top_ = nullptr;
+    }
+    return *this;
+}
+
+/**
+ *   Incrementa a referência de um nodo, se houver (PersistentStack).
+ */
+template<typename T>
+void PersistentStack<T>::acquire(Node* node) {
+    if (node != nullptr)
+        node->acquire();
+}
+
+/**
+ *   Solta a referência de um nodo e libera, iterativamente, os nodos que
+ * ficaram sem referências (PersistentStack). Cada nodo liberado solta a
+ * referência que tinha ao próximo, então pilhas longas não estouram a pilha
+ * de chamadas.
+ */
+template<typename T>
+void PersistentStack<T>::release(Node* node) {
+    while (node != nullptr && node->release()) {
+        Node* next = node->next();
+        delete node;
+        node = next;
+    }
+}
+
+/**
+ *   Retorna uma nova versão com data no topo (PersistentStack), em O(1).
+ */
+template<typename T>
+PersistentStack<T> PersistentStack<T>::push(const T& data) const {
+    acquire(top_);
+    Node* node;
+    try {
+        node = new Node(data, top_);
+    } catch (...) {
+        release(top_);
+        throw;
+    }
+    return PersistentStack(node);
+}
+
+/**
+ *   Retorna uma nova versão sem o topo (PersistentStack), em O(1).
+ */
+template<typename T>
+PersistentStack<T> PersistentStack<T>::pop() const {
+    if (empty())
+        throw std::out_of_range("Pilha vazia.");
+    Node* next = top_->next();
+    acquire(next);
+    return PersistentStack(next);
+}
+
+/**
+ *   Retorna o dado do topo (PersistentStack).
+ */
+template<typename T>
+const T& PersistentStack<T>::top() const {
+    if (empty())
+        throw std::out_of_range("Pilha vazia.");
+    return top_->data();
+}
+
+/**
+ *   Verifica se a pilha (PersistentStack) está vazia.
+ */
+template<typename T>
+bool PersistentStack<T>::empty() const {
+    return top_ == nullptr;
+}
+
+/**
+ *   Retorna o tamanho da pilha (PersistentStack).
+ */
+template<typename T>
+std::size_t PersistentStack<T>::size() const {
+    return top_ ? top_->size() : 0;
+}
+
+/**
+ *   Retorna os bytes dos nodos alcançáveis a partir desta versão
+ * (PersistentStack). Nodos compartilhados contam em todas as versões que os
+ * alcançam, então somar versões superestima a memória.
+ */
+template<typename T>
+std::size_t PersistentStack<T>::bytes_allocated() const {
+    return size() * sizeof(Node);
+}
+
+/**
+ *   Retorna quantos dados cabem sem alocar: um nodo por dado
+ * (PersistentStack).
+ */
+template<typename T>
+std::size_t PersistentStack<T>::capacity() const {
+    return size();
+}
+
+/**
+ *   Retorna o detalhamento da memória desta versão (PersistentStack).
+ */
+template<typename T>
+MemoryUsage PersistentStack<T>::memory_usage() const {
+    return detail::node_usage<T, Node>(size(), size());
+}
+
+}  // namespace structures
+
+#endif
@@ -0,0 +1,15 @@
+// Copyright 2017 Letícia do Nascimento
+
+#ifndef STRUCTURES_PREFETCH_H
+#define STRUCTURES_PREFETCH_H
+
+//  Pede ao processador que comece a trazer address para a cache sem esperar
+//  por ele. Usado nos percursos das listas encadeadas para buscar o próximo
+//  nodo enquanto o atual é comparado. Prefetch não falha, nem com nullptr.
+#if defined(__GNUC__) || defined(__clang__)
+#define STRUCTURES_PREFETCH(address) __builtin_prefetch((address), 0, 3)
+#else
+#define STRUCTURES_PREFETCH(address) ((void) (address))
+#endif
+
+#endif
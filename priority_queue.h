@@ -0,0 +1,287 @@
+// Copyright 2017 Letícia do Nascimento
+
+#ifndef STRUCTURES_PRIORITY_QUEUE_H
+#define STRUCTURES_PRIORITY_QUEUE_H
+
+#include <cstdint>
+#include <functional>  // std::less
+#include <iterator>  // std::distance
+#include <stdexcept>  // C++ exception
+
+#include "./array_list.cpp"
+
+namespace structures {
+
+/**
+ * @brief      Implementação de uma Fila de Prioridade como heap d-ário sobre
+ *             o vetor de uma ArrayList. O topo é o elemento que vem primeiro
+ *             segundo Compare (o menor, com std::less). Inserir e retirar
+ *             custam O(log_d n) sem deslocar o vetor; aridades maiores deixam
+ *             a árvore mais rasa e os filhos de um nodo na mesma linha de cache.
+ *
+ * @tparam     T        Parâmetro genérico de Template
+ * @tparam     Arity    Quantidade de filhos por nodo (d)
+ * @tparam     Compare  Ordem de prioridade
+ * @tparam     Stats    Política de estatísticas, repassada à ArrayList do heap
+ */
+template<typename T, std::size_t Arity = 4, typename Compare = std::less<T>,
+         typename Stats = NoStats>
+class PriorityQueue {
+ public:
+    PriorityQueue();
+    explicit PriorityQueue(std::size_t max_size);
+
+    void clear();  // limpa
+
+    void push(const T& data);  // insere
+    T pop();  // retira o topo
+    const T& top() const;  // elemento de maior prioridade
+
+    template<typename ForwardIt>
+    void heapify(ForwardIt first, ForwardIt last);  // substitui tudo, em O(n)
+
+    bool empty() const;  // fila vazia
+    bool full() const;  // fila cheia
+    std::size_t size() const;  // tamanho
+    std::size_t max_size() const;  // tamanho máximo
+
+    StatsSnapshot stats() const;  // contadores de estatísticas
+    void reset_stats();  // zera os contadores
+    std::size_t bytes_allocated() const;  // bytes no heap
+    std::size_t capacity() const;  // dados que cabem sem alocar
+    MemoryUsage memory_usage() const;  // detalhamento da memória
+    // repassa alocações a um observador (só com ObservedStats)
+    void observe(AllocationObserver* observer, const char* site);
+
+ private:
+    static_assert(Arity >= 2, "Heap precisa de pelo menos 2 filhos por nodo.");
+
+    void sift_up(std::size_t index);  // sobe o elemento até sua posição
+    void sift_down(std::size_t index);  // desce o elemento até sua posição
+
+    ArrayList<T, 0, Stats> heap_;
+    Compare compare_;
+};
+
+/**
+ *   Construtor padrão da classe PriorityQueue.
+ */
+template<typename T, std::size_t Arity, typename Compare, typename Stats>
+PriorityQueue<T, Arity, Compare, Stats>::PriorityQueue() :
+    heap_()
+{}
+
+/**
+ *   Construtor da classe PriorityQueue com tamanho máximo.
+ */
+template<typename T, std::size_t Arity, typename Compare, typename Stats>
+PriorityQueue<T, Arity, Compare, Stats>::PriorityQueue(std::size_t max_size) :
+    heap_(max_size)
+{}
+
+/**
+ *   Faz uma limpeza da fila de prioridade (PriorityQueue).
+ */
+template<typename T, std::size_t Arity, typename Compare, typename Stats>
+void PriorityQueue<T, Arity, Compare, Stats>::clear() {
+    heap_.clear();
+}
+
+/**
+ *   Sobe o elemento de index enquanto ele tem prioridade sobre o pai
+ * (PriorityQueue). Desloca os pais para baixo e grava o elemento uma vez.
+ */
+template<typename T, std::size_t Arity, typename Compare, typename Stats>
+void PriorityQueue<T, Arity, Compare, Stats>::sift_up(std::size_t index) {
+    T* contents = heap_.data();
+    T data = contents[index];
+    while (index > 0) {
+        std::size_t parent = (index - 1) / Arity;
+        if (!compare_(data, contents[parent]))
+            break;
+        contents[index] = contents[parent];
+        index = parent;
+    }
+    contents[index] = data;
+}
+
+/**
+ *   Desce o elemento de index enquanto algum filho tem prioridade sobre ele
+ * (PriorityQueue).
+ */
+template<typename T, std::size_t Arity, typename Compare, typename Stats>
+void PriorityQueue<T, Arity, Compare, Stats>::sift_down(std::size_t index) {
+    T* contents = heap_.data();
+    std::size_t size = heap_.size();
+    T data = contents[index];
+    while (true) {
+        std::size_t first = index * Arity + 1;
+        if (first >= size)
+            break;
+        std::size_t last = first + Arity < size ? first + Arity : size;
+        std::size_t best = first;
+        for (std::size_t child = first + 1; child < last; child++) {
+            if (compare_(contents[child], contents[best]))
+                best = child;
+        }
+        if (!compare_(contents[best], data))
+            break;
+        contents[index] = contents[best];
+        index = best;
+    }
+    contents[index] = data;
+}
+
+/**
+ *   Insere um elemento na fila de prioridade (PriorityQueue).
+ */
+template<typename T, std::size_t Arity, typename Compare, typename Stats>
+void PriorityQueue<T, Arity, Compare, Stats>::push(const T& data) {
+    if (full())
+        throw std::out_of_range("Fila de prioridade cheia.");
+    heap_.push_back(data);
+    sift_up(heap_.size() - 1);
+}
+
+/**
+ *   Retira e retorna o elemento de maior prioridade (PriorityQueue).
+ */
+template<typename T, std::size_t Arity, typename Compare, typename Stats>
+T PriorityQueue<T, Arity, Compare, Stats>::pop() {
+    if (empty())
+        throw std::out_of_range("Fila de prioridade vazia.");
+
+    T* contents = heap_.data();
+    T top = contents[0];
+    T last = heap_.pop_back();
+    if (!heap_.empty()) {
+        contents[0] = last;
+        sift_down(0);
+    }
+    return top;
+}
+
+/**
+ *   Retorna o elemento de maior prioridade (PriorityQueue).
+ */
+template<typename T, std::size_t Arity, typename Compare, typename Stats>
+const T& PriorityQueue<T, Arity, Compare, Stats>::top() const {
+    if (empty())
+        throw std::out_of_range("Fila de prioridade vazia.");
+    return heap_.data()[0];
+}
+
+/**
+ *   Substitui o conteúdo da fila pelos elementos de [first, last),
+ * construindo o heap de baixo para cima em O(n) (PriorityQueue). Se os
+ * elementos não cabem, lança sem alterar a fila.
+ */
+template<typename T, std::size_t Arity, typename Compare, typename Stats>
+template<typename ForwardIt>
+void PriorityQueue<T, Arity, Compare, Stats>::heapify(ForwardIt first,
+                                                      ForwardIt last) {
+    // confere o tamanho antes de mexer no heap, que fica intacto se lançar
+    if (static_cast<std::size_t>(std::distance(first, last)) > max_size())
+        throw std::out_of_range("Fila de prioridade cheia.");
+
+    heap_.clear();
+    try {
+        for (; first != last; ++first)
+            heap_.push_back(*first);
+    } catch (...) {
+        heap_.clear();  // um heap pela metade não estaria ordenado
+        throw;
+    }
+
+    std::size_t size = heap_.size();
+    if (size < 2)
+        return;
+    for (std::size_t i = (size - 2) / Arity + 1; i > 0; i--)
+        sift_down(i - 1);
+}
+
+/**
+ *   Verifica se a fila de prioridade (PriorityQueue) está vazia.
+ */
+template<typename T, std::size_t Arity, typename Compare, typename Stats>
+bool PriorityQueue<T, Arity, Compare, Stats>::empty() const {
+    return heap_.empty();
+}
+
+/**
+ *   Verifica se a fila de prioridade (PriorityQueue) está cheia.
+ */
+template<typename T, std::size_t Arity, typename Compare, typename Stats>
+bool PriorityQueue<T, Arity, Compare, Stats>::full() const {
+    return heap_.full();
+}
+
+/**
+ *   Retorna o tamanho da fila de prioridade (PriorityQueue).
+ */
+template<typename T, std::size_t Arity, typename Compare, typename Stats>
+std::size_t PriorityQueue<T, Arity, Compare, Stats>::size() const {
+    return heap_.size();
+}
+
+/**
+ *   Retorna o tamanho máximo da fila de prioridade (PriorityQueue).
+ */
+template<typename T, std::size_t Arity, typename Compare, typename Stats>
+std::size_t PriorityQueue<T, Arity, Compare, Stats>::max_size() const {
+    return heap_.max_size();
+}
+
+/**
+ *   Retorna os contadores da política de estatísticas (PriorityQueue).
+ */
+template<typename T, std::size_t Arity, typename Compare, typename Stats>
+StatsSnapshot PriorityQueue<T, Arity, Compare, Stats>::stats() const {
+    return heap_.stats();
+}
+
+/**
+ *   Zera os contadores da política de estatísticas (PriorityQueue).
+ */
+template<typename T, std::size_t Arity, typename Compare, typename Stats>
+void PriorityQueue<T, Arity, Compare, Stats>::reset_stats() {
+    heap_.reset_stats();
+}
+
+/**
+ *   Retorna os bytes que o vetor do heap ocupa (PriorityQueue).
+ */
+template<typename T, std::size_t Arity, typename Compare, typename Stats>
+std::size_t PriorityQueue<T, Arity, Compare, Stats>::bytes_allocated() const {
+    return heap_.bytes_allocated();
+}
+
+/**
+ *   Retorna quantos dados cabem sem alocar (PriorityQueue).
+ */
+template<typename T, std::size_t Arity, typename Compare, typename Stats>
+std::size_t PriorityQueue<T, Arity, Compare, Stats>::capacity() const {
+    return heap_.capacity();
+}
+
+/**
+ *   Retorna o detalhamento da memória ocupada (PriorityQueue).
+ */
+template<typename T, std::size_t Arity, typename Compare, typename Stats>
+MemoryUsage PriorityQueue<T, Arity, Compare, Stats>::memory_usage() const {
+    return heap_.memory_usage();
+}
+
+/**
+ *   Repassa as alocações ao observador com o rótulo site (PriorityQueue);
+ * exige a política ObservedStats.
+ */
+template<typename T, std::size_t Arity, typename Compare, typename Stats>
+void PriorityQueue<T, Arity, Compare, Stats>::observe(
+        AllocationObserver* observer, const char* site) {
+    heap_.observe(observer, site);
+}
+
+}  // namespace structures
+
+#endif
@@ -0,0 +1,533 @@
+// Copyright 2017 Letícia do Nascimento
+
+#ifndef STRUCTURES_SOA_ARRAY_LIST_H
+#define STRUCTURES_SOA_ARRAY_LIST_H
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>  // C++ exception
+#include <tuple>
+#include <utility>  // std::index_sequence
+
+#include "./memory_usage.h"
+
+namespace structures {
+
+/**
+ * @brief      Descreve um membro de Record guardado numa coluna da
+ *             SoAArrayList.
+ *
+ * @tparam     Record  Tipo do registro
+ * @tparam     T       Tipo do membro
+ * @tparam     Member  Ponteiro para o membro
+ */
+template<typename Record, typename T, T Record::*Member>
+struct SoAField {
+    using type = T;
+
+    static T& get(Record& record) {
+        return record.*Member;
+    }
+
+    static const T& get(const Record& record) {
+        return record.*Member;
+    }
+};
+
+/**
+ * @brief      Lista de registros guardada como estrutura de vetores: cada
+ *             membro descrito em Fields fica em seu próprio vetor contíguo.
+ *             Buscas por um só campo (find<I>, count_if<I>, filter<I>) leem
+ *             apenas aquela coluna, sem trazer os outros campos para a cache,
+ *             em laços simples que o compilador consegue vetorizar. at()
+ *             retorna um proxy que acessa as colunas na posição. Exige
+ *             C++14 (std::index_sequence).
+ *
+ * @tparam     Record  Tipo do registro (construtível por padrão)
+ * @tparam     Fields  Um SoAField por coluna
+ */
+template<typename Record, typename... Fields>
+class SoAArrayList {
+ public:
+    template<std::size_t I>
+    using column_type = typename std::tuple_element<
+        I, std::tuple<typename Fields::type...>>::type;
+
+    /**
+     * @brief      Referência a um registro da lista: get<I>() acessa uma
+     *             coluna; conversão para Record e atribuição de Record leem e
+     *             gravam todas as colunas.
+     */
+    class Reference {
+     public:
+        template<std::size_t I>
+        column_type<I>& get() const {
+            return list_->template column<I>()[index_];
+        }
+
+        operator Record() const {
+            return list_->load(index_);
+        }
+
+        Reference& operator=(const Record& record) {
+            list_->store(index_, record);
+            return *this;
+        }
+
+     private:
+        friend class SoAArrayList;
+
+        Reference(SoAArrayList* list, std::size_t index) :
+            list_{list},
+            index_{index}
+        {}
+
+        SoAArrayList* list_;
+        std::size_t index_;
+    };
+
+    SoAArrayList();
+    explicit SoAArrayList(std::size_t max_size);
+    ~SoAArrayList();
+
+    SoAArrayList(const SoAArrayList&) = delete;
+    SoAArrayList& operator=(const SoAArrayList&) = delete;
+
+    void clear();  // limpa
+    void push_back(const Record& data);  // insere no fim
+    void push_front(const Record& data);  // insere no início
+    void insert(const Record& data, std::size_t index);  // insere na posição
+    Record pop(std::size_t index);  // retira da posição
+    Record pop_back();  // retira do fim
+    Record pop_front();  // retira do início
+
+    bool full() const;  // lista cheia
+    bool empty() const;  // lista vazia
+    std::size_t size() const;  // tamanho
+    std::size_t max_size() const;  // tamanho máximo
+
+    Reference at(std::size_t index);  // registro na posição
+    Record at(std::size_t index) const;
+    Reference operator[](std::size_t index);
+    Record operator[](std::size_t index) const;
+
+    template<std::size_t I>
+    column_type<I>* column();  // vetor de uma coluna
+
+    template<std::size_t I>
+    const column_type<I>* column() const;
+
+    template<std::size_t I>
+    std::size_t find(const column_type<I>& value) const;  // posição por campo
+
+    template<std::size_t I, typename Predicate>
+    std::size_t find_if(Predicate pred) const;  // posição por predicado
+
+    template<std::size_t I, typename Predicate>
+    std::size_t count_if(Predicate pred) const;  // quantos satisfazem
+
+    template<std::size_t I, typename Predicate, typename OutputIt>
+    OutputIt filter(Predicate pred, OutputIt out) const;  // posições que satisfazem
+
+    std::size_t bytes_allocated() const;  // bytes no heap
+    std::size_t capacity() const;  // dados que cabem sem alocar
+    MemoryUsage memory_usage() const;  // detalhamento da memória
+
+ private:
+    using Indexes = std::index_sequence_for<Fields...>;
+    using Expand = int[];
+
+    template<std::size_t... I>
+    void allocate(std::index_sequence<I...>);
+
+    template<std::size_t... I>
+    void release(std::index_sequence<I...>);
+
+    template<std::size_t... I>
+    void store(std::size_t index, const Record& data,
+               std::index_sequence<I...>);
+
+    template<std::size_t... I>
+    Record load(std::size_t index, std::index_sequence<I...>) const;
+
+    template<std::size_t... I>
+    void shift_right(std::size_t index, std::index_sequence<I...>);
+
+    template<std::size_t... I>
+    void shift_left(std::size_t index, std::index_sequence<I...>);
+
+    void store(std::size_t index, const Record& data) {
+        store(index, data, Indexes());
+    }
+
+    Record load(std::size_t index) const {
+        return load(index, Indexes());
+    }
+
+    // bytes de um registro somando as colunas
+    static std::size_t row_bytes() {
+        std::size_t bytes = 0;
+        (void) Expand{0, (bytes += sizeof(typename Fields::type), 0)...};
+        return bytes;
+    }
+
+    std::tuple<typename Fields::type*...> columns_;
+    std::size_t size_;
+    std::size_t max_size_;
+
+    static const std::size_t DEFAULT_MAX = 10;
+    static const std::size_t BLOCK = 16;  // elementos comparados por vez em find
+};
+
+/**
+ *   Construtor padrão da classe SoAArrayList.
+ */
+template<typename Record, typename... Fields>
+SoAArrayList<Record, Fields...>::SoAArrayList() :
+    SoAArrayList(DEFAULT_MAX)
+{}
+
+/**
+ *   Construtor da classe SoAArrayList com tamanho máximo; aloca uma coluna
+ * de max_size elementos para cada campo.
+ */
+template<typename Record, typename... Fields>
+SoAArrayList<Record, Fields...>::SoAArrayList(std::size_t max_size) :
+    columns_{},
+    size_{0},
+    max_size_{max_size}
+{
+    allocate(Indexes());
+}
+
+/**
+ *   Destrutor da classe SoAArrayList.
+ */
+template<typename Record, typename... Fields>
+SoAArrayList<Record, Fields...>::~SoAArrayList() {
+    release(Indexes());
+}
+
+template<typename Record, typename... Fields>
+template<std::size_t... I>
+void SoAArrayList<Record, Fields...>::allocate(std::index_sequence<I...>) {
+    try {
+        (void) Expand{0, (std::get<I>(columns_) =
+                          new column_type<I>[max_size_], 0)...};
+    } catch (...) {
+        release(Indexes());
+        throw;
+    }
+}
+
+template<typename Record, typename... Fields>
+template<std::size_t... I>
+void SoAArrayList<Record, Fields...>::release(std::index_sequence<I...>) {
+    (void) Expand{0, (delete [] std::get<I>(columns_), 0)...};
+}
+
+template<typename Record, typename... Fields>
+template<std::size_t... I>
+void SoAArrayList<Record, Fields...>::store(std::size_t index,
+                                           const Record& data,
+                                           std::index_sequence<I...>) {
+    (void) Expand{0, (std::get<I>(columns_)[index] = Fields::get(data), 0)...};
+}
+
+template<typename Record, typename... Fields>
+template<std::size_t... I>
+Record SoAArrayList<Record, Fields...>::load(std::size_t index,
+                                            std::index_sequence<I...>) const {
+    Record data;
+    (void) Expand{0, (Fields::get(data) = std::get<I>(columns_)[index], 0)...};
+    return data;
+}
+
+template<typename Record, typename... Fields>
+template<std::size_t... I>
+void SoAArrayList<Record, Fields...>::shift_right(std::size_t index,
+                                                 std::index_sequence<I...>) {
+    (void) Expand{0, (std::copy_backward(std::get<I>(columns_) + index,
+                                         std::get<I>(columns_) + size_,
+                                         std::get<I>(columns_) + size_ + 1),
+                      0)...};
+}
+
+template<typename Record, typename... Fields>
+template<std::size_t... I>
+void SoAArrayList<Record, Fields...>::shift_left(std::size_t index,
+                                                std::index_sequence<I...>) {
+    (void) Expand{0, (std::copy(std::get<I>(columns_) + index + 1,
+                                std::get<I>(columns_) + size_,
+                                std::get<I>(columns_) + index),
+                      0)...};
+}
+
+/**
+ *   Faz uma limpeza da lista (SoAArrayList).
+ */
+template<typename Record, typename... Fields>
+void SoAArrayList<Record, Fields...>::clear() {
+    size_ = 0;
+}
+
+/**
+ *   Insere data no fim da lista (SoAArrayList).
+ */
+template<typename Record, typename... Fields>
+void SoAArrayList<Record, Fields...>::push_back(const Record& data) {
+    insert(data, size_);
+}
+
+/**
+ *   Insere data no início da lista (SoAArrayList).
+ */
+template<typename Record, typename... Fields>
+void SoAArrayList<Record, Fields...>::push_front(const Record& data) {
+    insert(data, 0);
+}
+
+/**
+ *   Insere data na posição index, deslocando os seguintes em todas as
+ * colunas (SoAArrayList).
+ */
+template<typename Record, typename... Fields>
+void SoAArrayList<Record, Fields...>::insert(const Record& data,
+                                            std::size_t index) {
+    if (full())
+        throw std::out_of_range("Lista atualmente cheia.");
+    if (index > size_)
+        throw std::out_of_range("Erro! Posição inexistente.");
+
+    shift_right(index, Indexes());
+    store(index, data);
+    size_++;
+}
+
+/**
+ *   Retira e retorna o registro da posição index (SoAArrayList).
+ */
+template<typename Record, typename... Fields>
+Record SoAArrayList<Record, Fields...>::pop(std::size_t index) {
+    if (empty())
+        throw std::out_of_range("Lista atualmente vazia.");
+    if (index >= size_)
+        throw std::out_of_range("Erro! Posição inexistente.");
+
+    Record data = load(index);
+    shift_left(index, Indexes());
+    size_--;
+    return data;
+}
+
+/**
+ *   Retira e retorna o fim da lista (SoAArrayList).
+ */
+template<typename Record, typename... Fields>
+Record SoAArrayList<Record, Fields...>::pop_back() {
+    if (empty())
+        throw std::out_of_range("Lista atualmente vazia.");
+    return pop(size_ - 1);
+}
+
+/**
+ *   Retira e retorna o início da lista (SoAArrayList).
+ */
+template<typename Record, typename... Fields>
+Record SoAArrayList<Record, Fields...>::pop_front() {
+    return pop(0);
+}
+
+/**
+ *   Verifica se a lista (SoAArrayList) está cheia.
+ */
+template<typename Record, typename... Fields>
+bool SoAArrayList<Record, Fields...>::full() const {
+    return size_ == max_size_;
+}
+
+/**
+ *   Verifica se a lista (SoAArrayList) está vazia.
+ */
+template<typename Record, typename... Fields>
+bool SoAArrayList<Record, Fields...>::empty() const {
+    return size_ == 0;
+}
+
+/**
+ *   Retorna o tamanho da lista (SoAArrayList).
+ */
+template<typename Record, typename... Fields>
+std::size_t SoAArrayList<Record, Fields...>::size() const {
+    return size_;
+}
+
+/**
+ *   Retorna o tamanho máximo da lista (SoAArrayList).
+ */
+template<typename Record, typename... Fields>
+std::size_t SoAArrayList<Record, Fields...>::max_size() const {
+    return max_size_;
+}
+
+/**
+ *   Retorna uma referência ao registro da posição index (SoAArrayList).
+ */
+template<typename Record, typename... Fields>
+typename SoAArrayList<Record, Fields...>::Reference
+SoAArrayList<Record, Fields...>::at(std::size_t index) {
+    if (index >= size_)
+        throw std::out_of_range("Erro! Posição inexistente.");
+    return Reference(this, index);
+}
+
+/**
+ *   Retorna uma cópia do registro da posição index (SoAArrayList).
+ */
+template<typename Record, typename... Fields>
+Record SoAArrayList<Record, Fields...>::at(std::size_t index) const {
+    if (index >= size_)
+        throw std::out_of_range("Erro! Posição inexistente.");
+    return load(index);
+}
+
+/**
+ *   Retorna uma referência ao registro da posição index (SoAArrayList).
+ */
+template<typename Record, typename... Fields>
+typename SoAArrayList<Record, Fields...>::Reference
+SoAArrayList<Record, Fields...>::operator[](std::size_t index) {
+    return at(index);
+}
+
+/**
+ *   Retorna uma cópia do registro da posição index (SoAArrayList).
+ */
+template<typename Record, typename... Fields>
+Record SoAArrayList<Record, Fields...>::operator[](std::size_t index) const {
+    return at(index);
+}
+
+/**
+ *   Retorna o vetor da coluna I, com size() elementos (SoAArrayList).
+ */
+template<typename Record, typename... Fields>
+template<std::size_t I>
+typename SoAArrayList<Record, Fields...>::template column_type<I>*
+SoAArrayList<Record, Fields...>::column() {
+    return std::get<I>(columns_);
+}
+
+/**
+ *   Retorna o vetor da coluna I (SoAArrayList) - versão const.
+ */
+template<typename Record, typename... Fields>
+template<std::size_t I>
+const typename SoAArrayList<Record, Fields...>::template column_type<I>*
+SoAArrayList<Record, Fields...>::column() const {
+    return std::get<I>(columns_);
+}
+
+/**
+ *   Retorna a primeira posição cujo campo I é igual a value, ou size() se
+ * não encontrado (SoAArrayList). Compara blocos inteiros sem desvio e só
+ * procura a posição exata no bloco onde houve igualdade.
+ */
+template<typename Record, typename... Fields>
+template<std::size_t I>
+std::size_t SoAArrayList<Record, Fields...>::find(
+        const column_type<I>& value) const {
+    const column_type<I>* contents = column<I>();
+    std::size_t i = 0;
+    for (; i + BLOCK <= size_; i += BLOCK) {
+        bool found = false;
+        for (std::size_t j = 0; j < BLOCK; j++)
+            found |= contents[i + j] == value;
+        if (found)
+            break;
+    }
+    for (; i < size_; i++) {
+        if (contents[i] == value)
+            return i;
+    }
+    return size_;
+}
+
+/**
+ *   Retorna a primeira posição cujo campo I satisfaz pred, ou size()
+ * (SoAArrayList).
+ */
+template<typename Record, typename... Fields>
+template<std::size_t I, typename Predicate>
+std::size_t SoAArrayList<Record, Fields...>::find_if(Predicate pred) const {
+    const column_type<I>* contents = column<I>();
+    std::size_t i = 0;
+    while (i < size_ && !pred(contents[i]))
+        i++;
+    return i;
+}
+
+/**
+ *   Conta os registros cujo campo I satisfaz pred (SoAArrayList).
+ */
+template<typename Record, typename... Fields>
+template<std::size_t I, typename Predicate>
+std::size_t SoAArrayList<Record, Fields...>::count_if(Predicate pred) const {
+    const column_type<I>* contents = column<I>();
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < size_; i++)
+        count += pred(contents[i]) ? 1 : 0;
+    return count;
+}
+
+/**
+ *   Escreve em out as posições cujo campo I satisfaz pred, em ordem
+ * crescente (SoAArrayList).
+ */
+template<typename Record, typename... Fields>
+template<std::size_t I, typename Predicate, typename OutputIt>
+OutputIt SoAArrayList<Record, Fields...>::filter(Predicate pred,
+                                                 OutputIt out) const {
+    const column_type<I>* contents = column<I>();
+    for (std::size_t i = 0; i < size_; i++) {
+        if (pred(contents[i]))
+            *out++ = i;
+    }
+    return out;
+}
+
+/**
+ *   Retorna os bytes que as colunas ocupam no heap (SoAArrayList).
+ */
+template<typename Record, typename... Fields>
+std::size_t SoAArrayList<Record, Fields...>::bytes_allocated() const {
+    return max_size_ * row_bytes();
+}
+
+/**
+ *   Retorna quantos registros cabem nas colunas (SoAArrayList).
+ */
+template<typename Record, typename... Fields>
+std::size_t SoAArrayList<Record, Fields...>::capacity() const {
+    return max_size_;
+}
+
+/**
+ *   Retorna o detalhamento da memória ocupada (SoAArrayList); um registro
+ * conta como a soma dos seus campos, sem o preenchimento que teria num
+ * Record.
+ */
+template<typename Record, typename... Fields>
+MemoryUsage SoAArrayList<Record, Fields...>::memory_usage() const {
+    MemoryUsage usage;
+    usage.elements = size_;
+    usage.capacity = max_size_;
+    usage.element_bytes = size_ * row_bytes();
+    usage.unused_bytes = (max_size_ - size_) * row_bytes();
+    usage.bytes_allocated = bytes_allocated();
+    return usage;
+}
+
+}  // namespace structures
+
+#endif
@@ -0,0 +1,443 @@
+// Copyright 2017 Letícia do Nascimento
+
+#ifndef STRUCTURES_SPILLING_QUEUE_H
+#define STRUCTURES_SPILLING_QUEUE_H
+
+#include <fcntl.h>
+#include <stdlib.h>  // mkdtemp
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdint>
+#include <stdexcept>  // C++ exception
+#include <string>
+#include <system_error>
+#include <type_traits>
+
+#include "./array_snapshot.h"  // detail::write_all
+#include "./chunked_queue.h"
+#include "./linked_queue.h"
+#include "./memory_usage.h"
+#include "./operation_stats.h"
+
+namespace structures {
+
+namespace detail {
+
+//  lê length bytes, repetindo enquanto a leitura for parcial
+inline void read_all(int fd, void* buffer, std::size_t length) {
+    char* bytes = static_cast<char*>(buffer);
+    while (length > 0) {
+        ssize_t got = ::read(fd, bytes, length);
+        if (got < 0 && errno == EINTR)
+            continue;
+        if (got <= 0)
+            throw std::system_error(got < 0 ? errno : EIO,
+                                    std::generic_category(),
+                                    "Erro ao ler segmento");
+        bytes += got;
+        length -= got;
+    }
+}
+
+}  // namespace detail
+
+    /**
+     * @brief      Implementação de uma Fila (FIFO) com orçamento de memória.
+     *             O começo da fila fica numa ChunkedQueue e o fim num vetor de
+     *             tamanho segment_size; quando a fila passa do orçamento, o
+     *             meio é gravado em arquivos de segmento (somente anexação) e
+     *             lido de volta sequencialmente quando chega a vez dele.
+     *             Enfileirar e desenfileirar continuam O(1) amortizado.
+     *             O orçamento conta tudo o que fica na memória: o começo da
+     *             fila, o vetor do fim (segment_size + 1 dados) e, durante a
+     *             leitura de um segmento, o vetor de leitura (segment_size
+     *             dados). Os blocos da ChunkedQueue podem ter posições vagas
+     *             além dos dados contados.
+     *             Cada fila grava num subdiretório próprio, criado com
+     *             mkdtemp, então várias filas (ou restos de uma execução
+     *             interrompida) podem dividir o mesmo diretório.
+     *
+     * @tparam     T      Parâmetro genérico de Template (trivialmente copiável)
+     * @tparam     Stats  Política de estatísticas; conta só a memória, não
+     *                    os segmentos em disco
+     */
+
+template<typename T, typename Stats = NoStats>
+class SpillingQueue : private Stats {
+ public:
+    SpillingQueue(const std::string& directory, std::size_t memory_budget,
+                  std::size_t segment_size);
+
+    ~SpillingQueue();
+
+    SpillingQueue(const SpillingQueue&) = delete;
+    SpillingQueue& operator=(const SpillingQueue&) = delete;
+
+    void clear();  // limpar
+
+    void enqueue(const T& data);  // enfilerar
+
+    T dequeue();  // desenfilerar
+
+    T& front();  // primeiro dado
+
+    T& back();  // último dado
+
+    bool empty() const;  // fila vazia
+
+    std::size_t size() const;  // tamanho
+
+    std::size_t in_memory() const;  // elementos na memória
+
+    std::size_t spilled() const;  // elementos em disco
+
+    StatsSnapshot stats() const;  // contadores de estatísticas
+    void reset_stats();  // zera os contadores
+    std::size_t bytes_allocated() const;  // bytes no heap
+    std::size_t capacity() const;  // dados que cabem na memória sem alocar
+    MemoryUsage memory_usage() const;  // detalhamento da memória
+    // repassa alocações a um observador (só com ObservedStats)
+    void observe(AllocationObserver* observer, const char* site);
+
+ private:
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "SpillingQueue exige T trivialmente copiável.");
+
+    struct Segment {
+        std::uint64_t id;  // número do arquivo
+        std::size_t count;  // elementos gravados
+    };
+
+    std::string path(std::uint64_t id) const {
+        return directory_ + "/segment-" + std::to_string(id) + ".bin";
+    }
+
+    void spill();  // grava o fim da fila num segmento
+    void refill();  // traz o próximo trecho para o começo da fila
+
+    // enfileira no começo da fila, avisando a política quando a ChunkedQueue
+    // aloca um bloco (ela só libera blocos no destrutor)
+    void push_head(const T& data) {
+        std::size_t before = head_.bytes_allocated();
+        head_.enqueue(data);
+        if (head_.bytes_allocated() != before)
+            Stats::allocated(head_.bytes_allocated() - before);
+    }
+
+    // dados que o começo da fila pode ter: o resto do orçamento fica para
+    // o vetor do fim
+    std::size_t head_budget() const {
+        return memory_budget_ - segment_size_ - 1;
+    }
+
+    // bytes do vetor do fim
+    std::size_t tail_bytes() const {
+        return (segment_size_ + 1) * sizeof(T);
+    }
+
+    ChunkedQueue<T> head_;  // começo da fila, na memória
+    LinkedQueue<Segment> segments_;  // meio da fila, em disco
+    T* tail_;  // fim da fila, na memória
+    std::size_t tail_size_;
+    std::size_t spilled_;  // elementos em disco
+    std::uint64_t next_id_;
+    std::string directory_;
+    std::size_t memory_budget_;
+    std::size_t segment_size_;
+};
+
+/**
+ *   Construtor da classe SpillingQueue.
+ *   directory: diretório onde é criado o subdiretório dos segmentos
+ *   memory_budget: máximo de elementos na memória, somando o começo da
+ *                  fila, o vetor do fim e o vetor de leitura de um segmento
+ *   segment_size: elementos por arquivo de segmento; memory_budget precisa
+ *                 de pelo menos 3 * segment_size + 1, já que ao ler um
+ *                 segmento ele está no vetor de leitura e no começo da fila
+ *                 enquanto o vetor do fim continua alocado
+ */
+template<typename T, typename Stats>
+SpillingQueue<T, Stats>::SpillingQueue(const std::string& directory,
+                                       std::size_t memory_budget,
+                                       std::size_t segment_size) :
+    head_(segment_size > 0 ? segment_size : 1)
+{
+    if (segment_size == 0)
+        throw std::invalid_argument("Tamanho de segmento inválido.");
+    if (memory_budget == 0 || segment_size > (memory_budget - 1) / 3)
+        throw std::invalid_argument("Segmento grande demais para o orçamento.");
+
+    // uma posição extra mantém o último dado na memória após gravar
+    tail_ = new T[segment_size + 1];
+
+    std::string pattern = directory + "/spill-XXXXXX";
+    if (::mkdtemp(&pattern[0]) == nullptr) {
+        int error = errno;
+        delete [] tail_;
+        throw std::system_error(error, std::generic_category(),
+                                "Erro ao criar diretório de segmentos");
+    }
+    tail_size_ = 0;
+    spilled_ = 0;
+    next_id_ = 0;
+    directory_ = pattern;
+    memory_budget_ = memory_budget;
+    segment_size_ = segment_size;
+    Stats::allocated(tail_bytes());
+}
+
+/**
+ *   Destrutor da classe SpillingQueue: apaga os segmentos restantes e o
+ * subdiretório deles.
+ */
+template<typename T, typename Stats>
+SpillingQueue<T, Stats>::~SpillingQueue() {
+    clear();
+    ::rmdir(directory_.c_str());
+    Stats::released(head_.bytes_allocated());
+    Stats::released(tail_bytes());
+    delete [] tail_;
+}
+
+/**
+ *   Faz uma limpeza da fila (SpillingQueue), apagando os segmentos.
+ */
+template<typename T, typename Stats>
+void SpillingQueue<T, Stats>::clear() {
+    while (!segments_.empty())
+        ::unlink(path(segments_.dequeue().id).c_str());
+    head_.clear();
+    tail_size_ = 0;
+    spilled_ = 0;
+}
+
+/**
+ *   Verifica se a fila (SpillingQueue) está vazia.
+ */
+template<typename T, typename Stats>
+bool SpillingQueue<T, Stats>::empty() const {
+    return size() == 0;
+}
+
+/**
+ *   Retorna o tamanho total da fila (SpillingQueue).
+ */
+template<typename T, typename Stats>
+std::size_t SpillingQueue<T, Stats>::size() const {
+    return head_.size() + spilled_ + tail_size_;
+}
+
+/**
+ *   Retorna quantos elementos estão na memória (SpillingQueue).
+ */
+template<typename T, typename Stats>
+std::size_t SpillingQueue<T, Stats>::in_memory() const {
+    return head_.size() + tail_size_;
+}
+
+/**
+ *   Retorna quantos elementos estão em disco (SpillingQueue).
+ */
+template<typename T, typename Stats>
+std::size_t SpillingQueue<T, Stats>::spilled() const {
+    return spilled_;
+}
+
+/**
+ * Inserir novo elemento na fila (SpillingQueue).
+ */
+template<typename T, typename Stats>
+void SpillingQueue<T, Stats>::enqueue(const T& data) {
+    if (segments_.empty() && tail_size_ == 0 &&
+        head_.size() < head_budget()) {
+        Stats::operation();
+        push_head(data);
+        Stats::resized(size());
+        return;
+    }
+
+    Stats::operation();
+    tail_[tail_size_] = data;
+    tail_size_++;
+    if (tail_size_ > segment_size_)
+        spill();
+    Stats::resized(size());
+}
+
+/**
+ *   Esvazia o vetor do fim (SpillingQueue): para o começo da fila, se ainda
+ * cabe no orçamento e nada foi gravado, ou para um novo segmento em disco.
+ * O último dado fica no vetor, para que back() não precise ler o disco.
+ */
+template<typename T, typename Stats>
+void SpillingQueue<T, Stats>::spill() {
+    if (segments_.empty() &&
+        head_.size() + segment_size_ <= head_budget()) {
+        for (std::size_t i = 0; i < segment_size_; i++)
+            push_head(tail_[i]);
+    } else {
+        Segment segment{next_id_, segment_size_};
+        int fd = ::open(path(segment.id).c_str(),
+                        O_WRONLY | O_CREAT | O_EXCL | O_APPEND, 0600);
+        if (fd < 0) {
+            tail_size_--;
+            throw std::system_error(errno, std::generic_category(),
+                                    "Erro ao criar segmento");
+        }
+        try {
+            detail::write_all(fd, tail_, segment_size_ * sizeof(T));
+        } catch (...) {
+            ::close(fd);
+            ::unlink(path(segment.id).c_str());
+            tail_size_--;
+            throw;
+        }
+        ::close(fd);
+        segments_.enqueue(segment);
+        next_id_++;
+        spilled_ += segment_size_;
+    }
+    tail_[0] = tail_[segment_size_];
+    tail_size_ = 1;
+}
+
+/**
+ *   Traz o próximo trecho da fila para o começo (SpillingQueue): o segmento
+ * mais antigo, lido sequencialmente, ou o vetor do fim.
+ */
+template<typename T, typename Stats>
+void SpillingQueue<T, Stats>::refill() {
+    if (segments_.empty()) {
+        for (std::size_t i = 0; i < tail_size_; i++)
+            push_head(tail_[i]);
+        tail_size_ = 0;
+        return;
+    }
+
+    Segment segment = segments_.front();
+    std::string file = path(segment.id);
+    int fd = ::open(file.c_str(), O_RDONLY);
+    if (fd < 0)
+        throw std::system_error(errno, std::generic_category(),
+                                "Erro ao abrir segmento");
+
+    T* buffer = new T[segment.count];
+    Stats::allocated(segment.count * sizeof(T));
+    try {
+        detail::read_all(fd, buffer, segment.count * sizeof(T));
+        for (std::size_t i = 0; i < segment.count; i++)
+            push_head(buffer[i]);
+    } catch (...) {
+        ::close(fd);
+        Stats::released(segment.count * sizeof(T));
+        delete [] buffer;
+        throw;
+    }
+    ::close(fd);
+    Stats::released(segment.count * sizeof(T));
+    delete [] buffer;
+
+    segments_.dequeue();
+    spilled_ -= segment.count;
+    ::unlink(file.c_str());
+}
+
+/**
+ *   Remove um elemento da fila (SpillingQueue).
+ */
+template<typename T, typename Stats>
+T SpillingQueue<T, Stats>::dequeue() {
+    if (empty())
+        throw std::out_of_range("Fila vazia!");
+    if (head_.empty())
+        refill();
+    Stats::operation();
+    return head_.dequeue();
+}
+
+/**
+ *   Retorna o primeiro elemento da fila (SpillingQueue).
+ */
+template<typename T, typename Stats>
+T& SpillingQueue<T, Stats>::front() {
+    if (empty())
+        throw std::out_of_range("Fila vazia.");
+    if (head_.empty())
+        refill();
+    return head_.front();
+}
+
+/**
+ *   Retorna o último elemento da fila (SpillingQueue).
+ */
+template<typename T, typename Stats>
+T& SpillingQueue<T, Stats>::back() {
+    if (empty())
+        throw std::out_of_range("Fila vazia.");
+    if (tail_size_ > 0)
+        return tail_[tail_size_ - 1];
+    return head_.back();
+}
+
+/**
+ *   Retorna os contadores da política de estatísticas (SpillingQueue).
+ */
+template<typename T, typename Stats>
+StatsSnapshot SpillingQueue<T, Stats>::stats() const {
+    return Stats::snapshot();
+}
+
+/**
+ *   Zera os contadores da política de estatísticas (SpillingQueue).
+ */
+template<typename T, typename Stats>
+void SpillingQueue<T, Stats>::reset_stats() {
+    Stats::reset();
+}
+
+/**
+ *   Retorna os bytes que a fila ocupa no heap: os blocos do começo e o
+ * vetor do fim (SpillingQueue). Os segmentos em disco não contam.
+ */
+template<typename T, typename Stats>
+std::size_t SpillingQueue<T, Stats>::bytes_allocated() const {
+    return head_.bytes_allocated() + tail_bytes();
+}
+
+/**
+ *   Retorna quantos dados cabem na memória sem alocar (SpillingQueue).
+ */
+template<typename T, typename Stats>
+std::size_t SpillingQueue<T, Stats>::capacity() const {
+    return head_.capacity() + segment_size_ + 1;
+}
+
+/**
+ *   Retorna o detalhamento da memória ocupada (SpillingQueue); o vetor do
+ * fim soma-se aos blocos do começo e os dados em disco ficam de fora.
+ */
+template<typename T, typename Stats>
+MemoryUsage SpillingQueue<T, Stats>::memory_usage() const {
+    MemoryUsage usage = head_.memory_usage();
+    usage.elements += tail_size_;
+    usage.capacity += segment_size_ + 1;
+    usage.element_bytes += tail_size_ * sizeof(T);
+    usage.unused_bytes += tail_bytes() - tail_size_ * sizeof(T);
+    usage.bytes_allocated += tail_bytes();
+    return usage;
+}
+
+/**
+ *   Repassa as alocações ao observador com o rótulo site (SpillingQueue);
+ * exige a política ObservedStats.
+ */
+template<typename T, typename Stats>
+void SpillingQueue<T, Stats>::observe(AllocationObserver* observer,
+                                      const char* site) {
+    Stats::observe(observer, site);
+}
+
+}  // namespace structures
+
+#endif
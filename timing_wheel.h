@@ -0,0 +1,291 @@
+// Copyright 2017 Letícia do Nascimento
+
+#ifndef STRUCTURES_TIMING_WHEEL_H
+#define STRUCTURES_TIMING_WHEEL_H
+
+#include <cstdint>
+
+#include "./intrusive_hook.h"
+
+namespace structures {
+
+/**
+ * @brief      Gancho de um temporizador da TimingWheel. O tipo do usuário
+ *             herda de TimerHook; agendar não aloca nem copia.
+ */
+class TimerHook : public RingHook {
+ public:
+    bool scheduled() const { return linked(); }  // está agendado?
+    std::uint64_t expiry() const { return expiry_; }  // tick de disparo
+
+ private:
+    template<typename T, unsigned SlotBits, unsigned Levels>
+    friend class TimingWheel;
+
+    std::uint64_t expiry_{0u};
+};
+
+/**
+ * @brief      Roda de tempo hierárquica (hashed hierarchical timing wheel)
+ *             para muitos temporizadores, como os timeouts de conexões.
+ *             Cada nível tem 2^SlotBits posições, e cada posição é um anel
+ *             intrusivo com sentinela (RingHook): agendar e cancelar são
+ *             O(1), sem percorrer nada, em vez do O(n) de manter uma lista
+ *             ordenada com insert_sorted. O nível l guarda os temporizadores
+ *             que faltam até 2^(SlotBits*(l+1)) ticks para disparar; quando o
+ *             relógio chega a uma posição de um nível alto, os temporizadores
+ *             dela descem para os níveis de baixo (cada um desce no máximo
+ *             Levels-1 vezes), então avançar um tick é O(1) amortizado.
+ *
+ *             Prazos além de 2^(SlotBits*Levels) ticks ficam na última
+ *             posição alcançável e são reposicionados ao chegar nela. A roda
+ *             não é segura para várias threads, e um temporizador agendado
+ *             não pode ser destruído antes de disparar ou ser cancelado.
+ *
+ * @tparam     T         Tipo dos temporizadores (herda de TimerHook)
+ * @tparam     SlotBits  Bits do índice de posição de cada nível
+ * @tparam     Levels    Número de níveis
+ */
+template<typename T, unsigned SlotBits = 8, unsigned Levels = 4>
+class TimingWheel {
+ public:
+    explicit TimingWheel(std::uint64_t now = 0);
+    ~TimingWheel();
+
+    TimingWheel(const TimingWheel&) = delete;
+    TimingWheel& operator=(const TimingWheel&) = delete;
+
+    void schedule(T& timer, std::uint64_t delay);  // dispara em delay ticks
+    bool cancel(T& timer);  // desagenda, em O(1)
+    void clear();  // desagenda todos
+
+    template<typename Function>
+    std::size_t advance(std::uint64_t ticks, Function function);  // avança
+
+    std::uint64_t now() const;  // tick atual
+    bool empty() const;  // nenhum temporizador agendado
+    std::size_t size() const;  // temporizadores agendados
+
+ private:
+    static_assert(SlotBits >= 1 && Levels >= 1 && SlotBits * Levels < 64,
+                  "Roda de tempo com tamanho inválido.");
+
+    static const std::uint64_t SLOTS = std::uint64_t(1) << SlotBits;
+    static const std::uint64_t MASK = SLOTS - 1;
+    static const std::uint64_t RANGE = std::uint64_t(1) << (SlotBits * Levels);
+
+    static T& timer_of(RingHook* hook) {
+        return static_cast<T&>(static_cast<TimerHook&>(*hook));
+    }
+
+    void place(TimerHook& timer);  // liga na posição certa para expiry_
+    void cascade(unsigned level);  // desce a posição atual de um nível
+
+    template<typename Function>
+    std::size_t expire(Function& function);  // dispara a posição atual
+
+    RingHook slots_[Levels][SLOTS];
+    std::uint64_t now_;
+    std::size_t size_{0u};
+};
+
+/**
+ *   Construtor da classe TimingWheel: now é o tick inicial.
+ */
+template<typename T, unsigned SlotBits, unsigned Levels>
+TimingWheel<T, SlotBits, Levels>::TimingWheel(std::uint64_t now) :
+    now_(now)
+{
+    for (unsigned level = 0; level < Levels; level++)
+        for (std::uint64_t slot = 0; slot < SLOTS; slot++)
+            slots_[level][slot].make_sentinel();
+}
+
+/**
+ *   Destrutor da classe TimingWheel. Desagenda os temporizadores, que
+ * continuam pertencendo ao usuário.
+ */
+template<typename T, unsigned SlotBits, unsigned Levels>
+TimingWheel<T, SlotBits, Levels>::~TimingWheel() {
+    clear();
+}
+
+/**
+ *   Agenda timer para disparar daqui a delay ticks (TimingWheel); delay 0
+ * conta como 1, o próximo tick. Um timer já agendado é reagendado.
+ */
+template<typename T, unsigned SlotBits, unsigned Levels>
+void TimingWheel<T, SlotBits, Levels>::schedule(T& timer,
+                                                std::uint64_t delay) {
+    TimerHook& hook = timer;
+    if (hook.scheduled())
+        cancel(timer);
+    hook.expiry_ = now_ + (delay > 0 ? delay : 1);
+    place(hook);
+    size_++;
+}
+
+/**
+ *   Desagenda timer (TimingWheel); retorna false se ele não estava
+ * agendado. O timer deve ter sido agendado nesta roda.
+ */
+template<typename T, unsigned SlotBits, unsigned Levels>
+bool TimingWheel<T, SlotBits, Levels>::cancel(T& timer) {
+    TimerHook& hook = timer;
+    if (!hook.scheduled())
+        return false;
+    hook.unlink();
+    size_--;
+    return true;
+}
+
+/**
+ *   Desagenda todos os temporizadores (TimingWheel).
+ */
+template<typename T, unsigned SlotBits, unsigned Levels>
+void TimingWheel<T, SlotBits, Levels>::clear() {
+    for (unsigned level = 0; level < Levels && size_ > 0; level++) {
+        for (std::uint64_t slot = 0; slot < SLOTS; slot++) {
+            RingHook& ring = slots_[level][slot];
+            while (!ring.alone()) {
+                ring.next()->unlink();
+                size_--;
+            }
+        }
+    }
+}
+
+/**
+ *   Avança o relógio ticks vezes, chamando function(timer) para cada
+ * temporizador que vence, na ordem dos ticks e, no mesmo tick, na ordem em
+ * que foram agendados (TimingWheel). O timer já está desagendado quando
+ * function é chamada, que pode reagendá-lo ou agendar e cancelar outros.
+ * Se function lança, o relógio para no tick atual e os temporizadores que
+ * ainda não dispararam nele continuam agendados: disparam primeiro na
+ * próxima chamada. Retorna quantos temporizadores dispararam.
+ */
+template<typename T, unsigned SlotBits, unsigned Levels>
+template<typename Function>
+std::size_t TimingWheel<T, SlotBits, Levels>::advance(std::uint64_t ticks,
+                                                      Function function) {
+    std::size_t fired = expire(function);  // restos de um function que lançou
+    for (; ticks > 0; ticks--) {
+        if (size_ == 0) {
+            now_ += ticks;  // nada agendado: pula direto
+            break;
+        }
+        now_++;
+
+        //  desce primeiro os níveis mais altos, que podem encher os de baixo
+        unsigned top = 0;
+        while (top + 1 < Levels &&
+               ((now_ >> (SlotBits * (top + 1))) << (SlotBits * (top + 1))) ==
+               now_)
+            top++;
+        for (unsigned level = top; level > 0; level--)
+            cascade(level);
+
+        fired += expire(function);
+    }
+    return fired;
+}
+
+/**
+ *   Dispara os temporizadores da posição atual do nível 0 (TimingWheel).
+ * Eles saem da roda antes de function ser chamada; se ela lança, os que
+ * faltam voltam para a posição, na mesma ordem e antes de qualquer outro,
+ * e a exceção segue.
+ */
+template<typename T, unsigned SlotBits, unsigned Levels>
+template<typename Function>
+std::size_t TimingWheel<T, SlotBits, Levels>::expire(Function& function) {
+    RingHook& slot = slots_[0][now_ & MASK];
+    if (slot.alone())
+        return 0;
+
+    RingHook due;
+    due.take_ring(&slot);
+    std::size_t fired = 0;
+    try {
+        while (!due.alone()) {
+            RingHook* hook = due.next();
+            hook->unlink();
+            size_--;
+            fired++;
+            function(timer_of(hook));
+        }
+    } catch (...) {
+        RingHook* first = slot.next();
+        while (!due.alone()) {
+            RingHook* hook = due.next();
+            hook->unlink();
+            hook->link_before(first);
+        }
+        throw;
+    }
+    return fired;
+}
+
+/**
+ *   Retorna o tick atual (TimingWheel).
+ */
+template<typename T, unsigned SlotBits, unsigned Levels>
+std::uint64_t TimingWheel<T, SlotBits, Levels>::now() const {
+    return now_;
+}
+
+/**
+ *   Verifica se não há temporizadores agendados (TimingWheel).
+ */
+template<typename T, unsigned SlotBits, unsigned Levels>
+bool TimingWheel<T, SlotBits, Levels>::empty() const {
+    return size_ == 0;
+}
+
+/**
+ *   Retorna quantos temporizadores estão agendados (TimingWheel).
+ */
+template<typename T, unsigned SlotBits, unsigned Levels>
+std::size_t TimingWheel<T, SlotBits, Levels>::size() const {
+    return size_;
+}
+
+/**
+ *   Liga timer no fim da posição que corresponde ao seu expiry_, escolhendo
+ * o nível pela distância até o tick atual (TimingWheel).
+ */
+template<typename T, unsigned SlotBits, unsigned Levels>
+void TimingWheel<T, SlotBits, Levels>::place(TimerHook& timer) {
+    std::uint64_t expiry = timer.expiry_;
+    std::uint64_t delta = expiry - now_;
+    if (delta >= RANGE)
+        expiry = now_ + RANGE - 1;  // volta a ser posicionado ao descer
+
+    unsigned level = 0;
+    while (level + 1 < Levels &&
+           (expiry - now_) >= (std::uint64_t(1) << (SlotBits * (level + 1))))
+        level++;
+
+    std::uint64_t slot = (expiry >> (SlotBits * level)) & MASK;
+    timer.link_before(&slots_[level][slot]);
+}
+
+/**
+ *   Reposiciona os temporizadores da posição atual de level, que vencem
+ * antes da próxima posição e por isso descem para níveis mais baixos
+ * (TimingWheel).
+ */
+template<typename T, unsigned SlotBits, unsigned Levels>
+void TimingWheel<T, SlotBits, Levels>::cascade(unsigned level) {
+    RingHook pending;
+    pending.take_ring(&slots_[level][(now_ >> (SlotBits * level)) & MASK]);
+    while (!pending.alone()) {
+        RingHook* hook = pending.next();
+        hook->unlink();
+        place(static_cast<TimerHook&>(*hook));
+    }
+}
+
+}  // namespace structures
+
+#endif
@@ -0,0 +1,473 @@
+// Copyright 2017 Letícia do Nascimento
+
+#ifndef STRUCTURES_XOR_LINKED_LIST_H
+#define STRUCTURES_XOR_LINKED_LIST_H
+
+#include <cstdint>
+#include <stdexcept>  // C++ exception
+
+#include "./memory_usage.h"
+#include "./operation_stats.h"
+
+namespace structures {
+
+/**
+ * @brief      Lista Duplamente Encadeada com um só elo por nodo: o elo guarda
+ *             o XOR dos endereços do anterior e do próximo. Conhecendo um dos
+ *             vizinhos, obtém-se o outro, então a lista percorre nos dois
+ *             sentidos a partir das pontas e insere e retira nelas em O(1),
+ *             com a metade do custo de elos da DoublyLinkedList. Em troca,
+ *             não há como ir de um nodo isolado aos vizinhos: os acessos por
+ *             posição sempre partem de uma ponta.
+ *
+ * @tparam     T      Parâmetro genérico de Template
+ * @tparam     Stats  Política de estatísticas (NoStats ou OperationStats)
+ */
+template<typename T, typename Stats = NoStats>
+class XorLinkedList : private Stats {
+ public:
+    XorLinkedList();
+    ~XorLinkedList();
+
+    XorLinkedList(const XorLinkedList&) = delete;
+    XorLinkedList& operator=(const XorLinkedList&) = delete;
+
+    void clear();
+
+    void push_back(const T& data);  // insere no fim
+    void push_front(const T& data);  // insere no início
+    void insert(const T& data, std::size_t index);  // insere na posição
+
+    T pop(std::size_t index);  // retira da posição
+    T pop_back();  // retira do fim
+    T pop_front();  // retira do início
+    void remove(const T& data);  // retira específico
+
+    bool empty() const;  // lista vazia
+    bool contains(const T& data) const;  // contém
+
+    T& at(std::size_t index);  // acesso a um elemento (checando limites)
+    const T& at(std::size_t index) const;
+
+    std::size_t find(const T& data) const;  // posição de um dado
+    std::size_t size() const;  // tamanho
+
+    template<typename Function>
+    void for_each(Function function) const;  // do início ao fim
+
+    template<typename Function>
+    void for_each_reverse(Function function) const;  // do fim ao início
+
+    StatsSnapshot stats() const;  // contadores de estatísticas
+    void reset_stats();  // zera os contadores
+    std::size_t bytes_allocated() const;  // bytes no heap
+    std::size_t capacity() const;  // dados que cabem sem alocar
+    MemoryUsage memory_usage() const;  // detalhamento da memória
+    // repassa alocações a um observador (só com ObservedStats)
+    void observe(AllocationObserver* observer, const char* site);
+
+ private:
+    class Node {
+     public:
+        Node(const T& data, std::uintptr_t link) :
+            data_{data},
+            link_{link}
+        {}
+
+        T& data() { return data_; }
+        const T& data() const { return data_; }
+
+        // vizinho do lado oposto a from
+        Node* other(const Node* from) const {
+            return reinterpret_cast<Node*>(link_ ^ address(from));
+        }
+
+        // troca o vizinho old por node
+        void replace(const Node* old, const Node* node) {
+            link_ ^= address(old) ^ address(node);
+        }
+
+     private:
+        T data_;
+        std::uintptr_t link_;  // endereço do anterior XOR endereço do próximo
+    };
+
+    static std::uintptr_t address(const Node* node) {
+        return reinterpret_cast<std::uintptr_t>(node);
+    }
+
+    // nodo da posição index e seu anterior, partindo da ponta mais próxima
+    void locate(std::size_t index, Node*& prev, Node*& node) const;
+
+    void link(Node* prev, Node* next, const T& data);  // insere entre os dois
+    T unlink(Node* prev, Node* node);  // retira node, vizinho de prev
+    void destroy(Node* node);  // libera um nodo (nullptr é ignorado)
+
+    Node* head_;
+    Node* tail_;
+    std::size_t size_;
+};
+
+/**
+ *   Construtor padrão da classe XorLinkedList.
+ */
+template<typename T, typename Stats>
+XorLinkedList<T, Stats>::XorLinkedList() :
+    head_{nullptr},
+    tail_{nullptr},
+    size_{0}
+{}
+
+/**
+ *   Destrutor da classe XorLinkedList.
+ */
+template<typename T, typename Stats>
+XorLinkedList<T, Stats>::~XorLinkedList() {
+    clear();
+}
+
+/**
+ *   Faz uma limpeza da lista (XorLinkedList).
+ */
+template<typename T, typename Stats>
+void XorLinkedList<T, Stats>::clear() {
+    Node* prev = nullptr;
+    Node* node = head_;
+    while (node != nullptr) {
+        Node* next = node->other(prev);
+        destroy(prev);
+        prev = node;
+        node = next;
+    }
+    destroy(prev);
+    head_ = tail_ = nullptr;
+    size_ = 0;
+}
+
+/**
+ *   Encontra o nodo de index e seu vizinho do lado da ponta de onde partiu
+ * (XorLinkedList). Partindo do fim, prev é o vizinho seguinte.
+ */
+template<typename T, typename Stats>
+void XorLinkedList<T, Stats>::locate(std::size_t index, Node*& prev,
+                              Node*& node) const {
+    Stats::traversed(index < size_ / 2 ? index : size_ - 1 - index);
+    prev = nullptr;
+    if (index < size_ / 2) {
+        node = head_;
+        for (std::size_t i = 0; i < index; i++) {
+            Node* next = node->other(prev);
+            prev = node;
+            node = next;
+        }
+    } else {
+        node = tail_;
+        for (std::size_t i = size_ - 1; i > index; i--) {
+            Node* next = node->other(prev);
+            prev = node;
+            node = next;
+        }
+    }
+}
+
+/**
+ *   Cria um nodo com data entre os vizinhos prev e next, que podem ser
+ * nullptr nas pontas (XorLinkedList).
+ */
+template<typename T, typename Stats>
+void XorLinkedList<T, Stats>::link(Node* prev, Node* next, const T& data) {
+    Stats::operation();
+    Node* node = new Node(data, address(prev) ^ address(next));
+    Stats::allocated(sizeof(Node));
+    if (prev == nullptr)
+        head_ = node;
+    else
+        prev->replace(next, node);
+    if (next == nullptr)
+        tail_ = node;
+    else
+        next->replace(prev, node);
+    size_++;
+    Stats::resized(size_);
+}
+
+/**
+ *   Retira node, cujo vizinho prev é conhecido, e retorna seu dado
+ * (XorLinkedList). Funciona nos dois sentidos: prev pode ser o vizinho
+ * seguinte quando o percurso partiu do fim.
+ */
+template<typename T, typename Stats>
+T XorLinkedList<T, Stats>::unlink(Node* prev, Node* node) {
+    Stats::operation();
+    Node* next = node->other(prev);
+    if (prev != nullptr)
+        prev->replace(node, next);
+    if (next != nullptr)
+        next->replace(node, prev);
+
+    if (node == head_)
+        head_ = prev ? prev : next;
+    if (node == tail_)
+        tail_ = prev ? prev : next;
+    if (size_ == 1)
+        head_ = tail_ = nullptr;
+
+    T data = node->data();
+    destroy(node);
+    size_--;
+    return data;
+}
+
+/**
+ *   Libera um nodo, descontando-o da memória alocada (XorLinkedList).
+ */
+template<typename T, typename Stats>
+void XorLinkedList<T, Stats>::destroy(Node* node) {
+    if (node == nullptr)
+        return;
+    Stats::released(sizeof(Node));
+    delete node;
+}
+
+/**
+ *   Insere um elemento no fim da lista (XorLinkedList).
+ */
+template<typename T, typename Stats>
+void XorLinkedList<T, Stats>::push_back(const T& data) {
+    link(tail_, nullptr, data);
+}
+
+/**
+ *   Insere um elemento no início da lista (XorLinkedList).
+ */
+template<typename T, typename Stats>
+void XorLinkedList<T, Stats>::push_front(const T& data) {
+    link(nullptr, head_, data);
+}
+
+/**
+ *   Insere um elemento num determinado index da lista (XorLinkedList).
+ */
+template<typename T, typename Stats>
+void XorLinkedList<T, Stats>::insert(const T& data, std::size_t index) {
+    if (index > size_)
+        throw std::out_of_range("Índice inválido");
+    if (index == size_)
+        return push_back(data);
+
+    Node* neighbour;
+    Node* node;
+    locate(index, neighbour, node);
+    Node* other = node->other(neighbour);
+    if (index < size_ / 2)  // neighbour é o anterior
+        link(neighbour, node, data);
+    else  // neighbour é o seguinte; other é o anterior
+        link(other, node, data);
+}
+
+/**
+ *   Retira um elemento num index da lista (XorLinkedList).
+ */
+template<typename T, typename Stats>
+T XorLinkedList<T, Stats>::pop(std::size_t index) {
+    if (empty())
+        throw std::out_of_range("Lista vazia!");
+    if (index >= size_)
+        throw std::out_of_range("Índice inválido!");
+
+    Node* prev;
+    Node* node;
+    locate(index, prev, node);
+    return unlink(prev, node);
+}
+
+/**
+ *   Retira um elemento do fim da lista (XorLinkedList).
+ */
+template<typename T, typename Stats>
+T XorLinkedList<T, Stats>::pop_back() {
+    if (empty())
+        throw std::out_of_range("Lista está vazia!");
+    return unlink(nullptr, tail_);
+}
+
+/**
+ *   Retira um elemento do início da lista (XorLinkedList).
+ */
+template<typename T, typename Stats>
+T XorLinkedList<T, Stats>::pop_front() {
+    if (empty())
+        throw std::out_of_range("Lista vazia!");
+    return unlink(nullptr, head_);
+}
+
+/**
+ *   Remove um dado específico da lista (XorLinkedList).
+ */
+template<typename T, typename Stats>
+void XorLinkedList<T, Stats>::remove(const T& data) {
+    Node* prev = nullptr;
+    Node* node = head_;
+    while (node != nullptr && !(node->data() == data)) {
+        Node* next = node->other(prev);
+        prev = node;
+        node = next;
+    }
+    if (node != nullptr)
+        unlink(prev, node);
+}
+
+/**
+ *   Verifica se a lista está vazia (XorLinkedList).
+ */
+template<typename T, typename Stats>
+bool XorLinkedList<T, Stats>::empty() const {
+    return size_ == 0;
+}
+
+/**
+ *   Verifica se a lista contém determinado dado (XorLinkedList).
+ */
+template<typename T, typename Stats>
+bool XorLinkedList<T, Stats>::contains(const T& data) const {
+    return find(data) != size_;
+}
+
+/**
+ *   Retorna o dado num determinado index (XorLinkedList).
+ */
+template<typename T, typename Stats>
+T& XorLinkedList<T, Stats>::at(std::size_t index) {
+    if (index >= size_)
+        throw std::out_of_range("Índice inválido!");
+    Node* prev;
+    Node* node;
+    locate(index, prev, node);
+    return node->data();
+}
+
+/**
+ *   Retorna o dado num determinado index (XorLinkedList) - versão const.
+ */
+template<typename T, typename Stats>
+const T& XorLinkedList<T, Stats>::at(std::size_t index) const {
+    if (index >= size_)
+        throw std::out_of_range("Índice inválido!");
+    Node* prev;
+    Node* node;
+    locate(index, prev, node);
+    return node->data();
+}
+
+/**
+ *   Retorna a posição de um dado na lista, ou size() se não encontrado
+ * (XorLinkedList).
+ */
+template<typename T, typename Stats>
+std::size_t XorLinkedList<T, Stats>::find(const T& data) const {
+    const Node* prev = nullptr;
+    const Node* node = head_;
+    std::size_t index = 0;
+    while (node != nullptr && !(node->data() == data)) {
+        const Node* next = node->other(prev);
+        prev = node;
+        node = next;
+        index++;
+    }
+    return index;
+}
+
+/**
+ *   Retorna o tamanho da lista (XorLinkedList).
+ */
+template<typename T, typename Stats>
+std::size_t XorLinkedList<T, Stats>::size() const {
+    return size_;
+}
+
+/**
+ *   Aplica function a cada dado, do início ao fim (XorLinkedList).
+ */
+template<typename T, typename Stats>
+template<typename Function>
+void XorLinkedList<T, Stats>::for_each(Function function) const {
+    const Node* prev = nullptr;
+    const Node* node = head_;
+    while (node != nullptr) {
+        function(node->data());
+        const Node* next = node->other(prev);
+        prev = node;
+        node = next;
+    }
+}
+
+/**
+ *   Aplica function a cada dado, do fim ao início (XorLinkedList).
+ */
+template<typename T, typename Stats>
+template<typename Function>
+void XorLinkedList<T, Stats>::for_each_reverse(Function function) const {
+    const Node* next = nullptr;
+    const Node* node = tail_;
+    while (node != nullptr) {
+        function(node->data());
+        const Node* prev = node->other(next);
+        next = node;
+        node = prev;
+    }
+}
+
+/**
+ *   Retorna os contadores da política de estatísticas (XorLinkedList).
+ */
+template<typename T, typename Stats>
+StatsSnapshot XorLinkedList<T, Stats>::stats() const {
+    return Stats::snapshot();
+}
+
+/**
+ *   Zera os contadores da política de estatísticas (XorLinkedList).
+ */
+template<typename T, typename Stats>
+void XorLinkedList<T, Stats>::reset_stats() {
+    Stats::reset();
+}
+
+/**
+ *   Retorna os bytes que os nodos ocupam no heap (XorLinkedList).
+ */
+template<typename T, typename Stats>
+std::size_t XorLinkedList<T, Stats>::bytes_allocated() const {
+    return size_ * sizeof(Node);
+}
+
+/**
+ *   Retorna quantos dados cabem sem alocar: um nodo por dado (XorLinkedList).
+ */
+template<typename T, typename Stats>
+std::size_t XorLinkedList<T, Stats>::capacity() const {
+    return size_;
+}
+
+/**
+ *   Retorna o detalhamento da memória ocupada (XorLinkedList); o elo é
+ * um só uintptr_t por nodo.
+ */
+template<typename T, typename Stats>
+MemoryUsage XorLinkedList<T, Stats>::memory_usage() const {
+    return detail::node_usage<T, Node>(size_, size_);
+}
+
+/**
+ *   Repassa as alocações ao observador com o rótulo site (XorLinkedList);
+ * exige a política ObservedStats.
+ */
+template<typename T, typename Stats>
+void XorLinkedList<T, Stats>::observe(AllocationObserver* observer,
+                                      const char* site) {
+    Stats::observe(observer, site);
+}
+
+}  // namespace structures
+
+#endif